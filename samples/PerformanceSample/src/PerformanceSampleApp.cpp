@@ -0,0 +1,293 @@
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Log.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+
+#include "bluecadet/core/BaseApp.h"
+#include "bluecadet/touch/TouchManager.h"
+#include "bluecadet/views/AnimatedView.h"
+#include "bluecadet/views/AnimationEasing.h"
+#include "bluecadet/views/BaseView.h"
+#include "bluecadet/views/TouchView.h"
+#include "bluecadet/views/TextView.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+using namespace bluecadet::core;
+using namespace bluecadet::views;
+using namespace bluecadet::touch;
+
+//! Headless micro-benchmarks for the touch and view pipelines.
+//! Press 'b' to re-run all benchmarks. Results are logged and displayed on screen.
+class PerformanceSampleApp : public BaseApp {
+public:
+	static void prepareSettings(ci::app::App::Settings* settings);
+
+	void setup() override;
+	void lateSetup() override;
+	void keyDown(ci::app::KeyEvent event) override;
+
+protected:
+	void runBenchmarks();
+	void addResult(const std::string & label, const double nsPerItem, const double msPerFrame);
+
+	//! Feeds numContacts concurrent touches into the TouchManager over a grid of touch views for numFrames frames
+	void benchmarkTouches(const int numContacts, const int numFrames);
+
+	//! Compares per-tween ci::EaseFn calls with batched evaluation per EaseId for numTweens tweens with mixed easings
+	void benchmarkEasing(const int numTweens, const int numFrames);
+
+	//! Staggers numViews AnimatedViews on with async completion callbacks and steps them until all callbacks were called
+	void benchmarkAnimateOn(const int numViews);
+
+	TextViewRef		mResultsView;
+	std::string		mResults;
+};
+
+void PerformanceSampleApp::prepareSettings(ci::app::App::Settings* settings) {
+	settings->setHighDensityDisplayEnabled(true);
+
+	SettingsManager::get()->setup(settings, ci::app::getAssetPath("../assets/settings.json"), true, [](SettingsManager * manager) {
+		manager->mFullscreen = false;
+		manager->mWindowSize = ivec2(1280, 720);
+		manager->mDisplaySize = ivec2(1280, 720);
+		manager->mConsole = true;
+		manager->mShowStats = true;
+		manager->mMinimizeParams = true;
+
+		// benchmarks feed the touch manager directly
+		manager->mMouseEnabled = false;
+		manager->mTuioTouchEnabled = false;
+		manager->mNativeTouchEnabled = false;
+	});
+}
+
+void PerformanceSampleApp::setup() {
+	BaseApp::setup();
+
+	getRootView()->setBackgroundColor(Color::gray(0.2f));
+
+	mResultsView = make_shared<TextView>();
+	mResultsView->setPadding(20.0f, 20.0f);
+	mResultsView->setWidth((float)getWindowWidth());
+	mResultsView->setFontSize(18.0f);
+	mResultsView->setTextColor(Color::white());
+	mResultsView->setText("Running benchmarks...");
+	getRootView()->addChild(mResultsView);
+}
+
+void PerformanceSampleApp::lateSetup() {
+	runBenchmarks();
+}
+
+void PerformanceSampleApp::keyDown(ci::app::KeyEvent event) {
+	BaseApp::keyDown(event);
+
+	switch (event.getChar()) {
+		case 'b': runBenchmarks(); break;
+		default: break;
+	}
+}
+
+//==================================================
+// Benchmarks
+//
+
+void PerformanceSampleApp::runBenchmarks() {
+	mResults = "";
+
+	for (const int numContacts : {10, 100, 500}) {
+		benchmarkTouches(numContacts, 300);
+	}
+
+	for (const int numTweens : {1000, 10000, 100000}) {
+		benchmarkEasing(numTweens, 100);
+	}
+
+	benchmarkAnimateOn(500);
+
+	mResultsView->setText(mResults);
+}
+
+void PerformanceSampleApp::addResult(const std::string & label, const double nsPerItem, const double msPerFrame) {
+	const string line = label + ": " + to_string((int)nsPerItem) + " ns/item, " + to_string(msPerFrame) + " ms/frame";
+	CI_LOG_I(line);
+	mResults += line + "\n";
+}
+
+void PerformanceSampleApp::benchmarkTouches(const int numContacts, const int numFrames) {
+	const vec2 appSize = vec2(1920, 1080);
+	const ivec2 gridSize = ivec2(32, 18);
+	const vec2 cellSize = appSize / vec2(gridSize);
+
+	// separate root view so the benchmark doesn't interfere with the app's views
+	auto rootView = make_shared<BaseView>();
+	rootView->setSize(appSize);
+
+	for (int row = 0; row < gridSize.y; ++row) {
+		for (int col = 0; col < gridSize.x; ++col) {
+			auto view = make_shared<TouchView>();
+			view->setSize(cellSize);
+			view->setPosition(vec2(col, row) * cellSize);
+			view->setMultiTouchEnabled(true);
+			rootView->addChild(view);
+		}
+	}
+
+	auto manager = TouchManager::get();
+	Rand rand(numContacts);
+	vector<vec2> positions(numContacts);
+
+	for (auto & position : positions) {
+		position = vec2(rand.nextFloat(appSize.x), rand.nextFloat(appSize.y));
+	}
+
+	// touch ids far outside of the driver ranges
+	const int firstId = 1000000;
+
+	Timer timer(true);
+
+	for (int frame = 0; frame <= numFrames + 1; ++frame) {
+		const TouchPhase phase = frame == 0 ? TouchPhase::Began : (frame > numFrames ? TouchPhase::Ended : TouchPhase::Moved);
+
+		for (int i = 0; i < numContacts; ++i) {
+			if (phase == TouchPhase::Moved) {
+				positions[i] = glm::clamp(positions[i] + rand.nextVec2() * 4.0f, vec2(0), appSize - vec2(1));
+			}
+			Touch touch(firstId + i, ivec2(positions[i]), TouchType::Simulator, phase);
+			manager->addTouch(touch);
+		}
+
+		manager->update(rootView, appSize);
+	}
+
+	timer.stop();
+
+	const double numTouches = (double)numContacts * (double)(numFrames + 2);
+	const double seconds = timer.getSeconds();
+
+	addResult("Touches (" + to_string(numContacts) + " contacts)", seconds * 1e9 / numTouches, seconds * 1e3 / (double)(numFrames + 2));
+
+	if (manager->getNumTouches() > 0) {
+		CI_LOG_W("Touches still active after benchmark: " << manager->getNumTouches());
+	}
+}
+
+void PerformanceSampleApp::benchmarkEasing(const int numTweens, const int numFrames) {
+	// typical mix of easings during transitions
+	const vector<pair<EaseId, EaseFn>> easings = {
+		{EaseId::InOutQuad, EaseInOutQuad()},
+		{EaseId::OutCubic, EaseOutCubic()},
+		{EaseId::OutExpo, EaseOutExpo()},
+		{EaseId::InOutSine, EaseInOutSine()},
+		{EaseId::OutBack, EaseOutBack()},
+		{EaseId::OutElastic, EaseOutElastic(1.0f, 0.3f)},
+	};
+
+	Rand rand(numTweens);
+	vector<float> times(numTweens);
+	vector<float> results(numTweens);
+	vector<EaseFn> easeFns(numTweens);
+	vector<vector<float>> batchTimes(easings.size());
+	vector<vector<float>> batchResults(easings.size());
+
+	for (int i = 0; i < numTweens; ++i) {
+		const size_t easing = (size_t)i % easings.size();
+		times[i] = rand.nextFloat();
+		easeFns[i] = easings[easing].second;
+		batchTimes[easing].push_back(times[i]);
+	}
+
+	for (size_t i = 0; i < easings.size(); ++i) {
+		batchResults[i].resize(batchTimes[i].size());
+	}
+
+	const double numEvaluations = (double)numTweens * (double)numFrames;
+
+	// per tween
+	Timer timer(true);
+
+	for (int frame = 0; frame < numFrames; ++frame) {
+		for (int i = 0; i < numTweens; ++i) {
+			results[i] = easeFns[i](times[i]);
+		}
+	}
+
+	timer.stop();
+	const double fnSeconds = timer.getSeconds();
+	addResult("EaseFn (" + to_string(numTweens) + " tweens)", fnSeconds * 1e9 / numEvaluations, fnSeconds * 1e3 / (double)numFrames);
+
+	// batched per ease id
+	timer.start();
+
+	for (int frame = 0; frame < numFrames; ++frame) {
+		for (size_t i = 0; i < easings.size(); ++i) {
+			evaluateEaseBatch(easings[i].first, batchTimes[i].data(), batchResults[i].data(), batchTimes[i].size());
+		}
+	}
+
+	timer.stop();
+	const double batchSeconds = timer.getSeconds();
+	addResult("Batch " + string(getEaseBatchInstructionSet()) + " (" + to_string(numTweens) + " tweens)", batchSeconds * 1e9 / numEvaluations, batchSeconds * 1e3 / (double)numFrames);
+}
+
+void PerformanceSampleApp::benchmarkAnimateOn(const int numViews) {
+	const double frameDuration = 1.0 / 60.0;
+	const float stagger = 0.005f;
+	AnimatedView::Options options = AnimatedView::Options().duration(0.3f);
+
+	// separate root view so the benchmark doesn't interfere with the app's views
+	auto rootView = make_shared<BaseView>();
+	vector<AnimatedViewRef> views;
+
+	for (int i = 0; i < numViews; ++i) {
+		auto view = make_shared<AnimatedView>(false);
+		view->setSize(vec2(100, 100));
+		rootView->addChild(view);
+		views.push_back(view);
+	}
+
+	// callbacks of views that are canceled when they're destroyed can still be dispatched after this function returns
+	auto numCompleted = make_shared<int>(0);
+
+	// animateOn calls
+	Timer timer(true);
+
+	for (int i = 0; i < numViews; ++i) {
+		options.delay((float)i * stagger);
+		views[i]->animateOn(options, [numCompleted](bool completed) {
+			if (completed) (*numCompleted)++;
+		});
+	}
+
+	timer.stop();
+	const double startSeconds = timer.getSeconds();
+	addResult("animateOn (" + to_string(numViews) + " views)", startSeconds * 1e9 / (double)numViews, startSeconds * 1e3);
+
+	// frames until the last view has animated on
+	const double startTime = timeline().getCurrentTime();
+	const int numFrames = (int)ceil((options.getDuration() + stagger * (float)numViews) / frameDuration) + 2;
+
+	timer.start();
+
+	for (int frame = 1; frame <= numFrames; ++frame) {
+		AnimatedView::dispatchQueuedCallbacks();
+		rootView->updateScene(BaseView::FrameInfo(startTime + (double)frame * frameDuration, frameDuration));
+	}
+
+	AnimatedView::dispatchQueuedCallbacks();
+
+	timer.stop();
+	const double frameSeconds = timer.getSeconds();
+	addResult("Staggered animateOn (" + to_string(numViews) + " views)", frameSeconds * 1e9 / ((double)numViews * (double)numFrames), frameSeconds * 1e3 / (double)numFrames);
+
+	if (*numCompleted != numViews) {
+		CI_LOG_W("Only " << *numCompleted << " of " << numViews << " animateOn callbacks completed");
+	}
+}
+
+CINDER_APP(PerformanceSampleApp, RendererGl(RendererGl::Options().msaa(4)), PerformanceSampleApp::prepareSettings)
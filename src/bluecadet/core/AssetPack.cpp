@@ -0,0 +1,395 @@
+#include "AssetPack.h"
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+//==================================================
+// Format helpers
+//
+
+namespace assetpack {
+
+std::string normalizePath(const ci::fs::path & path) {
+	string result = path.generic_string();
+	replace(result.begin(), result.end(), '\\', '/');
+
+	while (result.compare(0, 2, "./") == 0) {
+		result.erase(0, 2);
+	}
+
+	// ascii only, which is what the packer does as well
+	transform(result.begin(), result.end(), result.begin(), [](char c) {
+		return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+	});
+
+	return result;
+}
+
+uint64_t hashPath(const std::string & normalizedPath) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	for (const char c : normalizedPath) {
+		hash ^= (uint8_t)c;
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+uint32_t crc32(const uint8_t * data, const size_t size) {
+	static const auto table = [] {
+		array<uint32_t, 256> values;
+		for (uint32_t i = 0; i < 256; ++i) {
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; ++bit) {
+				value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+			}
+			values[i] = value;
+		}
+		return values;
+	}();
+
+	uint32_t crc = 0xFFFFFFFFu;
+
+	for (size_t i = 0; i < size; ++i) {
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+
+	return crc ^ 0xFFFFFFFFu;
+}
+
+namespace {
+	//! Reads an LZ4 length that continues in bytes of 255. Returns false if src ends first.
+	inline bool readLz4Length(const uint8_t *& src, const uint8_t * srcEnd, size_t & length) {
+		uint8_t value = 255;
+
+		while (value == 255) {
+			if (src >= srcEnd) {
+				return false;
+			}
+			value = *src++;
+			length += value;
+		}
+
+		return true;
+	}
+}
+
+bool decompressLz4(const uint8_t * src, const size_t srcSize, uint8_t * dst, const size_t dstSize) {
+	const uint8_t * srcEnd = src + srcSize;
+	uint8_t * dstBegin = dst;
+	uint8_t * dstEnd = dst + dstSize;
+
+	while (src < srcEnd) {
+		const uint8_t token = *src++;
+
+		size_t numLiterals = token >> 4;
+
+		if (numLiterals == 15 && !readLz4Length(src, srcEnd, numLiterals)) {
+			return false;
+		}
+
+		if ((size_t)(srcEnd - src) < numLiterals || (size_t)(dstEnd - dst) < numLiterals) {
+			return false;
+		}
+
+		memcpy(dst, src, numLiterals);
+		src += numLiterals;
+		dst += numLiterals;
+
+		if (src == srcEnd) {
+			break; // the last sequence only has literals
+		}
+
+		if (srcEnd - src < 2) {
+			return false;
+		}
+
+		const size_t offset = (size_t)src[0] | ((size_t)src[1] << 8);
+		src += 2;
+
+		if (offset == 0 || offset > (size_t)(dst - dstBegin)) {
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+
+		if (matchLength == 15 && !readLz4Length(src, srcEnd, matchLength)) {
+			return false;
+		}
+
+		matchLength += 4;
+
+		if ((size_t)(dstEnd - dst) < matchLength) {
+			return false;
+		}
+
+		// copy byte by byte since matches can overlap the bytes they produce
+		const uint8_t * match = dst - offset;
+
+		for (size_t i = 0; i < matchLength; ++i) {
+			dst[i] = match[i];
+		}
+
+		dst += matchLength;
+	}
+
+	return dst == dstEnd;
+}
+
+}
+
+namespace {
+	mutex sMountMutex;
+	vector<AssetPackRef> sMountedPacks;
+}
+
+//==================================================
+// Lifecycle
+//
+
+AssetPackRef AssetPack::open(const ci::fs::path & path) {
+	auto file = MappedFile::open(path);
+
+	if (!file) {
+		return nullptr;
+	}
+
+	AssetPackRef pack(new AssetPack(file));
+
+	if (!pack->parse()) {
+		return nullptr;
+	}
+
+	return pack;
+}
+
+AssetPack::AssetPack(MappedFileRef file) :
+	mFile(file),
+	mEntries(nullptr),
+	mBuckets(nullptr),
+	mNumEntries(0),
+	mNumBuckets(0)
+{
+}
+
+AssetPack::~AssetPack() {
+}
+
+bool AssetPack::parse() {
+	const uint8_t * data = mFile->getData();
+	const size_t size = mFile->getSize();
+	const string sourceName = mFile->getPath().string();
+
+	assetpack::FileHeader header;
+
+	if (size < sizeof(header)) {
+		CI_LOG_E("'" << sourceName << "' is not an asset pack");
+		return false;
+	}
+
+	memcpy(&header, data, sizeof(header));
+
+	if (header.magic != assetpack::FileHeader::kMagic) {
+		CI_LOG_E("'" << sourceName << "' is not an asset pack");
+		return false;
+	}
+
+	if (header.version != assetpack::FileHeader::kVersion) {
+		CI_LOG_E("Asset pack '" << sourceName << "' has an unsupported version (" << header.version << ")");
+		return false;
+	}
+
+	const bool hasValidIndex = header.numBuckets > header.numEntries
+		&& (header.numBuckets & (header.numBuckets - 1)) == 0
+		&& header.entriesOffset % 8 == 0 && header.bucketsOffset % 4 == 0
+		&& header.entriesOffset <= size && header.bucketsOffset <= size
+		&& header.entriesOffset + (uint64_t)header.numEntries * sizeof(assetpack::Entry) <= size
+		&& header.bucketsOffset + (uint64_t)header.numBuckets * sizeof(uint32_t) <= size;
+
+	if (!hasValidIndex) {
+		CI_LOG_E("Asset pack '" << sourceName << "' has an invalid index");
+		return false;
+	}
+
+	const auto * entries = reinterpret_cast<const assetpack::Entry *>(data + header.entriesOffset);
+
+	for (size_t i = 0; i < header.numEntries; ++i) {
+		const assetpack::Entry & entry = entries[i];
+		const auto compression = (assetpack::Compression)entry.compression;
+
+		const bool isValid = entry.pathOffset < size && memchr(data + entry.pathOffset, 0, size - entry.pathOffset) != nullptr
+			&& entry.offset <= size && entry.storedSize <= size - entry.offset
+			&& (compression == assetpack::Compression::Lz4 || (compression == assetpack::Compression::None && entry.storedSize == entry.size));
+
+		if (!isValid) {
+			CI_LOG_E("Entry " << i << " of asset pack '" << sourceName << "' is invalid");
+			return false;
+		}
+	}
+
+	mEntries = entries;
+	mBuckets = reinterpret_cast<const uint32_t *>(data + header.bucketsOffset);
+	mNumEntries = header.numEntries;
+	mNumBuckets = header.numBuckets;
+	return true;
+}
+
+//==================================================
+// Entries
+//
+
+const assetpack::Entry * AssetPack::findEntry(const ci::fs::path & path) const {
+	if (mNumBuckets == 0) {
+		return nullptr;
+	}
+
+	const string key = assetpack::normalizePath(path);
+	const uint64_t hash = assetpack::hashPath(key);
+
+	const size_t mask = mNumBuckets - 1;
+
+	for (size_t i = 0; i < mNumBuckets; ++i) {
+		const uint32_t index = mBuckets[(hash + i) & mask];
+
+		if (index == assetpack::kEmptyBucket) {
+			return nullptr;
+		}
+
+		if (index < mNumEntries && mEntries[index].pathHash == hash) {
+			const char * entryPath = reinterpret_cast<const char *>(mFile->getData() + mEntries[index].pathOffset);
+
+			if (key == entryPath) {
+				return &mEntries[index];
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+std::string AssetPack::getPath(const size_t index) const {
+	if (index >= mNumEntries) {
+		return "";
+	}
+
+	return reinterpret_cast<const char *>(mFile->getData() + mEntries[index].pathOffset);
+}
+
+ci::DataSourceRef AssetPack::load(const ci::fs::path & path) const {
+	const assetpack::Entry * entry = findEntry(path);
+
+	if (!entry) {
+		return nullptr;
+	}
+
+	const uint8_t * data = mFile->getData() + entry->offset;
+	BufferRef buffer;
+
+	if ((assetpack::Compression)entry->compression == assetpack::Compression::None) {
+		// wrap the mapped bytes without copying them; the deleter keeps the file mapped while the buffer is in use
+		MappedFileRef file = mFile;
+		buffer = BufferRef(new Buffer(const_cast<uint8_t *>(data), (size_t)entry->size), [file](Buffer * buffer) {
+			delete buffer;
+		});
+
+	} else {
+		buffer = make_shared<Buffer>((size_t)entry->size);
+
+		if (!assetpack::decompressLz4(data, (size_t)entry->storedSize, static_cast<uint8_t *>(buffer->getData()), (size_t)entry->size)) {
+			CI_LOG_E("Could not decompress '" << path << "' from asset pack '" << mFile->getPath() << "'");
+			return nullptr;
+		}
+	}
+
+	// the path hint lets loaders like loadImage() detect the type by extension
+	return DataSourceBuffer::create(buffer, path);
+}
+
+bool AssetPack::verify() const {
+	size_t numCorrupted = 0;
+
+	for (size_t i = 0; i < mNumEntries; ++i) {
+		const assetpack::Entry & entry = mEntries[i];
+
+		if (assetpack::crc32(mFile->getData() + entry.offset, (size_t)entry.storedSize) != entry.crc32) {
+			CI_LOG_E("'" << getPath(i) << "' in asset pack '" << mFile->getPath() << "' is corrupted");
+			numCorrupted++;
+		}
+	}
+
+	return numCorrupted == 0;
+}
+
+//==================================================
+// Mounting
+//
+
+bool AssetPack::mount(const ci::fs::path & path) {
+	AssetPackRef pack = open(path);
+
+	if (!pack) {
+		return false;
+	}
+
+	mount(pack);
+	CI_LOG_I("Mounted asset pack '" << path << "' with " << pack->getNumEntries() << " assets");
+	return true;
+}
+
+void AssetPack::mount(AssetPackRef pack) {
+	lock_guard<mutex> lock(sMountMutex);
+	sMountedPacks.push_back(pack);
+}
+
+void AssetPack::unmountAll() {
+	lock_guard<mutex> lock(sMountMutex);
+	sMountedPacks.clear();
+}
+
+std::vector<AssetPackRef> AssetPack::getMountedPacks() {
+	lock_guard<mutex> lock(sMountMutex);
+	return sMountedPacks;
+}
+
+bool AssetPack::hasAsset(const ci::fs::path & path) {
+	if (path.is_absolute()) {
+		return false;
+	}
+
+	const auto packs = getMountedPacks();
+
+	return any_of(packs.begin(), packs.end(), [&](const AssetPackRef & pack) {
+		return pack->contains(path);
+	});
+}
+
+ci::DataSourceRef AssetPack::loadAsset(const ci::fs::path & path) {
+	if (path.is_absolute()) {
+		return loadFile(path);
+	}
+
+	const auto packs = getMountedPacks();
+
+	for (auto it = packs.rbegin(); it != packs.rend(); ++it) {
+		if (auto source = (*it)->load(path)) {
+			return source;
+		}
+	}
+
+	return ci::app::loadAsset(path);
+}
+
+}
+}
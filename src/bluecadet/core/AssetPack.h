@@ -0,0 +1,142 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace bluecadet {
+namespace core {
+
+//==================================================
+// Asset pack format
+//
+// File layout:
+//   FileHeader
+//   Entry * FileHeader::numEntries
+//   uint32_t buckets[FileHeader::numBuckets]
+//   Paths (UTF-8, null-terminated)
+//   Blobs, each at a FileHeader::alignment-aligned offset
+//
+// Paths are relative to the asset directory the pack was built from, use forward slashes and are lower case, so
+// lookups behave like the case-insensitive Windows file system. Buckets form an open-addressing hash table with
+// linear probing over Entry::pathHash (64-bit FNV-1a of the path); each bucket holds an entry index or kEmptyBucket.
+// Uncompressed blobs are read in place from the memory-mapped file. All values are little-endian.
+//
+// Packs are built with tools/pack_assets.py.
+//
+
+namespace assetpack {
+
+enum class Compression : uint8_t {
+	None,	//! Stored as is
+	Lz4,	//! LZ4 block format without frame header
+};
+
+static const uint32_t kEmptyBucket = 0xFFFFFFFF;
+
+#pragma pack(push, 1)
+
+struct FileHeader {
+	static const uint32_t kMagic = 0x50414342; // "BCAP"
+	static const uint32_t kVersion = 1;
+
+	uint32_t	magic			= kMagic;
+	uint32_t	version			= kVersion;
+	uint32_t	numEntries		= 0;
+	uint32_t	numBuckets		= 0;	//! Power of two
+	uint32_t	alignment		= 0;	//! Alignment of blob offsets
+	uint32_t	reserved		= 0;
+	uint64_t	entriesOffset	= 0;
+	uint64_t	bucketsOffset	= 0;
+};
+
+struct Entry {
+	uint64_t	pathHash		= 0;
+	uint64_t	offset			= 0;	//! File offset of the blob
+	uint64_t	storedSize		= 0;	//! Number of bytes in the pack
+	uint64_t	size			= 0;	//! Number of bytes after decompression
+	uint32_t	pathOffset		= 0;	//! File offset of the null-terminated path
+	uint32_t	crc32			= 0;	//! Checksum of the stored bytes
+	uint8_t		compression		= 0;	//! Compression
+	uint8_t		reserved[7]		= {};
+};
+
+#pragma pack(pop)
+
+//! Normalizes a relative asset path to the form used as key in packs, e.g. "Images\\Logo.PNG" becomes "images/logo.png".
+std::string	normalizePath(const ci::fs::path & path);
+
+//! 64-bit FNV-1a hash of a normalized path.
+uint64_t	hashPath(const std::string & normalizedPath);
+
+uint32_t	crc32(const uint8_t * data, const size_t size);
+
+//! Decompresses an LZ4 block into exactly dstSize bytes. Returns false if the block is malformed.
+bool		decompressLz4(const uint8_t * src, const size_t srcSize, uint8_t * dst, const size_t dstSize);
+
+}
+
+typedef std::shared_ptr<class AssetPack> AssetPackRef;
+
+//! Read-only archive of assets in a single memory-mapped file. Opening a pack only maps it and validates its index,
+//! so startup doesn't scan directories or open thousands of files. Assets are returned as DataSources that Cinder
+//! loaders (loadImage(), JsonTree, XmlTree, ...) read from; uncompressed entries point directly into the mapping.
+//!
+//! Packs can be mounted globally (e.g. via settings.assets.pack), after which loadAsset() and the ImageLoader resolve
+//! relative asset paths from mounted packs first and fall back to the asset directories.
+class AssetPack {
+
+public:
+
+	//! Maps the pack at path and validates its header and index. Returns nullptr if the file isn't a valid pack.
+	static AssetPackRef	open(const ci::fs::path & path);
+
+	~AssetPack();
+
+	//! Returns nullptr if the pack doesn't contain path.
+	const assetpack::Entry *	findEntry(const ci::fs::path & path) const;
+	bool						contains(const ci::fs::path & path) const { return findEntry(path) != nullptr; }
+
+	//! Returns the asset at path as a DataSource or nullptr if the pack doesn't contain it or it can't be decompressed.
+	//! Uncompressed data isn't copied and keeps the pack mapped while it's referenced.
+	ci::DataSourceRef			load(const ci::fs::path & path) const;
+
+	//! Compares checksums of all entries. Reads the entire pack, so this isn't done when opening it.
+	bool						verify() const;
+
+	size_t						getNumEntries() const	{ return mNumEntries; }
+	std::string					getPath(const size_t index) const;
+	const ci::fs::path &		getFilePath() const		{ return mFile->getPath(); }
+
+	//! Mounts the pack at path. Packs that are mounted later take precedence. Returns false if the pack can't be opened.
+	static bool					mount(const ci::fs::path & path);
+	static void					mount(AssetPackRef pack);
+	static void					unmountAll();
+	static std::vector<AssetPackRef> getMountedPacks();
+
+	//! True if any mounted pack contains the relative path.
+	static bool					hasAsset(const ci::fs::path & path);
+
+	//! Loads relative paths from mounted packs and falls back to ci::app::loadAsset(). Absolute paths are loaded from disk.
+	//! Throws the same exceptions as ci::app::loadAsset() and ci::loadFile() if the asset can't be found. Thread-safe.
+	static ci::DataSourceRef	loadAsset(const ci::fs::path & path);
+
+protected:
+
+	AssetPack(MappedFileRef file);
+
+	//! Validates the header and all entries. Returns false if anything points outside of the file.
+	bool						parse();
+
+	MappedFileRef				mFile;
+	const assetpack::Entry *	mEntries;	//! Points into mFile
+	const uint32_t *			mBuckets;	//! Points into mFile
+	size_t						mNumEntries;
+	size_t						mNumBuckets;
+};
+
+}
+}
@@ -35,10 +35,14 @@ namespace bluecadet {
 		BaseApp::BaseApp()
 			: ci::app::App(),
 			mLastUpdateTime(0),
+			mLastFrameTime(0),
+			mFixedTimestep(0),
+			mNumFixedSteps(0),
 			mDebugUiPadding(16.0f),
 			mRootView(new BaseView()),
 			mMiniMap(new MiniMapView(0.025f)),
 			mStats(new GraphView(ivec2(128, 48))),
+			mAnimationScheduler(AnimationScheduler::get()),
 			mIsLateSetupCompleted(false) {
 		}
 
@@ -52,6 +56,13 @@ namespace bluecadet {
 
 			handleSettingsLoaded();
 
+			// drive all view time from fixed steps starting at 0 so that runs are reproducible
+			if (SettingsManager::get()->mFixedTimestep > 0) {
+				mFixedTimestep = (double)SettingsManager::get()->mFixedTimestep;
+				mNumFixedSteps = 0;
+				BaseView::sFixedTime = 0;
+			}
+
 #ifndef NO_TOUCH
 			mSimulatedTouchDriver.setup(Rectf(vec2(0), getWindowSize()), 60);
 #endif
@@ -65,9 +76,49 @@ namespace bluecadet {
 			::SetFocus(nativeWindow);
 #endif
 
+			if (!SettingsManager::get()->mAssetPack.empty()) {
+				const fs::path packPath = SettingsManager::get()->mAssetPack;
+				const fs::path resolvedPackPath = packPath.is_absolute() ? packPath : getAssetPath(packPath);
+
+				if (resolvedPackPath.empty() || !AssetPack::mount(resolvedPackPath)) {
+					CI_LOG_E("Could not mount asset pack '" << packPath << "'");
+				}
+			}
+
+			if (!SettingsManager::get()->mImageDiskCachePath.empty()) {
+				const fs::path cachePath = SettingsManager::get()->mImageDiskCachePath;
+				DiskImageCache::get()->setup(cachePath.is_absolute() ? cachePath : getAppPath() / cachePath, (size_t)(SettingsManager::get()->mImageDiskCacheBudgetMb * 1024.0 * 1024.0));
+				DiskImageCache::get()->setVerifyData(SettingsManager::get()->mImageDiskCacheVerify);
+			}
+
+			ImageLoader::get()->setup(SettingsManager::get()->mImageLoaderThreads);
+			ImageLoader::get()->setUploadBudget((size_t)(SettingsManager::get()->mImageUploadBudgetMb * 1024.0f * 1024.0f));
+			ImageLoader::get()->setPreferCompressedTextures(SettingsManager::get()->mPreferCompressedTextures);
+			TextureCache::get()->setBudget((size_t)(SettingsManager::get()->mTextureCacheBudgetMb * 1024.0f * 1024.0f));
+			TextureAtlas::get()->setEnabled(SettingsManager::get()->mTextureAtlasEnabled);
+			TextureAtlas::get()->setMaxImageSize(SettingsManager::get()->mTextureAtlasMaxImageSize);
+			UploadScheduler::get()->setEnabled(SettingsManager::get()->mUploadSchedulingEnabled);
+			UploadScheduler::get()->setByteBudget((size_t)(SettingsManager::get()->mUploadBudgetMb * 1024.0f * 1024.0f));
+			UploadScheduler::get()->setTimeBudget((double)SettingsManager::get()->mUploadBudgetMs / 1000.0);
+			BaseView::sAnimationThrottling.enabled = SettingsManager::get()->mAnimationThrottlingEnabled;
+
 			// Debugging
 			mStats->setBackgroundColor(ColorA(0, 0, 0, 0.1f));
 			mStats->addGraph("FPS", 0, getFrameRate(), ColorA(0, 1.0f, 0, 1.0f));
+			mStats->addGraph("Image queue", 0, 64.0f, ColorA(1.0f, 0, 1.0f, 1.0f));
+			mStats->addGraph("Image decode (ms)", 0, 100.0f, ColorA(0.5f, 0, 1.0f, 1.0f));
+			mStats->addGraph("Textures (MB)", 0, std::max(256.0f, SettingsManager::get()->mTextureCacheBudgetMb), ColorA(1.0f, 1.0f, 0, 1.0f));
+			mStats->addGraph("Uploads (MB)", 0, std::max(16.0f, SettingsManager::get()->mUploadBudgetMb), ColorA(0, 1.0f, 1.0f, 1.0f));
+
+#ifndef NO_TOUCH
+			if (SettingsManager::get()->mShowTouchLatency) {
+				mTouchLatencyPlugin = make_shared<plugins::TouchLatencyPlugin>();
+				TouchManager::get()->addPlugin(mTouchLatencyPlugin);
+				mStats->addGraph("Touch p50 (ms)", 0, 100.0f, ColorA(0, 0.75f, 1.0f, 1.0f));
+				mStats->addGraph("Touch p95 (ms)", 0, 100.0f, ColorA(1.0f, 0.75f, 0, 1.0f));
+				mStats->addGraph("Touch p99 (ms)", 0, 100.0f, ColorA(1.0f, 0.25f, 0, 1.0f));
+			}
+#endif
 
 			if (SettingsManager::get()->mTouchSimEnabled) {
 				addTouchSimulatorParams(SettingsManager::get()->mSimulatedTouchesPerSecond);
@@ -87,11 +138,18 @@ namespace bluecadet {
 				mIsLateSetupCompleted = true;
 			}
 
-			const double absoluteTime = getElapsedSeconds();
-			const double deltaTime    = mLastUpdateTime == 0 ? 0 : absoluteTime - mLastUpdateTime;
+			const double frameTime = getElapsedSeconds();
+			const double frameDeltaTime = mLastFrameTime == 0 ? 0 : frameTime - mLastFrameTime;
+			mLastFrameTime = frameTime;
+
+			// async AnimatedView callbacks from the previous frame
+			AnimatedView::dispatchQueuedCallbacks();
 
-			BaseView::FrameInfo frameInfo(absoluteTime, deltaTime);
-			mLastUpdateTime = absoluteTime;
+			// evict textures that haven't been drawn if over budget, then run queued uploads and spend what's left
+			// of the frame's upload budget on decoded images and swap them into their views
+			TextureCache::get()->update();
+			UploadScheduler::get()->update();
+			ImageLoader::get()->update();
 
 			// get the screen layout's transform and apply it to all
 			// touch events to convert touches from window into app space
@@ -102,9 +160,43 @@ namespace bluecadet {
 			touch::TouchManager::get()->update(mRootView, appSize, appTransform);
 #endif
 
-			mRootView->updateScene(frameInfo);
+			if (mFixedTimestep > 0) {
+				const int numSteps = std::max(1, SettingsManager::get()->mUpdateSubsteps);
+
+				for (int i = 0; i < numSteps; ++i) {
+					// multiply instead of accumulating so that step times don't drift
+					mNumFixedSteps++;
+					BaseView::sFixedTime = (double)mNumFixedSteps * mFixedTimestep;
+					updateStep(BaseView::FrameInfo(BaseView::sFixedTime, mFixedTimestep));
+				}
+
+			} else {
+				updateStep(BaseView::FrameInfo(frameTime, frameDeltaTime));
+			}
+
+			mStats->addValue("FPS", 1.0f / (float)frameDeltaTime);
+
+			const auto imageStats = ImageLoader::get()->getStats();
+			mStats->addValue("Image queue", (float)(imageStats.numQueuedDecodes + imageStats.numDecoding + imageStats.numQueuedUploads));
+			mStats->addValue("Image decode (ms)", (float)(imageStats.averageDecodeTime * 1000.0));
+			mStats->addValue("Textures (MB)", (float)TextureCache::get()->getNumResidentBytes() / (1024.0f * 1024.0f));
+			mStats->addValue("Uploads (MB)", (float)UploadScheduler::get()->getStats().numUploadedBytes / (1024.0f * 1024.0f));
+
+#ifndef NO_TOUCH
+			if (mTouchLatencyPlugin) {
+				const auto & latency = mTouchLatencyPlugin->getWindowStats(plugins::TouchLatencyPlugin::Phase::Total);
+				mStats->addValue("Touch p50 (ms)", (float)(latency.p50 * 1000.0));
+				mStats->addValue("Touch p95 (ms)", (float)(latency.p95 * 1000.0));
+				mStats->addValue("Touch p99 (ms)", (float)(latency.p99 * 1000.0));
+			}
+#endif
+		}
 
-			mStats->addValue("FPS", 1.0f / (float)frameInfo.deltaTime);
+		void BaseApp::updateStep(const BaseView::FrameInfo & frameInfo) {
+			mLastUpdateTime = frameInfo.absoluteTime;
+			mAnimationScheduler->update(frameInfo.absoluteTime);
+			mRootView->updateScene(frameInfo);
+			PropertyBindings::get()->update();
 		}
 
 		void BaseApp::draw(const bool clear) {
@@ -145,6 +237,13 @@ namespace bluecadet {
 					settings->getParams()->draw();
 				}
 			}
+
+#ifndef NO_TOUCH
+			// everything for this frame has been drawn at this point
+			if (mTouchLatencyPlugin) {
+				mTouchLatencyPlugin->frameDidPresent();
+			}
+#endif
 		}
 
 		void BaseApp::keyDown(KeyEvent event) {
@@ -211,6 +310,7 @@ namespace bluecadet {
 		}
 
 		void BaseApp::handleViewportChange(const ci::Area & viewport) {
+			BaseView::sAnimationThrottling.cullingBounds = Rectf(viewport);
 			mMiniMap->setViewport(viewport);
 			mMiniMap->setPosition(vec2(getWindowSize()) - mMiniMap->getSize() - vec2(mDebugUiPadding));
 			mStats->setPosition(vec2(mDebugUiPadding, (float)getWindowHeight() - mStats->getHeight() - mDebugUiPadding));
@@ -6,9 +6,17 @@
 #include "cinder/params/Params.h"
 
 // These aren't used in the header, but added as convenience includes for BaseApp sub classes.
+#include "AssetPack.h"
+#include "DiskImageCache.h"
+#include "ImageLoader.h"
 #include "ScreenLayout.h"
 #include "SettingsManager.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+#include "UploadScheduler.h"
 
+#include "../views/AnimatedView.h"
+#include "../views/AnimationScheduler.h"
 #include "../views/BaseView.h"
 #include "../views/GraphView.h"
 #include "../views/MiniMapView.h"
@@ -18,8 +26,11 @@
 #include "../touch/drivers/MouseDriver.h"
 #include "../touch/drivers/MultiNativeTouchDriver.h"
 #include "../touch/drivers/NativeTouchDriver.h"
+#include "../touch/drivers/ReplayTouchDriver.h"
 #include "../touch/drivers/SimulatedTouchDriver.h"
 #include "../touch/drivers/TuioDriver.h"
+#include "../touch/plugins/TouchLatencyPlugin.h"
+#include "../touch/plugins/TouchPredictionPlugin.h"
 #endif
 
 namespace bluecadet {
@@ -49,9 +60,16 @@ public:
 	// zoom/pan around the app.
 	views::BaseViewRef getRootView() const { return mRootView; };
 
-	// The last time that update was called in seconds since app launch.
+	// The time of the last update step in seconds since app launch. In fixed timestep mode this is the number of
+	// fixed steps times SettingsManager::mFixedTimestep, independent of wall time.
 	double getLastUpdateTime() const { return mLastUpdateTime; }
 
+	// True if FrameInfos, the animation scheduler and view timelines are advanced in fixed steps (see SettingsManager::mFixedTimestep).
+	bool isFixedTimestepEnabled() const { return mFixedTimestep > 0; }
+
+	// Shared animation engine for views. Advanced on each update before the root view's scene is updated.
+	views::AnimationSchedulerRef getAnimationScheduler() const { return mAnimationScheduler; }
+
 	// Debug view to render stats like fps in a graph.
 	views::GraphViewRef getStats() const { return mStats; };
 
@@ -71,6 +89,9 @@ public:
 
 	// Adds a set of params to control the touch simulator
 	void addTouchSimulatorParams(float touchesPerSecond = 50.f);
+
+	// Measures touch latency from driver to screen. Only created if SettingsManager::mShowTouchLatency is enabled at setup, otherwise nullptr.
+	touch::plugins::TouchLatencyPluginRef getTouchLatencyPlugin() const { return mTouchLatencyPlugin; }
 #endif
 
 protected:
@@ -78,11 +99,18 @@ protected:
 	virtual void handleViewportChange(const ci::Area & viewport);
 	virtual void handleSettingsLoaded();
 
+	// Advances the animation scheduler and the root view's scene by one update step, then updates property bindings.
+	virtual void updateStep(const views::BaseView::FrameInfo & frameInfo);
+
 private:
 	views::BaseViewRef mRootView;
 	views::MiniMapViewRef mMiniMap;
 	views::GraphViewRef mStats;
+	views::AnimationSchedulerRef mAnimationScheduler;
 	double mLastUpdateTime;
+	double mLastFrameTime;	// Wall time of the last update()
+	double mFixedTimestep;	// 0 unless fixed timestep mode is enabled
+	uint64_t mNumFixedSteps;
 	float mDebugUiPadding;
 	bool mIsLateSetupCompleted;
 
@@ -92,6 +120,7 @@ private:
 	touch::drivers::NativeTouchDriver mNativeTouchDriver;
 	touch::drivers::MultiNativeTouchDriver mMultiNativeTouchDriver;
 	touch::drivers::SimulatedTouchDriver mSimulatedTouchDriver;
+	touch::plugins::TouchLatencyPluginRef mTouchLatencyPlugin;
 #endif
 };
 
@@ -0,0 +1,424 @@
+#include "DiskImageCache.h"
+#include "AssetPack.h"
+#include "MappedFile.h"
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+//==================================================
+// Entry format
+//
+
+namespace {
+
+	const size_t kPageSize = 4096;
+	const char * kExtension = ".bcdc";
+
+#pragma pack(push, 1)
+
+	struct FileHeader {
+		static const uint32_t kMagic = 0x43444342; // "BCDC"
+		static const uint32_t kVersion = 1;
+
+		uint32_t	magic			= kMagic;
+		uint32_t	version			= kVersion;
+		uint64_t	contentHash		= 0;
+		uint64_t	sourceSize		= 0;
+		int64_t		modifiedTime	= 0;
+		uint32_t	width			= 0;
+		uint32_t	height			= 0;
+		uint32_t	rowBytes		= 0;
+		uint32_t	channelOrder	= 0;	//! SurfaceChannelOrder code
+		uint64_t	dataOffset		= 0;	//! Multiple of kPageSize
+		uint64_t	dataSize		= 0;
+		uint32_t	dataCrc32		= 0;
+		uint32_t	headerCrc32		= 0;	//! Checksum of all previous fields
+	};
+
+#pragma pack(pop)
+
+	uint32_t getHeaderCrc(const FileHeader & header) {
+		return assetpack::crc32(reinterpret_cast<const uint8_t *>(&header), offsetof(FileHeader, headerCrc32));
+	}
+
+	uint64_t mixHash(uint64_t hash, const uint64_t value) {
+		hash ^= value * 0x9E3779B97F4A7C15ull;
+		hash = (hash << 31) | (hash >> 33);
+		return hash * 0xBF58476D1CE4E5B9ull;
+	}
+}
+
+std::string DiskImageCache::Key::getFileName() const {
+	const uint64_t hash = mixHash(mixHash(mixHash(0, contentHash), size), (uint64_t)modifiedTime);
+
+	stringstream stream;
+	stream << hex << setw(16) << setfill('0') << hash << kExtension;
+	return stream.str();
+}
+
+//==================================================
+// Lifecycle
+//
+
+DiskImageCacheRef DiskImageCache::get() {
+	static auto instance = std::make_shared<DiskImageCache>();
+	return instance;
+}
+
+DiskImageCache::DiskImageCache() :
+	mMaxNumBytes(0),
+	mVerifyData(false),
+	mIsIndexed(false),
+	mNumResidentBytes(0)
+{
+}
+
+DiskImageCache::~DiskImageCache() {
+}
+
+bool DiskImageCache::setup(const ci::fs::path & directory, const size_t maxNumBytes) {
+	error_code error;
+	fs::create_directories(directory, error);
+
+	if (!fs::is_directory(directory, error)) {
+		CI_LOG_E("Could not create image cache directory '" << directory << "'");
+		return false;
+	}
+
+	lock_guard<mutex> lock(mMutex);
+	mDirectory = directory;
+	mMaxNumBytes = maxNumBytes;
+	mIsIndexed = false;
+	mEntries.clear();
+	mNumResidentBytes = 0;
+	return true;
+}
+
+//==================================================
+// Loading
+//
+
+DiskImageCache::Key DiskImageCache::createKey(const ci::fs::path & path, const ci::BufferRef & encodedData) {
+	Key key;
+	key.size = encodedData ? encodedData->getSize() : 0;
+
+	const uint8_t * data = encodedData ? static_cast<const uint8_t *>(encodedData->getData()) : nullptr;
+	const size_t numWords = (size_t)key.size / sizeof(uint64_t);
+	uint64_t hash = mixHash(0, key.size);
+
+	for (size_t i = 0; i < numWords; ++i) {
+		uint64_t word;
+		memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+		hash = mixHash(hash, word);
+	}
+
+	for (size_t i = numWords * sizeof(uint64_t); i < key.size; ++i) {
+		hash = mixHash(hash, data[i]);
+	}
+
+	key.contentHash = hash;
+
+	if (path.is_absolute()) {
+		error_code error;
+		const auto modifiedTime = fs::last_write_time(path, error);
+
+		if (!error) {
+			key.modifiedTime = (int64_t)modifiedTime.time_since_epoch().count();
+		}
+	}
+
+	return key;
+}
+
+ci::Surface8uRef DiskImageCache::load(const Key & key) {
+	if (!isEnabled()) {
+		return nullptr;
+	}
+
+	const string fileName = key.getFileName();
+	const fs::path path = mDirectory / fileName;
+	error_code error;
+
+	if (!fs::exists(path, error)) {
+		lock_guard<mutex> lock(mMutex);
+		mStats.numMisses++;
+		return nullptr;
+	}
+
+	// the modification time is used to evict the least recently used entries, even across launches. it's updated
+	// before the file is mapped since Windows doesn't allow changing attributes of files that are only open for reading
+	const auto now = fs::file_time_type::clock::now();
+	fs::last_write_time(path, now, error);
+
+	MappedFileRef file = MappedFile::open(path);
+	FileHeader header;
+
+	bool isValid = file && file->getSize() >= sizeof(header);
+
+	if (isValid) {
+		memcpy(&header, file->getData(), sizeof(header));
+
+		isValid = header.magic == FileHeader::kMagic
+			&& header.version == FileHeader::kVersion
+			&& header.headerCrc32 == getHeaderCrc(header)
+			&& header.contentHash == key.contentHash && header.sourceSize == key.size && header.modifiedTime == key.modifiedTime
+			&& header.dataOffset % kPageSize == 0
+			&& header.rowBytes >= header.width * 4
+			&& header.dataSize == (uint64_t)header.rowBytes * header.height
+			&& header.dataOffset + header.dataSize == file->getSize();
+	}
+
+	if (isValid && mVerifyData) {
+		isValid = assetpack::crc32(file->getData() + header.dataOffset, (size_t)header.dataSize) == header.dataCrc32;
+	}
+
+	if (!isValid) {
+		CI_LOG_W("Removing corrupted image cache entry '" << path << "'");
+		file = nullptr;
+
+		lock_guard<mutex> lock(mMutex);
+		mStats.numRejected++;
+		mStats.numMisses++;
+		removeEntry(fileName);
+		return nullptr;
+	}
+
+	// pixels stay in the mapped file; the deleter keeps it mapped while the surface is in use
+	uint8_t * pixels = const_cast<uint8_t *>(file->getData() + header.dataOffset);
+	Surface8uRef surface(new Surface8u(pixels, (int32_t)header.width, (int32_t)header.height, (ptrdiff_t)header.rowBytes, SurfaceChannelOrder(header.channelOrder)), [file](Surface8u * surface) {
+		delete surface;
+	});
+
+	lock_guard<mutex> lock(mMutex);
+	mStats.numHits++;
+
+	auto it = mEntries.find(fileName);
+	if (it != mEntries.end()) {
+		it->second.lastUsedTime = now;
+	}
+
+	return surface;
+}
+
+//==================================================
+// Storing
+//
+
+bool DiskImageCache::store(const Key & key, const ci::Surface8u & surface) {
+	if (!isEnabled() || surface.getPixelInc() != 4 || surface.getWidth() <= 0 || surface.getHeight() <= 0) {
+		return false;
+	}
+
+	{
+		lock_guard<mutex> lock(mMutex);
+		if (!mIsIndexed) {
+			indexEntries();
+		}
+	}
+
+	const string fileName = key.getFileName();
+	const fs::path path = mDirectory / fileName;
+
+	// each thread writes to its own file in case two requests decoded the same image
+	const fs::path tempPath = mDirectory / (fileName + "." + to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp");
+
+	const size_t rowBytes = (size_t)surface.getWidth() * 4;
+
+	FileHeader header;
+	header.contentHash = key.contentHash;
+	header.sourceSize = key.size;
+	header.modifiedTime = key.modifiedTime;
+	header.width = (uint32_t)surface.getWidth();
+	header.height = (uint32_t)surface.getHeight();
+	header.rowBytes = (uint32_t)rowBytes;
+	header.channelOrder = (uint32_t)surface.getChannelOrder().getCode();
+	header.dataOffset = kPageSize;
+	header.dataSize = (uint64_t)rowBytes * surface.getHeight();
+
+	// rows are stored without any padding of the surface
+	vector<uint8_t> packedPixels;
+	const uint8_t * pixels = surface.getData();
+
+	if ((size_t)surface.getRowBytes() != rowBytes) {
+		packedPixels.resize((size_t)header.dataSize);
+		for (int32_t y = 0; y < surface.getHeight(); ++y) {
+			memcpy(packedPixels.data() + y * rowBytes, surface.getData() + y * surface.getRowBytes(), rowBytes);
+		}
+		pixels = packedPixels.data();
+	}
+
+	header.dataCrc32 = assetpack::crc32(pixels, (size_t)header.dataSize);
+	header.headerCrc32 = getHeaderCrc(header);
+
+	{
+		ofstream stream(tempPath.string(), ios::out | ios::binary | ios::trunc);
+
+		if (!stream.is_open()) {
+			CI_LOG_E("Could not open '" << tempPath << "' for writing");
+			return false;
+		}
+
+		vector<char> headerPage(kPageSize, 0);
+		memcpy(headerPage.data(), &header, sizeof(header));
+		stream.write(headerPage.data(), headerPage.size());
+		stream.write(reinterpret_cast<const char *>(pixels), (streamsize)header.dataSize);
+
+		if (!stream) {
+			CI_LOG_E("Could not write image cache entry '" << tempPath << "'");
+			stream.close();
+			error_code error;
+			fs::remove(tempPath, error);
+			return false;
+		}
+	}
+
+	error_code error;
+	fs::rename(tempPath, path, error);
+
+	if (error) {
+		// most likely another thread stored the same image and it's mapped already
+		fs::remove(tempPath, error);
+		return false;
+	}
+
+	const size_t numBytes = (size_t)(header.dataOffset + header.dataSize);
+
+	lock_guard<mutex> lock(mMutex);
+
+	auto it = mEntries.find(fileName);
+	if (it != mEntries.end()) {
+		mNumResidentBytes -= it->second.numBytes;
+	}
+
+	mEntries[fileName] = { numBytes, fs::file_time_type::clock::now() };
+	mNumResidentBytes += numBytes;
+	mStats.numStored++;
+
+	trim();
+	return true;
+}
+
+//==================================================
+// Index
+//
+
+void DiskImageCache::indexEntries() {
+	mEntries.clear();
+	mNumResidentBytes = 0;
+
+	error_code error;
+
+	for (fs::directory_iterator it(mDirectory, error), end; !error && it != end; it.increment(error)) {
+		const fs::path & path = it->path();
+		error_code entryError;
+
+		if (path.extension() == ".tmp") {
+			// left behind by a crash while writing
+			fs::remove(path, entryError);
+			continue;
+		}
+
+		if (path.extension() != kExtension) {
+			continue;
+		}
+
+		const size_t numBytes = (size_t)fs::file_size(path, entryError);
+		const auto lastUsedTime = fs::last_write_time(path, entryError);
+
+		if (!entryError) {
+			mEntries[path.filename().string()] = { numBytes, lastUsedTime };
+			mNumResidentBytes += numBytes;
+		}
+	}
+
+	mIsIndexed = true;
+	trim();
+}
+
+void DiskImageCache::trim() {
+	if (mMaxNumBytes == 0 || mNumResidentBytes <= mMaxNumBytes) {
+		return;
+	}
+
+	vector<pair<fs::file_time_type, string>> entries;
+	entries.reserve(mEntries.size());
+
+	for (const auto & entry : mEntries) {
+		entries.push_back(make_pair(entry.second.lastUsedTime, entry.first));
+	}
+
+	sort(entries.begin(), entries.end());
+
+	// leave some headroom so that we don't trim on every store
+	const size_t targetNumBytes = mMaxNumBytes - mMaxNumBytes / 10;
+
+	for (const auto & entry : entries) {
+		if (mNumResidentBytes <= targetNumBytes) {
+			break;
+		}
+		removeEntry(entry.second);
+	}
+}
+
+void DiskImageCache::removeEntry(const std::string & fileName) {
+	error_code error;
+	fs::remove(mDirectory / fileName, error);
+
+	if (error) {
+		return;
+	}
+
+	auto it = mEntries.find(fileName);
+
+	if (it != mEntries.end()) {
+		mNumResidentBytes -= it->second.numBytes;
+		mEntries.erase(it);
+	}
+}
+
+void DiskImageCache::clear() {
+	lock_guard<mutex> lock(mMutex);
+
+	if (!isEnabled()) {
+		return;
+	}
+
+	if (!mIsIndexed) {
+		indexEntries();
+	}
+
+	vector<string> fileNames;
+	for (const auto & entry : mEntries) {
+		fileNames.push_back(entry.first);
+	}
+
+	for (const auto & fileName : fileNames) {
+		removeEntry(fileName);
+	}
+}
+
+DiskImageCache::Stats DiskImageCache::getStats() const {
+	lock_guard<mutex> lock(mMutex);
+	Stats stats = mStats;
+	stats.numResidentBytes = mNumResidentBytes;
+	return stats;
+}
+
+}
+}
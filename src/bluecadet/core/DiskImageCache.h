@@ -0,0 +1,104 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace bluecadet {
+namespace core {
+
+typedef std::shared_ptr<class DiskImageCache> DiskImageCacheRef;
+
+//! Opt-in cache of decoded images on disk. The ImageLoader stores the RGBA pixels of each image it decodes and later
+//! launches map them straight into a Surface instead of decoding the source again. Entries are keyed by the source's
+//! content hash, size and modification time, so changed images are never served stale.
+//!
+//! Each entry is a single file with a header page followed by rows of raw pixels at a page-aligned offset. Files are
+//! written to a temporary name and renamed once complete. Headers are checksummed and the pixel data can optionally be
+//! verified against its checksum as well. Least recently used entries are removed once the cache exceeds its budget.
+//!
+//! Thread-safe; the ImageLoader accesses it from its worker threads.
+class DiskImageCache {
+
+public:
+
+	struct Key {
+		uint64_t	contentHash		= 0;
+		uint64_t	size			= 0;
+		int64_t		modifiedTime	= 0;	//! 0 for sources without timestamps (e.g. assets in packs)
+
+		std::string	getFileName() const;
+	};
+
+	struct Stats {
+		size_t	numHits			= 0;
+		size_t	numMisses		= 0;
+		size_t	numStored		= 0;
+		size_t	numRejected		= 0;	//! Entries that failed integrity checks
+		size_t	numResidentBytes = 0;	//! Only known once the cache directory has been indexed by the first store()
+	};
+
+	//! Shared instance that is configured by the BaseApp.
+	static DiskImageCacheRef get();
+
+	DiskImageCache();
+	~DiskImageCache();
+
+	//! Enables the cache in directory, which is created if necessary. maxNumBytes of 0 disables the size limit.
+	bool					setup(const ci::fs::path & directory, const size_t maxNumBytes);
+	bool					isEnabled() const						{ return !mDirectory.empty(); }
+	const ci::fs::path &	getDirectory() const					{ return mDirectory; }
+
+	//! Creates the key for the encoded bytes of path. Reads the modification time from disk for absolute paths.
+	static Key				createKey(const ci::fs::path & path, const ci::BufferRef & encodedData);
+
+	//! Maps the entry for key. The surface keeps the file mapped while it's referenced. Returns nullptr on a miss or if
+	//! the entry is corrupted, in which case it's removed.
+	ci::Surface8uRef		load(const Key & key);
+
+	//! Writes surface as the entry for key and removes least recently used entries if the cache is over budget.
+	bool					store(const Key & key, const ci::Surface8u & surface);
+
+	//! Removes all entries.
+	void					clear();
+
+	//! Compares the checksum of the pixel data on every load. Reads each image in full, so this is disabled by default.
+	void					setVerifyData(const bool value)			{ mVerifyData = value; }
+	bool					getVerifyData() const					{ return mVerifyData; }
+
+	void					setMaxNumBytes(const size_t value)		{ mMaxNumBytes = value; }
+	size_t					getMaxNumBytes() const					{ return mMaxNumBytes; }
+
+	Stats					getStats() const;
+
+protected:
+
+	struct IndexEntry {
+		size_t				numBytes;
+		ci::fs::file_time_type	lastUsedTime;	//! Persisted as the file's modification time
+	};
+
+	//! Scans the directory for existing entries. Called lazily so that launching doesn't wait for it. Requires mMutex.
+	void					indexEntries();
+
+	//! Removes least recently used entries until the cache is below its budget. Requires mMutex.
+	void					trim();
+
+	//! Removes the entry's file. Entries that are still mapped can't be removed on Windows and are kept. Requires mMutex.
+	void					removeEntry(const std::string & fileName);
+
+	ci::fs::path			mDirectory;
+	size_t					mMaxNumBytes;
+	bool					mVerifyData;
+
+	mutable std::mutex		mMutex;
+	bool					mIsIndexed;
+	std::unordered_map<std::string, IndexEntry>	mEntries;
+	size_t					mNumResidentBytes;
+	Stats					mStats;
+};
+
+}
+}
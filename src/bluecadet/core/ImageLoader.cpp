@@ -0,0 +1,485 @@
+#include "ImageLoader.h"
+#include "AssetPack.h"
+#include "DiskImageCache.h"
+#include "UploadScheduler.h"
+
+#include "cinder/ImageIo.h"
+#include "cinder/Log.h"
+#include "cinder/Timer.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+static string getLowerCaseExtension(const fs::path & path) {
+	string extension = path.extension().string();
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	return extension;
+}
+
+//==================================================
+// Request
+//
+
+ImageLoader::Request::Request(const ci::fs::path & path, const ci::gl::Texture2d::Format & format, CompletionFn callback, const float priority) :
+	mPath(path),
+	mFormat(format),
+	mCompletionFn(callback),
+	mPriority(priority),
+	mIsCanceled(false),
+	mIsComplete(false),
+	mSurface(nullptr),
+	mTextureData(nullptr),
+	mIsTextureDataTopDown(false),
+	mTexture(nullptr),
+	mNumUploadedRows(0)
+{
+}
+
+//==================================================
+// Lifecycle
+//
+
+ImageLoaderRef ImageLoader::get() {
+	static auto instance = std::make_shared<ImageLoader>();
+	return instance;
+}
+
+ImageLoader::ImageLoader() :
+	mIsStopping(false),
+	mUploadBudget(8 * 1024 * 1024),
+	mPreferCompressedTextures(false)
+{
+}
+
+ImageLoader::~ImageLoader() {
+	stopThreads();
+}
+
+void ImageLoader::setup(const int numThreads) {
+	stopThreads();
+	startThreads(numThreads);
+}
+
+void ImageLoader::startThreads(const int numThreads) {
+	const int numCores = (int)std::thread::hardware_concurrency();
+	const int count = numThreads > 0 ? numThreads : std::max(1, numCores - 1);
+
+	mIsStopping = false;
+
+	for (int i = 0; i < count; ++i) {
+		mThreads.emplace_back(&ImageLoader::runWorker, this);
+	}
+}
+
+void ImageLoader::stopThreads() {
+	{
+		lock_guard<mutex> lock(mMutex);
+		mIsStopping = true;
+	}
+
+	mCondition.notify_all();
+
+	for (auto & thread : mThreads) {
+		thread.join();
+	}
+
+	mThreads.clear();
+}
+
+//==================================================
+// Requests
+//
+
+ImageLoader::RequestRef ImageLoader::load(const ci::fs::path & path, CompletionFn callback, const float priority, const ci::gl::Texture2d::Format & format) {
+	RequestRef request(new Request(path, format, callback, priority));
+	queueDecode(request);
+	return request;
+}
+
+ImageLoader::RequestRef ImageLoader::loadSurface(const ci::fs::path & path, SurfaceFn callback, const float priority) {
+	RequestRef request(new Request(path, gl::Texture2d::Format(), nullptr, priority));
+	request->mSurfaceFn = callback;
+	queueDecode(request);
+	return request;
+}
+
+ImageLoader::RequestRef ImageLoader::upload(ci::Surface8uRef surface, CompletionFn callback, const float priority, const ci::gl::Texture2d::Format & format) {
+	RequestRef request(new Request(fs::path(), format, callback, priority));
+	request->mSurface = surface;
+	mUploads.push_back(request);
+	return request;
+}
+
+void ImageLoader::queueDecode(RequestRef request) {
+	if (mThreads.empty()) {
+		startThreads(0);
+	}
+
+	// packed assets stay relative and are read from the pack when decoded
+	const fs::path & path = request->mPath;
+	const fs::path resolvedPath = path.is_absolute() || AssetPack::hasAsset(path) ? path : getAssetPath(path);
+
+	if (resolvedPath.empty()) {
+		CI_LOG_E("Could not find image at '" << path << "'");
+	}
+
+	request->mPath = resolvedPath;
+
+	{
+		lock_guard<mutex> lock(mMutex);
+		mPendingDecodes.push_back(request);
+	}
+
+	mCondition.notify_one();
+}
+
+void ImageLoader::cancelAll() {
+	lock_guard<mutex> lock(mMutex);
+
+	for (auto & request : mPendingDecodes) request->cancel();
+	for (auto & request : mDecoded) request->cancel();
+	for (auto & request : mUploads) request->cancel();
+
+	mPendingDecodes.clear();
+}
+
+ImageLoader::Stats ImageLoader::getStats() const {
+	lock_guard<mutex> lock(mMutex);
+	Stats stats = mStats;
+	stats.numQueuedDecodes = mPendingDecodes.size();
+	stats.numQueuedUploads = mDecoded.size() + mUploads.size();
+	return stats;
+}
+
+//==================================================
+// Decoding
+//
+
+ImageLoader::RequestRef ImageLoader::popNextDecode() {
+	mPendingDecodes.erase(remove_if(mPendingDecodes.begin(), mPendingDecodes.end(), [](const RequestRef & request) {
+		return request->isCanceled();
+	}), mPendingDecodes.end());
+
+	// linear search since priorities can change at any time and queues are usually short
+	auto best = max_element(mPendingDecodes.begin(), mPendingDecodes.end(), [](const RequestRef & a, const RequestRef & b) {
+		return a->getPriority() < b->getPriority();
+	});
+
+	if (best == mPendingDecodes.end()) {
+		return nullptr;
+	}
+
+	RequestRef request = *best;
+	mPendingDecodes.erase(best);
+	return request;
+}
+
+void ImageLoader::runWorker() {
+	while (true) {
+		RequestRef request;
+
+		{
+			unique_lock<mutex> lock(mMutex);
+			mCondition.wait(lock, [&] { return mIsStopping || !mPendingDecodes.empty(); });
+
+			if (mIsStopping) {
+				return;
+			}
+
+			request = popNextDecode();
+
+			if (!request) {
+				continue;
+			}
+
+			mStats.numDecoding++;
+		}
+
+		Timer timer(true);
+		decode(*request);
+		const double decodeTime = timer.getSeconds();
+
+		{
+			lock_guard<mutex> lock(mMutex);
+
+			mStats.numDecoding--;
+			mStats.lastDecodeTime = decodeTime;
+			mStats.maxDecodeTime = std::max(mStats.maxDecodeTime, decodeTime);
+			mStats.averageDecodeTime = mStats.averageDecodeTime <= 0 ? decodeTime : mStats.averageDecodeTime * 0.9 + decodeTime * 0.1;
+
+			if (!request->isCanceled()) {
+				if (!request->mSurface && !request->mTextureData) {
+					mStats.numFailed++;
+				}
+				mDecoded.push_back(request);
+			}
+		}
+	}
+}
+
+void ImageLoader::decode(Request & request) {
+	if (request.mPath.empty()) {
+		return;
+	}
+
+	fs::path path = request.mPath;
+
+	if (mPreferCompressedTextures && !request.mSurfaceFn && !isCompressedTextureFile(path)) {
+		const fs::path compressedPath = findCompressedTexture(path);
+
+		if (!compressedPath.empty()) {
+			path = compressedPath;
+		}
+	}
+
+	try {
+		if (isCompressedTextureFile(path)) {
+			// blocks are uploaded as is, so there's nothing to decode
+			auto textureData = make_shared<gl::TextureData>();
+
+			const bool isKtx = getLowerCaseExtension(path) == ".ktx";
+
+			if (isKtx) {
+				gl::parseKtx(AssetPack::loadAsset(path), textureData.get());
+			} else {
+				gl::parseDds(AssetPack::loadAsset(path), textureData.get());
+			}
+
+			request.mTextureData = textureData;
+			request.mIsTextureDataTopDown = !isKtx;
+
+		} else if (DiskImageCache::get()->isEnabled()) {
+			// read the encoded bytes once to hash them and decode from the same buffer on misses
+			const BufferRef encodedData = AssetPack::loadAsset(path)->getBuffer();
+			const DiskImageCache::Key key = DiskImageCache::createKey(path, encodedData);
+
+			request.mSurface = DiskImageCache::get()->load(key);
+
+			if (!request.mSurface) {
+				request.mSurface = Surface8u::create(loadImage(DataSourceBuffer::create(encodedData, path)), SurfaceConstraintsDefault(), true);
+
+				if (request.mSurface) {
+					DiskImageCache::get()->store(key, *request.mSurface);
+				}
+			}
+
+		} else {
+			// always decode with alpha so that all surfaces are RGBA and can be uploaded the same way
+			request.mSurface = Surface8u::create(loadImage(AssetPack::loadAsset(path)), SurfaceConstraintsDefault(), true);
+		}
+
+	} catch (ci::Exception & e) {
+		CI_LOG_EXCEPTION("Could not decode image '" << path << "'", e);
+		request.mSurface = nullptr;
+		request.mTextureData = nullptr;
+	}
+}
+
+bool ImageLoader::isCompressedTextureFile(const ci::fs::path & path) {
+	const string extension = getLowerCaseExtension(path);
+	return extension == ".ktx" || extension == ".dds";
+}
+
+ci::fs::path ImageLoader::findCompressedTexture(const ci::fs::path & path) const {
+	if (path.is_relative()) {
+		// packs have no timestamps, but the packer skips stale compressed textures
+		for (const auto & extension : {".ktx", ".dds"}) {
+			fs::path compressedPath = path;
+			compressedPath.replace_extension(extension);
+
+			if (AssetPack::hasAsset(compressedPath)) {
+				return compressedPath;
+			}
+		}
+
+		return fs::path();
+	}
+
+	try {
+		const auto lastWriteTime = fs::last_write_time(path);
+
+		for (const auto & extension : {".ktx", ".dds"}) {
+			fs::path compressedPath = path;
+			compressedPath.replace_extension(extension);
+
+			// ignore stale files that haven't been converted since the original changed
+			if (fs::exists(compressedPath) && fs::last_write_time(compressedPath) >= lastWriteTime) {
+				return compressedPath;
+			}
+		}
+
+	} catch (fs::filesystem_error &) {
+		// fall back to the original, which reports its own error if it's missing
+	}
+
+	return fs::path();
+}
+
+//==================================================
+// Uploading
+//
+
+void ImageLoader::update() {
+	{
+		lock_guard<mutex> lock(mMutex);
+		mUploads.insert(mUploads.end(), mDecoded.begin(), mDecoded.end());
+		mDecoded.clear();
+	}
+
+	mUploads.erase(remove_if(mUploads.begin(), mUploads.end(), [](const RequestRef & request) {
+		return request->isCanceled();
+	}), mUploads.end());
+
+	// hand off surfaces of requests that skip the upload; callbacks can queue new uploads, so split them off first
+	auto surfacesBegin = stable_partition(mUploads.begin(), mUploads.end(), [](const RequestRef & request) {
+		return !request->mSurfaceFn;
+	});
+	vector<RequestRef> decodedSurfaces(surfacesBegin, mUploads.end());
+	mUploads.erase(surfacesBegin, mUploads.end());
+
+	size_t numCompleted = 0;
+
+	for (auto & request : decodedSurfaces) {
+		// callbacks can destroy views that cancel other requests, so check again before each one
+		if (request->isCanceled()) {
+			request->mSurface = nullptr;
+			continue;
+		}
+
+		request->mIsComplete = true;
+		request->mSurfaceFn(request->mSurface);
+		request->mSurface = nullptr;
+		numCompleted++;
+	}
+
+	// finish the most important images first; stable so that partial uploads of equal priority aren't interrupted
+	stable_sort(mUploads.begin(), mUploads.end(), [](const RequestRef & a, const RequestRef & b) {
+		return a->getPriority() > b->getPriority();
+	});
+
+	// share the frame's upload budget with textures and fbos that have been queued with the UploadScheduler
+	UploadSchedulerRef scheduler = UploadScheduler::get();
+	const size_t uploadBudget = min(mUploadBudget, scheduler->getRemainingBytes());
+
+	size_t numUploadedBytes = 0;
+	Timer timer(true);
+
+	while (!mUploads.empty() && (numUploadedBytes < uploadBudget || numUploadedBytes == 0)) {
+		RequestRef request = mUploads.front();
+
+		// canceled by a completion function earlier in this loop
+		if (request->isCanceled()) {
+			mUploads.erase(mUploads.begin());
+			continue;
+		}
+
+		if (request->mTextureData) {
+			// compressed textures can't be split into rows; wait for the next update if one doesn't fit into the remaining budget
+			if (numUploadedBytes > 0 && numUploadedBytes + request->mTextureData->getDataStoreSize() > uploadBudget) {
+				break;
+			}
+
+			numUploadedBytes += uploadCompressed(*request);
+
+		} else if (request->mSurface) {
+			const size_t remainingBytes = uploadBudget > numUploadedBytes ? uploadBudget - numUploadedBytes : 0;
+			numUploadedBytes += uploadChunk(*request, remainingBytes);
+		}
+
+		if (request->mSurface && request->mNumUploadedRows < request->mSurface->getHeight()) {
+			// out of budget
+			break;
+		}
+
+		mUploads.erase(mUploads.begin());
+		completeRequest(*request);
+		numCompleted++;
+	}
+
+	scheduler->addUploadedBytes(numUploadedBytes, timer.getSeconds());
+
+	lock_guard<mutex> lock(mMutex);
+	mStats.numUploadedBytes = numUploadedBytes;
+	mStats.numLoaded += numCompleted;
+}
+
+size_t ImageLoader::uploadChunk(Request & request, const size_t maxBytes) {
+	const Surface8u & surface = *request.mSurface;
+	const size_t rowBytes = surface.getRowBytes();
+	const int32_t remainingRows = surface.getHeight() - request.mNumUploadedRows;
+	const int32_t numRows = std::min(remainingRows, std::max(1, (int32_t)(maxBytes / std::max<size_t>(rowBytes, 1))));
+	const size_t numBytes = rowBytes * numRows;
+
+	if (!request.mTexture) {
+		request.mTexture = gl::Texture2d::create(surface.getWidth(), surface.getHeight(), request.mFormat);
+		// rows are uploaded in surface order
+		request.mTexture->setTopDown(true);
+	}
+
+	if (!mPbo || mPbo->getSize() < numBytes) {
+		mPbo = gl::Pbo::create(GL_PIXEL_UNPACK_BUFFER, numBytes, nullptr, GL_STREAM_DRAW);
+	} else {
+		// orphan the previous chunk so that we don't wait for the driver to finish reading it
+		mPbo->bufferData(mPbo->getSize(), nullptr, GL_STREAM_DRAW);
+	}
+
+	mPbo->bufferSubData(0, numBytes, surface.getData() + rowBytes * request.mNumUploadedRows);
+
+	{
+		gl::ScopedTextureBind scopedTexture(request.mTexture);
+		gl::ScopedBuffer scopedPbo(mPbo);
+
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)(rowBytes / surface.getPixelInc()));
+		glTexSubImage2D(request.mTexture->getTarget(), 0, 0, request.mNumUploadedRows, surface.getWidth(), numRows, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	}
+
+	request.mNumUploadedRows += numRows;
+
+	if (request.mNumUploadedRows >= surface.getHeight() && request.mFormat.hasMipmapping()) {
+		gl::ScopedTextureBind scopedTexture(request.mTexture);
+		glGenerateMipmap(request.mTexture->getTarget());
+	}
+
+	return numBytes;
+}
+
+size_t ImageLoader::uploadCompressed(Request & request) {
+	const gl::TextureData & textureData = *request.mTextureData;
+
+	try {
+		request.mTexture = gl::Texture2d::create(textureData, request.mFormat);
+		// blocks are uploaded in file order, so the texture is flipped like its container
+		request.mTexture->setTopDown(request.mIsTextureDataTopDown);
+
+	} catch (ci::Exception & e) {
+		CI_LOG_EXCEPTION("Could not upload compressed texture '" << request.mPath << "'", e);
+		request.mTexture = nullptr;
+	}
+
+	return textureData.getDataStoreSize();
+}
+
+void ImageLoader::completeRequest(Request & request) {
+	request.mIsComplete = true;
+	request.mSurface = nullptr;
+	request.mTextureData = nullptr;
+
+	// nullptr if decoding or uploading failed
+	gl::Texture2dRef texture = request.mTexture;
+	request.mTexture = nullptr;
+
+	if (request.mCompletionFn) {
+		request.mCompletionFn(texture);
+	}
+}
+
+}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Pbo.h"
+#include "cinder/gl/Texture.h"
+#include "cinder/gl/TextureFormatParsers.h"
+#include "cinder/Surface.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bluecadet {
+namespace core {
+
+typedef std::shared_ptr<class ImageLoader> ImageLoaderRef;
+
+//! Loads images without blocking the main thread. Files are decoded to RGBA surfaces on a pool of worker threads
+//! and uploaded on the main thread in row chunks through a pixel buffer object, so that each update only spends a
+//! limited number of bytes on texture uploads. Requests with a higher priority are decoded and uploaded first.
+//!
+//! GPU-compressed KTX and DDS files (e.g. BC1, BC3 or BC7) aren't decoded. Their blocks are read by the workers and
+//! uploaded as is in a single update, including all mip levels stored in the file.
+//!
+//! If the DiskImageCache is enabled, decoded pixels are stored on disk and mapped on later launches instead of decoding
+//! the same images again. Mipmaps are still generated on the GPU after the upload.
+//!
+//! The BaseApp updates the shared instance once per frame before the scene is updated, so completion functions
+//! are always called on the main thread with a current GL context. Canceled requests never call their completion function.
+class ImageLoader {
+
+public:
+
+	//! Called on the main thread once the texture is fully uploaded. texture is nullptr if the image couldn't be loaded.
+	typedef std::function<void(ci::gl::Texture2dRef texture)> CompletionFn;
+
+	//! Called on the main thread with the decoded pixels of requests that skip the upload. surface is nullptr if the image couldn't be decoded.
+	//! Surfaces can be mapped read-only from the DiskImageCache, so copy them before modifying them.
+	typedef std::function<void(ci::Surface8uRef surface)> SurfaceFn;
+
+	//! Handle of a pending image. All methods are thread-safe.
+	class Request {
+	public:
+		void					cancel()						{ mIsCanceled = true; }
+		bool					isCanceled() const				{ return mIsCanceled; }
+		bool					isComplete() const				{ return mIsComplete; }
+
+		//! Can be changed at any time to move this request up or down in the decode and upload queues.
+		void					setPriority(const float value)	{ mPriority = value; }
+		float					getPriority() const				{ return mPriority; }
+
+		const ci::fs::path &	getPath() const					{ return mPath; }
+
+	protected:
+		friend class ImageLoader;
+
+		Request(const ci::fs::path & path, const ci::gl::Texture2d::Format & format, CompletionFn callback, const float priority);
+
+		ci::fs::path				mPath;				//! Resolved when queued unless it's in a mounted AssetPack
+		const ci::gl::Texture2d::Format	mFormat;
+		CompletionFn				mCompletionFn;
+		SurfaceFn					mSurfaceFn;			//! Set for requests that are completed after decoding
+
+		std::atomic<float>			mPriority;
+		std::atomic<bool>			mIsCanceled;
+		std::atomic<bool>			mIsComplete;
+
+		// Set by workers, then only accessed on the main thread
+		ci::Surface8uRef			mSurface;			//! Decoded pixels or nullptr if decoding failed
+		std::shared_ptr<ci::gl::TextureData>	mTextureData;	//! Compressed blocks of KTX and DDS files
+		bool						mIsTextureDataTopDown;	//! DDS files store rows from the top, KTX files from the bottom like OpenGL
+
+		// Main thread only
+		ci::gl::Texture2dRef		mTexture;			//! Allocated before the first chunk is uploaded
+		int32_t						mNumUploadedRows;
+	};
+
+	typedef std::shared_ptr<Request> RequestRef;
+
+	struct Stats {
+		size_t	numQueuedDecodes	= 0;	//! Requests waiting for a worker
+		size_t	numDecoding			= 0;	//! Requests that are currently decoded by workers
+		size_t	numQueuedUploads	= 0;	//! Decoded requests that are waiting for or in the middle of their upload
+		size_t	numLoaded			= 0;	//! Total number of completed requests
+		size_t	numFailed			= 0;	//! Total number of requests that couldn't be decoded
+		double	lastDecodeTime		= 0;	//! Seconds
+		double	averageDecodeTime	= 0;	//! Moving average in seconds
+		double	maxDecodeTime		= 0;	//! Seconds
+		size_t	numUploadedBytes	= 0;	//! Bytes uploaded during the last update
+	};
+
+	//! Shared instance that is updated by the BaseApp.
+	static ImageLoaderRef get();
+
+	ImageLoader();
+	~ImageLoader();
+
+	//! Restarts the worker pool with numThreads threads. Uses one thread less than the number of cores if numThreads is 0.
+	//! Pending decodes are kept. Workers are started with the default thread count on the first load if not called before.
+	void				setup(const int numThreads = 0);
+
+	//! Queues path for decoding. Relative paths are resolved as asset paths.
+	RequestRef			load(const ci::fs::path & path, CompletionFn callback, const float priority = 0,
+							 const ci::gl::Texture2d::Format & format = ci::gl::Texture2d::Format());
+
+	//! Queues path for decoding without uploading it. Use this to process or pack pixels before they're uploaded. KTX and DDS files can't be loaded as surfaces.
+	RequestRef			loadSurface(const ci::fs::path & path, SurfaceFn callback, const float priority = 0);
+
+	//! Queues an already decoded RGBA surface for a chunked upload. The surface must not be modified until the request completes.
+	RequestRef			upload(ci::Surface8uRef surface, CompletionFn callback, const float priority = 0,
+							   const ci::gl::Texture2d::Format & format = ci::gl::Texture2d::Format());
+
+	//! Uploads decoded images within the upload budget and calls completion functions of finished requests. Main thread only.
+	void				update();
+
+	//! Cancels all pending requests.
+	void				cancelAll();
+
+	//! Maximum number of bytes uploaded per update. Images are split into chunks of rows, but at least one row is uploaded per update. Defaults to 8MB.
+	//! Uploads are further limited to what UploadScheduler tasks have left of the frame's budget.
+	void				setUploadBudget(const size_t numBytes)	{ mUploadBudget = numBytes; }
+	size_t				getUploadBudget() const					{ return mUploadBudget; }
+
+	//! If enabled, images are loaded from KTX or DDS files with the same name next to them if those are at least as new
+	//! as the original (see tools/convert_textures.py). Doesn't apply to loadSurface(). Defaults to false.
+	void				setPreferCompressedTextures(const bool value)	{ mPreferCompressedTextures = value; }
+	bool				getPreferCompressedTextures() const			{ return mPreferCompressedTextures; }
+
+	Stats				getStats() const;
+	size_t				getNumThreads() const					{ return mThreads.size(); }
+
+	//! True if path has a .ktx or .dds extension.
+	static bool			isCompressedTextureFile(const ci::fs::path & path);
+
+protected:
+
+	void				queueDecode(RequestRef request);
+	void				startThreads(const int numThreads);
+	void				stopThreads();
+	void				runWorker();
+	void				decode(Request & request);
+
+	//! Returns an up to date KTX or DDS file next to path or an empty path.
+	ci::fs::path		findCompressedTexture(const ci::fs::path & path) const;
+
+	//! Removes and returns the pending request with the highest priority. Canceled requests are dropped. Call with mMutex locked.
+	RequestRef			popNextDecode();
+
+	//! Uploads up to maxBytes of request's rows. Returns the number of uploaded bytes.
+	size_t				uploadChunk(Request & request, const size_t maxBytes);
+
+	//! Uploads all levels of request's compressed texture data. Returns the number of uploaded bytes.
+	size_t				uploadCompressed(Request & request);
+	void				completeRequest(Request & request);
+
+	std::vector<std::thread>	mThreads;
+	bool						mIsStopping;
+
+	mutable std::mutex			mMutex;
+	std::condition_variable		mCondition;
+	std::vector<RequestRef>		mPendingDecodes;	//! Guarded by mMutex
+	std::vector<RequestRef>		mDecoded;			//! Guarded by mMutex, moved to mUploads on each update
+	Stats						mStats;				//! Guarded by mMutex
+
+	// Main thread only
+	std::vector<RequestRef>		mUploads;
+	ci::gl::PboRef				mPbo;
+	size_t						mUploadBudget;
+	std::atomic<bool>			mPreferCompressedTextures;
+};
+
+}
+}
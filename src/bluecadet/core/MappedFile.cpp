@@ -0,0 +1,147 @@
+#include "MappedFile.h"
+
+#include "cinder/Log.h"
+
+#if defined(CINDER_MSW)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+MappedFileRef MappedFile::open(const ci::fs::path & path) {
+	MappedFileRef file(new MappedFile(path));
+
+	if (!file->map()) {
+		return nullptr;
+	}
+
+	return file;
+}
+
+MappedFile::MappedFile(const ci::fs::path & path) :
+	mPath(path),
+	mData(nullptr),
+	mSize(0),
+#if defined(CINDER_MSW)
+	mFileHandle(INVALID_HANDLE_VALUE),
+	mMappingHandle(nullptr)
+#else
+	mFileDescriptor(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+	unmap();
+}
+
+#if defined(CINDER_MSW)
+
+bool MappedFile::map() {
+	mFileHandle = CreateFileW(mPath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+
+	if (mFileHandle == INVALID_HANDLE_VALUE) {
+		CI_LOG_E("Could not open '" << mPath << "' (error " << GetLastError() << ")");
+		return false;
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(mFileHandle, &size) || size.QuadPart == 0) {
+		CI_LOG_E("Could not map '" << mPath << "' since it's empty or its size can't be read");
+		unmap();
+		return false;
+	}
+
+	mMappingHandle = CreateFileMappingW(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!mMappingHandle) {
+		CI_LOG_E("Could not create file mapping for '" << mPath << "' (error " << GetLastError() << ")");
+		unmap();
+		return false;
+	}
+
+	mData = static_cast<const uint8_t *>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+	if (!mData) {
+		CI_LOG_E("Could not map view of '" << mPath << "' (error " << GetLastError() << ")");
+		unmap();
+		return false;
+	}
+
+	mSize = (size_t)size.QuadPart;
+	return true;
+}
+
+void MappedFile::unmap() {
+	if (mData) {
+		UnmapViewOfFile(mData);
+		mData = nullptr;
+	}
+	if (mMappingHandle) {
+		CloseHandle(mMappingHandle);
+		mMappingHandle = nullptr;
+	}
+	if (mFileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(mFileHandle);
+		mFileHandle = INVALID_HANDLE_VALUE;
+	}
+	mSize = 0;
+}
+
+#else
+
+bool MappedFile::map() {
+	mFileDescriptor = ::open(mPath.string().c_str(), O_RDONLY);
+
+	if (mFileDescriptor < 0) {
+		CI_LOG_E("Could not open '" << mPath << "'");
+		return false;
+	}
+
+	struct stat fileStats;
+
+	if (fstat(mFileDescriptor, &fileStats) != 0 || fileStats.st_size == 0) {
+		CI_LOG_E("Could not map '" << mPath << "' since it's empty or its size can't be read");
+		unmap();
+		return false;
+	}
+
+	void * data = mmap(nullptr, (size_t)fileStats.st_size, PROT_READ, MAP_SHARED, mFileDescriptor, 0);
+
+	if (data == MAP_FAILED) {
+		CI_LOG_E("Could not map '" << mPath << "'");
+		unmap();
+		return false;
+	}
+
+	mData = static_cast<const uint8_t *>(data);
+	mSize = (size_t)fileStats.st_size;
+	return true;
+}
+
+void MappedFile::unmap() {
+	if (mData) {
+		munmap(const_cast<uint8_t *>(mData), mSize);
+		mData = nullptr;
+	}
+	if (mFileDescriptor >= 0) {
+		close(mFileDescriptor);
+		mFileDescriptor = -1;
+	}
+	mSize = 0;
+}
+
+#endif
+
+}
+}
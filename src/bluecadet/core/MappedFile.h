@@ -0,0 +1,48 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <cstdint>
+
+namespace bluecadet {
+namespace core {
+
+typedef std::shared_ptr<class MappedFile> MappedFileRef;
+
+//! Read-only memory-mapped file. Pages are loaded lazily by the OS when they're accessed, so opening large files is cheap
+//! and multiple processes share the same physical memory. The mapping stays valid for the lifetime of this object.
+class MappedFile {
+
+public:
+
+	//! Maps the file at path into memory. Returns nullptr if the file can't be opened or mapped.
+	static MappedFileRef open(const ci::fs::path & path);
+
+	~MappedFile();
+
+	const uint8_t *			getData() const { return mData; }
+	size_t					getSize() const { return mSize; }
+	const ci::fs::path &	getPath() const { return mPath; }
+
+protected:
+
+	MappedFile(const ci::fs::path & path);
+
+	//! Opens and maps the file. Returns false if any step fails.
+	bool					map();
+	void					unmap();
+
+	ci::fs::path	mPath;
+	const uint8_t *	mData;
+	size_t			mSize;
+
+#if defined(CINDER_MSW)
+	void *			mFileHandle;
+	void *			mMappingHandle;
+#else
+	int				mFileDescriptor;
+#endif
+};
+
+}
+}
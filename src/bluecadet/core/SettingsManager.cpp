@@ -71,12 +71,39 @@ namespace bluecadet {
 			mapField("settings.touch.supportMultipleNativeTouchScreens", &mSupportMultipleNativeTouchScreens)
 				.commandArgs({ "supportMultipleNativeTouchScreens", "support_multiple_native_touch_screens" });;
 
+			// Views
+			mapField("settings.views.animationThrottling", &mAnimationThrottlingEnabled).commandArgs({ "animation_throttling", "animationThrottling" });
+
+			// Timing
+			mapField("settings.timing.fixedTimestep", &mFixedTimestep).commandArgs({ "fixed_timestep", "fixedTimestep" });
+			mapField("settings.timing.updateSubsteps", &mUpdateSubsteps).commandArgs({ "update_substeps", "updateSubsteps" });
+
+			// Images
+			mapField("settings.images.loaderThreads", &mImageLoaderThreads).commandArgs({ "image_loader_threads", "imageLoaderThreads" });
+			mapField("settings.images.uploadBudgetMb", &mImageUploadBudgetMb).commandArgs({ "image_upload_budget", "imageUploadBudget" });
+			mapField("settings.images.preferCompressed", &mPreferCompressedTextures).commandArgs({ "prefer_compressed_textures", "preferCompressedTextures" });
+			mapField("settings.images.textureCacheBudgetMb", &mTextureCacheBudgetMb).commandArgs({ "texture_cache_budget", "textureCacheBudget" });
+			mapField("settings.images.atlasEnabled", &mTextureAtlasEnabled).commandArgs({ "texture_atlas", "textureAtlas" });
+			mapField("settings.images.atlasMaxImageSize", &mTextureAtlasMaxImageSize).commandArgs({ "texture_atlas_max_size", "textureAtlasMaxSize" });
+			mapField("settings.images.diskCachePath", &mImageDiskCachePath).commandArgs({ "image_disk_cache", "imageDiskCache" });
+			mapField("settings.images.diskCacheBudgetMb", &mImageDiskCacheBudgetMb).commandArgs({ "image_disk_cache_budget", "imageDiskCacheBudget" });
+			mapField("settings.images.diskCacheVerify", &mImageDiskCacheVerify).commandArgs({ "image_disk_cache_verify", "imageDiskCacheVerify" });
+
+			// Assets
+			mapField("settings.assets.pack", &mAssetPack).commandArgs({ "asset_pack", "assetPack" });
+
+			// Uploads
+			mapField("settings.uploads.schedulingEnabled", &mUploadSchedulingEnabled).commandArgs({ "upload_scheduling", "uploadScheduling" });
+			mapField("settings.uploads.budgetMb", &mUploadBudgetMb).commandArgs({ "upload_budget", "uploadBudget" });
+			mapField("settings.uploads.budgetMs", &mUploadBudgetMs).commandArgs({ "upload_budget_ms", "uploadBudgetMs" });
+
 			// Debug
 			mapField("settings.debug.debugEnabled", &mDebugEnabled).commandArgs({ "debug" });
 			mapField("settings.debug.logToStdOut", &mLogToStdOut).commandArgs({ "logToStdOut", "log_to_std_out" });
 			mapField("settings.debug.showStats", &mShowStats).commandArgs({ "stats" });
 			mapField("settings.debug.showMinimap", &mShowMinimap).commandArgs({ "minimap" });
 			mapField("settings.debug.showTouches", &mShowTouches).commandArgs({ "show_touches", "showTouches" });
+			mapField("settings.debug.showTouchLatency", &mShowTouchLatency).commandArgs({ "touch_latency", "touchLatency" });
 			mapField("settings.debug.showScreenLayout", &mShowScreenLayout).commandArgs({ "show_layout", "showLayout" });
 			mapField("settings.debug.showCursor", &mShowCursor).commandArgs({ "cursor", "show_cursor", "showCursor" });
 			mapField("settings.debug.minimizeParams", &mMinimizeParams).commandArgs({ "minimize_params", "minimizeParams" });
@@ -133,10 +133,37 @@ namespace bluecadet {
 			bool mTuioTouchEnabled                  = false;  // TUIO touch events; It's recommended to disable native touch
 															  // when TUIO is enabled to prevent duplicate events.
 
+			// Views
+			bool mAnimationThrottlingEnabled = false;  // Advances animations of hidden, transparent and off-screen views at a reduced rate
+
+			// Timing
+			float mFixedTimestep = 0;  // Seconds per update step independent of wall time for deterministic, comparable runs. 0 uses wall time. Applied at setup.
+			int mUpdateSubsteps  = 1;  // Number of fixed update steps per rendered frame when mFixedTimestep is set
+
+			// Images
+			int mImageLoaderThreads    = 0;     // Number of threads that decode images loaded via ImageView::load(). 0 uses one less than the number of cores.
+			float mImageUploadBudgetMb = 8.0f;  // Maximum number of megabytes of decoded images uploaded to the GPU per frame
+			bool mPreferCompressedTextures = false; // Loads up to date KTX/DDS files next to images instead of decoding them (see tools/convert_textures.py)
+			float mTextureCacheBudgetMb = 0;    // Estimated GPU memory of cached textures before the least recently drawn ones are evicted. 0 releases unused textures immediately.
+			bool mTextureAtlasEnabled = false;  // Packs loaded images into shared atlas pages so that ImageViews can be drawn in batches
+			int mTextureAtlasMaxImageSize = 256; // Images with a larger width or height aren't packed
+			std::string mImageDiskCachePath = "";     // Directory of decoded images that are reused on later launches, relative to the app. Empty disables the cache.
+			float mImageDiskCacheBudgetMb = 4096.0f;  // Least recently used decoded images are removed beyond this size. 0 disables the limit.
+			bool mImageDiskCacheVerify = false;       // Verifies checksums of all pixels when loading cached images
+
+			// Assets
+			std::string mAssetPack = "";          // Pack that relative asset paths are loaded from before asset directories (see tools/pack_assets.py)
+
+			// Uploads
+			bool mUploadSchedulingEnabled = true; // Spreads text texture and fbo uploads across frames instead of creating them when they're first drawn
+			float mUploadBudgetMb = 16.0f;        // Maximum number of megabytes uploaded per frame, including images. 0 disables the limit.
+			float mUploadBudgetMs = 4.0f;         // Maximum number of milliseconds spent on uploads per frame, including images. 0 disables the limit.
+
 			// Debugging
 			bool mDebugEnabled               = true;   // Enable/disable all of the below debug features (except for hotkeys)
 			bool mLogToStdOut                = true;   // Logs to std::cout and std::cerr if enabled. Only works if mConsole is false.
 			bool mShowTouches                = false;  // Visualizes all current touch data
+			bool mShowTouchLatency           = false;  // Measures driver-to-screen touch latency and plots p50/p95/p99 in the stats graph
 			bool mShowScreenLayout           = false;  // Visualizes the current screen layout and bezels
 			bool mShowCursor                 = true;   // Show or hide the mouse cursor (toggle with C)
 			bool mShowMinimap                = true;   // Show or hide the mini-map (toggle with M)
@@ -0,0 +1,344 @@
+#include "TextureAtlas.h"
+
+#include "cinder/gl/Fbo.h"
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+// Each region is surrounded by one pixel of its extruded edge pixels
+static const int kPadding = 1;
+
+//==================================================
+// AtlasRegion
+//
+
+AtlasRegion::AtlasRegion(TextureAtlas * atlas, TextureAtlas::PageRef page, const ci::Area & area) :
+	mAtlas(atlas),
+	mPage(page),
+	mArea(area)
+{
+}
+
+AtlasRegion::~AtlasRegion() {
+	if (mAtlas) {
+		mAtlas->release(*this);
+	}
+}
+
+//==================================================
+// Lifecycle
+//
+
+TextureAtlasRef TextureAtlas::get() {
+	static auto instance = std::make_shared<TextureAtlas>();
+	return instance;
+}
+
+TextureAtlas::TextureAtlas() :
+	mIsEnabled(false),
+	mMaxImageSize(256),
+	mPageSize(2048),
+	mDefragmentationThreshold(0.25f),
+	mNumDefragmentations(0)
+{
+}
+
+TextureAtlas::~TextureAtlas() {
+	// regions can outlive the atlas when they're held by other shared instances
+	for (auto & page : mPages) {
+		for (auto region : page->regions) {
+			region->mAtlas = nullptr;
+		}
+	}
+}
+
+//==================================================
+// Packing
+//
+
+bool TextureAtlas::canInsert(const ci::ivec2 & size) const {
+	return mIsEnabled
+		&& size.x > 0 && size.y > 0
+		&& size.x <= mMaxImageSize && size.y <= mMaxImageSize
+		&& size.x + 2 * kPadding <= mPageSize && size.y + 2 * kPadding <= mPageSize;
+}
+
+AtlasRegionRef TextureAtlas::insert(const ci::Surface8u & surface) {
+	if (!canInsert(surface.getSize())) {
+		return nullptr;
+	}
+
+	const ivec2 imageSize = surface.getSize();
+	const ivec2 paddedSize = imageSize + ivec2(2 * kPadding);
+
+	PageRef page = nullptr;
+	ivec2 position;
+	size_t segmentIndex = 0;
+
+	for (auto & candidate : mPages) {
+		if (findPosition(*candidate, paddedSize, position, segmentIndex)) {
+			page = candidate;
+			break;
+		}
+	}
+
+	if (!page) {
+		page = createPage();
+
+		if (!findPosition(*page, paddedSize, position, segmentIndex)) {
+			CI_LOG_E("Could not pack image of size " << imageSize << " into an empty page");
+			mPages.pop_back();
+			return nullptr;
+		}
+	}
+
+	addSkylineLevel(*page, segmentIndex, position, paddedSize);
+
+	// copy the image with extruded edges into a tightly packed buffer
+	const size_t paddedRowBytes = paddedSize.x * 4;
+	vector<uint8_t> pixels(paddedRowBytes * paddedSize.y);
+	const uint8_t * source = surface.getData();
+	const size_t sourceRowBytes = surface.getRowBytes();
+	const uint8_t pixelInc = surface.getPixelInc();
+
+	for (int y = 0; y < paddedSize.y; ++y) {
+		const int sourceY = std::min(std::max(y - kPadding, 0), imageSize.y - 1);
+		const uint8_t * sourceRow = source + sourceY * sourceRowBytes;
+		uint8_t * row = pixels.data() + y * paddedRowBytes;
+
+		for (int x = 0; x < paddedSize.x; ++x) {
+			const int sourceX = std::min(std::max(x - kPadding, 0), imageSize.x - 1);
+			memcpy(row + x * 4, sourceRow + sourceX * pixelInc, 4);
+		}
+	}
+
+	{
+		gl::ScopedTextureBind scopedTexture(page->texture);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(page->texture->getTarget(), 0, position.x, position.y, paddedSize.x, paddedSize.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	const Area area(position + ivec2(kPadding), position + ivec2(kPadding) + imageSize);
+	AtlasRegionRef region(new AtlasRegion(this, page, area));
+
+	page->regions.push_back(region.get());
+	page->numUsedPixels += paddedSize.x * paddedSize.y;
+	page->numAllocatedPixels += paddedSize.x * paddedSize.y;
+
+	return region;
+}
+
+TextureAtlas::PageRef TextureAtlas::createPage() {
+	PageRef page = make_shared<Page>();
+	page->size = mPageSize;
+	page->texture = createPageTexture(page->size);
+	page->skyline.push_back(ivec3(0, 0, page->size));
+	mPages.push_back(page);
+	return page;
+}
+
+ci::gl::Texture2dRef TextureAtlas::createPageTexture(const int size) const {
+	auto format = gl::Texture2d::Format().internalFormat(GL_RGBA8).minFilter(GL_LINEAR).magFilter(GL_LINEAR).wrap(GL_CLAMP_TO_EDGE);
+	auto texture = gl::Texture2d::create(size, size, format);
+	// regions are uploaded top to bottom
+	texture->setTopDown(true);
+	return texture;
+}
+
+bool TextureAtlas::findPosition(const Page & page, const ci::ivec2 & size, ci::ivec2 & position, size_t & segmentIndex) const {
+	int bestBottom = numeric_limits<int>::max();
+	int bestWidth = numeric_limits<int>::max();
+	bool hasFound = false;
+
+	for (size_t i = 0; i < page.skyline.size(); ++i) {
+		const int y = fitSegment(page, i, size);
+
+		if (y < 0) {
+			continue;
+		}
+
+		// bottom-left: prefer the lowest resulting top edge, then the narrowest segment
+		const int bottom = y + size.y;
+		const int width = page.skyline[i].z;
+
+		if (bottom < bestBottom || (bottom == bestBottom && width < bestWidth)) {
+			bestBottom = bottom;
+			bestWidth = width;
+			position = ivec2(page.skyline[i].x, y);
+			segmentIndex = i;
+			hasFound = true;
+		}
+	}
+
+	return hasFound;
+}
+
+int TextureAtlas::fitSegment(const Page & page, const size_t segmentIndex, const ci::ivec2 & size) const {
+	const int x = page.skyline[segmentIndex].x;
+
+	if (x + size.x > page.size) {
+		return -1;
+	}
+
+	int y = page.skyline[segmentIndex].y;
+	int remainingWidth = size.x;
+
+	for (size_t i = segmentIndex; remainingWidth > 0 && i < page.skyline.size(); ++i) {
+		y = std::max(y, page.skyline[i].y);
+
+		if (y + size.y > page.size) {
+			return -1;
+		}
+
+		remainingWidth -= page.skyline[i].z;
+	}
+
+	return y;
+}
+
+void TextureAtlas::addSkylineLevel(Page & page, const size_t segmentIndex, const ci::ivec2 & position, const ci::ivec2 & size) {
+	auto & skyline = page.skyline;
+	skyline.insert(skyline.begin() + segmentIndex, ivec3(position.x, position.y + size.y, size.x));
+
+	// shrink or remove the segments covered by the new one
+	for (size_t i = segmentIndex + 1; i < skyline.size(); ++i) {
+		const ivec3 & previous = skyline[i - 1];
+		const int previousEnd = previous.x + previous.z;
+
+		if (skyline[i].x >= previousEnd) {
+			break;
+		}
+
+		const int overlap = previousEnd - skyline[i].x;
+		skyline[i].x += overlap;
+		skyline[i].z -= overlap;
+
+		if (skyline[i].z > 0) {
+			break;
+		}
+
+		skyline.erase(skyline.begin() + i);
+		--i;
+	}
+
+	// merge neighbors at the same height
+	for (size_t i = 0; i + 1 < skyline.size(); ++i) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].z += skyline[i + 1].z;
+			skyline.erase(skyline.begin() + i + 1);
+			--i;
+		}
+	}
+}
+
+//==================================================
+// Releasing and defragmentation
+//
+
+void TextureAtlas::release(AtlasRegion & region) {
+	Page & page = *region.mPage;
+	const ivec2 paddedSize = region.mArea.getSize() + ivec2(2 * kPadding);
+
+	page.regions.erase(remove(page.regions.begin(), page.regions.end(), &region), page.regions.end());
+	page.numUsedPixels -= paddedSize.x * paddedSize.y;
+
+	if (page.regions.empty()) {
+		mPages.erase(remove(mPages.begin(), mPages.end(), region.mPage), mPages.end());
+		return;
+	}
+
+	const size_t numPagePixels = (size_t)page.size * (size_t)page.size;
+	const size_t numReleasedPixels = page.numAllocatedPixels - page.numUsedPixels;
+
+	if ((float)numReleasedPixels > mDefragmentationThreshold * (float)numPagePixels) {
+		defragment(page);
+	}
+}
+
+bool TextureAtlas::defragment(Page & page) {
+	const int pageSize = page.size;
+
+	// pack tallest regions first for a tighter skyline
+	vector<AtlasRegion *> regions = page.regions;
+	sort(regions.begin(), regions.end(), [](const AtlasRegion * a, const AtlasRegion * b) {
+		return a->mArea.getHeight() > b->mArea.getHeight();
+	});
+
+	Page packed;
+	packed.size = pageSize;
+	packed.skyline.push_back(ivec3(0, 0, pageSize));
+
+	vector<Area> areas;
+	areas.reserve(regions.size());
+
+	for (auto region : regions) {
+		const ivec2 paddedSize = region->mArea.getSize() + ivec2(2 * kPadding);
+		ivec2 position;
+		size_t segmentIndex = 0;
+
+		if (!findPosition(packed, paddedSize, position, segmentIndex)) {
+			CI_LOG_W("Could not defragment atlas page");
+			return false;
+		}
+
+		addSkylineLevel(packed, segmentIndex, position, paddedSize);
+		areas.push_back(Area(position + ivec2(kPadding), position + ivec2(kPadding) + region->mArea.getSize()));
+	}
+
+	// copy all regions including their padding on the gpu
+	packed.texture = createPageTexture(pageSize);
+
+	{
+		auto sourceFbo = gl::Fbo::create(pageSize, pageSize, gl::Fbo::Format().attachment(GL_COLOR_ATTACHMENT0, page.texture).disableDepth());
+		auto targetFbo = gl::Fbo::create(pageSize, pageSize, gl::Fbo::Format().attachment(GL_COLOR_ATTACHMENT0, packed.texture).disableDepth());
+
+		for (size_t i = 0; i < regions.size(); ++i) {
+			const ivec2 padding(kPadding);
+			const Area sourceArea(regions[i]->mArea.getUL() - padding, regions[i]->mArea.getLR() + padding);
+			const Area targetArea(areas[i].getUL() - padding, areas[i].getLR() + padding);
+			sourceFbo->blitTo(targetFbo, sourceArea, targetArea);
+		}
+	}
+
+	page.texture = packed.texture;
+	page.skyline = packed.skyline;
+	page.numAllocatedPixels = page.numUsedPixels;
+
+	for (size_t i = 0; i < regions.size(); ++i) {
+		regions[i]->mArea = areas[i];
+	}
+
+	mNumDefragmentations++;
+
+	for (auto region : regions) {
+		region->mSignalMoved.emit();
+	}
+
+	return true;
+}
+
+TextureAtlas::Stats TextureAtlas::getStats() const {
+	Stats stats;
+	stats.numPages = mPages.size();
+	stats.numDefragmentations = mNumDefragmentations;
+
+	for (const auto & page : mPages) {
+		stats.numRegions += page->regions.size();
+		stats.numUsedPixels += page->numUsedPixels;
+		stats.numPagePixels += (size_t)page->size * (size_t)page->size;
+	}
+
+	return stats;
+}
+
+}
+}
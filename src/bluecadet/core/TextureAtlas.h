@@ -0,0 +1,138 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Texture.h"
+#include "cinder/Signals.h"
+#include "cinder/Surface.h"
+
+#include <memory>
+#include <vector>
+
+namespace bluecadet {
+namespace core {
+
+typedef std::shared_ptr<class TextureAtlas> TextureAtlasRef;
+typedef std::shared_ptr<class AtlasRegion> AtlasRegionRef;
+
+//! Packs small images into shared texture pages so that views displaying them can be drawn in batches with a
+//! single texture bind (see SpriteBatch). Images are placed with a skyline bottom-left packer and their edge pixels
+//! are extruded by one pixel to avoid bleeding when filtered.
+//!
+//! Areas of released regions can't be reused by the skyline directly. Once the freed area of a page exceeds the
+//! defragmentation threshold, the page's remaining regions are repacked into a new page texture on the GPU and
+//! their owners are notified via AtlasRegion::getSignalMoved(). Empty pages are deleted. Main thread only.
+class TextureAtlas {
+
+public:
+	struct Stats {
+		size_t	numPages				= 0;
+		size_t	numRegions				= 0;
+		size_t	numUsedPixels			= 0;	//! Pixels of all live regions including padding
+		size_t	numPagePixels			= 0;	//! Pixels of all pages
+		size_t	numDefragmentations		= 0;	//! Total number of repacked pages
+	};
+
+	//! Shared instance used by the TextureCache.
+	static TextureAtlasRef get();
+
+	TextureAtlas();
+	~TextureAtlas();
+
+	//! Packing is disabled by default. Changing this only affects images loaded afterwards.
+	void				setEnabled(const bool value)			{ mIsEnabled = value; }
+	bool				isEnabled() const						{ return mIsEnabled; }
+
+	//! Images with a width or height above this size aren't packed. Defaults to 256.
+	void				setMaxImageSize(const int value)		{ mMaxImageSize = value; }
+	int					getMaxImageSize() const					{ return mMaxImageSize; }
+
+	//! Width and height of new pages. Defaults to 2048.
+	void				setPageSize(const int value)			{ mPageSize = value; }
+	int					getPageSize() const						{ return mPageSize; }
+
+	//! Fraction of a page's area that has been released before the page is repacked. Defaults to 0.25.
+	void				setDefragmentationThreshold(const float value)	{ mDefragmentationThreshold = value; }
+	float				getDefragmentationThreshold() const				{ return mDefragmentationThreshold; }
+
+	//! True if packing is enabled and an image of size can be packed.
+	bool				canInsert(const ci::ivec2 & size) const;
+
+	//! Packs and uploads an RGBA surface. Returns nullptr if the surface can't be packed. The region is released
+	//! when its last reference is destroyed.
+	AtlasRegionRef		insert(const ci::Surface8u & surface);
+
+	Stats				getStats() const;
+
+protected:
+	friend class AtlasRegion;
+
+	struct Page {
+		ci::gl::Texture2dRef		texture;
+		int							size = 0;				//! Width and height in pixels
+		std::vector<ci::ivec3>		skyline;				//! Segments of x, y and width from left to right
+		std::vector<AtlasRegion *>	regions;
+		size_t						numUsedPixels = 0;		//! Pixels of live regions
+		size_t						numAllocatedPixels = 0;	//! Pixels allocated since the page has been packed, including released regions
+	};
+
+	typedef std::shared_ptr<Page> PageRef;
+
+	PageRef				createPage();
+	ci::gl::Texture2dRef	createPageTexture(const int size) const;
+
+	//! Finds the lowest position for a rect of size on page's skyline. Returns false if it doesn't fit.
+	bool				findPosition(const Page & page, const ci::ivec2 & size, ci::ivec2 & position, size_t & segmentIndex) const;
+
+	//! Returns the y position of a rect of width placed at the segment or -1 if it doesn't fit.
+	int					fitSegment(const Page & page, const size_t segmentIndex, const ci::ivec2 & size) const;
+
+	void				addSkylineLevel(Page & page, const size_t segmentIndex, const ci::ivec2 & position, const ci::ivec2 & size);
+
+	void				release(AtlasRegion & region);
+
+	//! Repacks all regions of page into a new page texture. Returns false if the regions couldn't be repacked.
+	bool				defragment(Page & page);
+
+	std::vector<PageRef>	mPages;
+
+	bool				mIsEnabled;
+	int					mMaxImageSize;
+	int					mPageSize;
+	float				mDefragmentationThreshold;
+	size_t				mNumDefragmentations;
+};
+
+//! Area of a TextureAtlas page that holds a single image. The area is released when the region is destroyed.
+class AtlasRegion {
+
+public:
+	typedef ci::signals::Signal<void()> MovedSignal;
+
+	~AtlasRegion();
+
+	//! The texture of the page that contains this region. Changes when the page is defragmented.
+	const ci::gl::Texture2dRef &	getTexture() const	{ return mPage->texture; }
+
+	//! Area of the image in page pixels, excluding padding. Changes when the page is defragmented.
+	const ci::Area &		getArea() const				{ return mArea; }
+
+	//! Normalized texture coordinates of getArea().
+	ci::Rectf				getTexCoords() const		{ return mPage->texture->getAreaTexCoords(mArea); }
+
+	//! Emitted after the region has been moved to a new page texture.
+	MovedSignal &			getSignalMoved()			{ return mSignalMoved; }
+
+protected:
+	friend class TextureAtlas;
+
+	AtlasRegion(TextureAtlas * atlas, TextureAtlas::PageRef page, const ci::Area & area);
+
+	TextureAtlas *			mAtlas;	//! nullptr once the atlas has been destroyed
+	TextureAtlas::PageRef	mPage;	//! Keeps the page texture alive until all regions are released
+	ci::Area				mArea;
+	MovedSignal				mSignalMoved;
+};
+
+}
+}
@@ -0,0 +1,341 @@
+#include "TextureCache.h"
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+//==================================================
+// CachedTexture
+//
+
+CachedTexture::CachedTexture(TextureCache * cache, const ci::fs::path & path, const ci::gl::Texture2d::Format & format, const float priority) :
+	mCache(cache),
+	mPath(path),
+	mFormat(format),
+	mTexture(nullptr),
+	mArea(0, 0, 0, 0),
+	mRegion(nullptr),
+	mRequest(nullptr),
+	mPriority(priority),
+	mNumBytes(0),
+	mSize(0),
+	mLastDrawnFrame(0),
+	mHasFailed(false)
+{
+}
+
+CachedTexture::~CachedTexture() {
+	if (mRequest) {
+		mRequest->cancel();
+	}
+}
+
+void CachedTexture::markDrawn() {
+	mLastDrawnFrame = mCache->mFrameId;
+
+	if (!mTexture && !mRequest && !mHasFailed) {
+		load();
+	}
+}
+
+void CachedTexture::setPriority(const float priority) {
+	mPriority = priority;
+
+	if (mRequest) {
+		mRequest->setPriority(priority);
+	}
+}
+
+void CachedTexture::load() {
+	// the request is canceled when this handle is destroyed, so its callback never outlives it
+	if (canUseAtlas()) {
+		// the image size is only known after decoding, so decide whether to pack it once the surface is ready
+		mRequest = ImageLoader::get()->loadSurface(mPath, [this](Surface8uRef surface) {
+			handleDecoded(surface);
+		}, mPriority);
+		return;
+	}
+
+	mRequest = ImageLoader::get()->load(mPath, [this](gl::Texture2dRef texture) {
+		handleLoaded(texture);
+	}, mPriority, mFormat);
+}
+
+bool CachedTexture::canUseAtlas() const {
+	// atlas pages have no mip levels and neighboring images would repeat into each other
+	return TextureAtlas::get()->isEnabled()
+		&& !ImageLoader::isCompressedTextureFile(mPath)
+		&& !mFormat.hasMipmapping()
+		&& mFormat.getWrapS() == GL_CLAMP_TO_EDGE
+		&& mFormat.getWrapT() == GL_CLAMP_TO_EDGE;
+}
+
+void CachedTexture::evict() {
+	if (mRequest) {
+		mRequest->cancel();
+		mRequest = nullptr;
+	}
+
+	if (!mTexture) {
+		return;
+	}
+
+	mCache->handleEvicted(*this);
+	mTexture = nullptr;
+	mRegionMovedConnection.disconnect();
+	mRegion = nullptr;
+	mNumBytes = 0;
+	mSignalTextureChanged.emit(nullptr);
+}
+
+void CachedTexture::handleLoaded(ci::gl::Texture2dRef texture) {
+	mRequest = nullptr;
+
+	if (!texture) {
+		mHasFailed = true;
+		return;
+	}
+
+	mTexture = texture;
+	mSize = texture->getSize();
+	mArea = texture->getBounds();
+	mNumBytes = TextureCache::estimateNumBytes(texture);
+	mCache->handleResident(*this);
+	mSignalTextureChanged.emit(mTexture);
+}
+
+void CachedTexture::handleDecoded(ci::Surface8uRef surface) {
+	mRequest = nullptr;
+
+	if (!surface) {
+		mHasFailed = true;
+		return;
+	}
+
+	mRegion = TextureAtlas::get()->insert(*surface);
+
+	if (!mRegion) {
+		// too large to be packed
+		mRequest = ImageLoader::get()->upload(surface, [this](gl::Texture2dRef texture) {
+			handleLoaded(texture);
+		}, mPriority, mFormat);
+		return;
+	}
+
+	mRegionMovedConnection = mRegion->getSignalMoved().connect([this] {
+		handleRegionMoved();
+	});
+
+	// the page is shared, so only the region counts towards the budget. Its pixels are freed once the page is defragmented.
+	mTexture = mRegion->getTexture();
+	mArea = mRegion->getArea();
+	mSize = surface->getSize();
+	mNumBytes = TextureCache::estimateNumBytes(mSize, mFormat);
+	mCache->handleResident(*this);
+	mSignalTextureChanged.emit(mTexture);
+}
+
+void CachedTexture::handleRegionMoved() {
+	mTexture = mRegion->getTexture();
+	mArea = mRegion->getArea();
+	mSignalTextureChanged.emit(mTexture);
+}
+
+//==================================================
+// Lifecycle
+//
+
+TextureCacheRef TextureCache::get() {
+	static auto instance = std::make_shared<TextureCache>();
+	return instance;
+}
+
+TextureCache::TextureCache() :
+	mBudget(0),
+	mNumResidentBytes(0),
+	mFrameId(1),
+	mHasWarnedOverBudget(false)
+{
+}
+
+TextureCache::~TextureCache() {
+}
+
+//==================================================
+// Loading
+//
+
+CachedTextureRef TextureCache::load(const ci::fs::path & path, const ci::gl::Texture2d::Format & format, const float priority) {
+	const string key = getKey(path, format);
+	auto it = mTextures.find(key);
+
+	if (it != mTextures.end()) {
+		mStats.numHits++;
+		CachedTextureRef texture = it->second;
+
+		if (priority > texture->getPriority()) {
+			texture->setPriority(priority);
+		}
+		if (!texture->isResident() && !texture->isLoading()) {
+			texture->mHasFailed = false;
+			texture->load();
+		}
+
+		return texture;
+	}
+
+	mStats.numMisses++;
+
+	CachedTextureRef texture(new CachedTexture(this, path, format, priority));
+	mTextures[key] = texture;
+	texture->load();
+	return texture;
+}
+
+std::string TextureCache::getKey(const ci::fs::path & path, const ci::gl::Texture2d::Format & format) {
+	stringstream key;
+	key << path.generic_string() << "|" << format.getInternalFormat() << "|" << format.hasMipmapping()
+		<< "|" << format.getMinFilter() << "|" << format.getMagFilter()
+		<< "|" << format.getWrapS() << "|" << format.getWrapT();
+	return key.str();
+}
+
+size_t TextureCache::estimateNumBytes(const ci::ivec2 & size, const ci::gl::Texture2d::Format & format) {
+	// all textures are uploaded as RGBA8 by the ImageLoader; a full mip chain adds a third
+	const size_t numBytes = (size_t)size.x * (size_t)size.y * 4;
+	return format.hasMipmapping() ? numBytes + numBytes / 3 : numBytes;
+}
+
+size_t TextureCache::estimateNumBytes(const ci::gl::Texture2dRef & texture) {
+	size_t numBitsPerPixel = 32;
+
+	switch (texture->getInternalFormat()) {
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+			numBitsPerPixel = 4;
+			break;
+		case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+		case GL_COMPRESSED_RGBA_BPTC_UNORM:
+		case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+			numBitsPerPixel = 8;
+			break;
+	}
+
+	const size_t numBytes = (size_t)texture->getWidth() * (size_t)texture->getHeight() * numBitsPerPixel / 8;
+	return texture->hasMipmapping() ? numBytes + numBytes / 3 : numBytes;
+}
+
+//==================================================
+// Eviction
+//
+
+void TextureCache::update() {
+	// handles only referenced by the cache aren't used by anyone; cancel their loads since nobody is waiting for them.
+	// without a budget nothing else evicts them, so resident ones are released right away as well.
+	for (auto it = mTextures.begin(); it != mTextures.end();) {
+		if (it->second.use_count() == 1 && (it->second->isLoading() || mBudget == 0)) {
+			it->second->evict();
+			it = mTextures.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	if (mBudget > 0 && mNumResidentBytes > mBudget) {
+		evictOverBudget();
+	}
+
+	mFrameId++;
+}
+
+TextureCache::Stats TextureCache::getStats() const {
+	Stats stats = mStats;
+	stats.numTextures = mTextures.size();
+	stats.numResidentBytes = mNumResidentBytes;
+	return stats;
+}
+
+void TextureCache::evictOverBudget() {
+	// candidates hold a second reference, so unused textures have a use count of 2
+	vector<CachedTextureRef> candidates;
+
+	for (const auto & it : mTextures) {
+		// never evict what's currently on screen
+		if (it.second->isResident() && it.second->mLastDrawnFrame < mFrameId) {
+			candidates.push_back(it.second);
+		}
+	}
+
+	// unused first, then least recently drawn
+	sort(candidates.begin(), candidates.end(), [](const CachedTextureRef & a, const CachedTextureRef & b) {
+		const bool aIsUnused = a.use_count() == 2;
+		const bool bIsUnused = b.use_count() == 2;
+		if (aIsUnused != bIsUnused) {
+			return aIsUnused;
+		}
+		return a->mLastDrawnFrame < b->mLastDrawnFrame;
+	});
+
+	for (const auto & texture : candidates) {
+		if (mNumResidentBytes <= mBudget) {
+			break;
+		}
+
+		const bool isUnused = texture.use_count() == 2;
+		texture->evict();
+
+		if (isUnused) {
+			mTextures.erase(getKey(texture->getPath(), texture->mFormat));
+		}
+	}
+
+	if (mNumResidentBytes > mBudget) {
+		if (!mHasWarnedOverBudget) {
+			CI_LOG_W("Textures drawn in a single frame exceed the texture cache budget (" << mNumResidentBytes << " of " << mBudget << " bytes)");
+			mHasWarnedOverBudget = true;
+		}
+	} else {
+		mHasWarnedOverBudget = false;
+	}
+}
+
+void TextureCache::purgeUnused() {
+	for (auto it = mTextures.begin(); it != mTextures.end();) {
+		if (it->second.use_count() == 1) {
+			it->second->evict();
+			it = mTextures.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void TextureCache::clear() {
+	for (auto & it : mTextures) {
+		it.second->evict();
+	}
+	purgeUnused();
+}
+
+void TextureCache::handleResident(CachedTexture & texture) {
+	mNumResidentBytes += texture.mNumBytes;
+	mStats.numResident++;
+}
+
+void TextureCache::handleEvicted(CachedTexture & texture) {
+	mNumResidentBytes -= texture.mNumBytes;
+	mStats.numResident--;
+	mStats.numEvictions++;
+}
+
+}
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Texture.h"
+#include "cinder/Signals.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ImageLoader.h"
+#include "TextureAtlas.h"
+
+namespace bluecadet {
+namespace core {
+
+typedef std::shared_ptr<class TextureCache> TextureCacheRef;
+typedef std::shared_ptr<class CachedTexture> CachedTextureRef;
+
+//! Shared handle to a texture in the TextureCache. All users of the same path and format share one handle.
+//! The texture is loaded asynchronously via the ImageLoader and can be evicted by the cache at any time
+//! when it's over budget. Call markDrawn() whenever the texture is drawn to keep it resident and to reload
+//! it after it has been evicted. Listen to getSignalTextureChanged() to be notified of both.
+//!
+//! Small images are packed into a shared TextureAtlas page if the atlas is enabled and the format doesn't use mipmaps
+//! or repeating wraps. GPU-compressed KTX and DDS files are never packed. In that case getTexture() returns the page texture and getArea() the image's area within it.
+class CachedTexture {
+
+public:
+	typedef ci::signals::Signal<void(ci::gl::Texture2dRef texture)> TextureChangedSignal;
+
+	~CachedTexture();
+
+	//! The resident texture or nullptr while loading, after eviction or if loading failed.
+	//! Don't hold on to the returned reference, otherwise its memory can't be released on eviction.
+	const ci::gl::Texture2dRef &	getTexture() const		{ return mTexture; }
+
+	bool					isResident() const				{ return mTexture != nullptr; }
+	bool					isLoading() const				{ return mRequest != nullptr; }
+	bool					hasFailed() const				{ return mHasFailed; }
+
+	//! Area of the image within getTexture() in texture pixels. Covers the entire texture unless the image is atlased.
+	//! Changes along with the texture when the atlas page is defragmented.
+	const ci::Area &		getArea() const					{ return mArea; }
+
+	//! True if the resident texture is a shared TextureAtlas page.
+	bool					isAtlased() const				{ return mRegion != nullptr; }
+
+	//! Keeps this texture from being evicted during the next cache update. Reloads the texture if it's been evicted.
+	void					markDrawn();
+
+	//! Sets the priority of the current and future load requests.
+	void					setPriority(const float priority);
+	float					getPriority() const				{ return mPriority; }
+
+	//! Estimated GPU memory of the resident texture in bytes, including mip levels.
+	size_t					getNumBytes() const				{ return mNumBytes; }
+
+	//! Size of the image. Known after the first load and kept after eviction.
+	const ci::ivec2 &		getSize() const					{ return mSize; }
+
+	const ci::fs::path &	getPath() const					{ return mPath; }
+
+	//! Emitted with the new texture once it's resident, when it has been moved to another atlas page and with nullptr when it's evicted.
+	TextureChangedSignal &	getSignalTextureChanged()		{ return mSignalTextureChanged; }
+
+protected:
+	friend class TextureCache;
+
+	CachedTexture(TextureCache * cache, const ci::fs::path & path, const ci::gl::Texture2d::Format & format, const float priority);
+
+	void					load();
+	void					evict();
+	void					handleLoaded(ci::gl::Texture2dRef texture);
+	void					handleDecoded(ci::Surface8uRef surface);
+	void					handleRegionMoved();
+
+	bool					canUseAtlas() const;
+
+	TextureCache *				mCache;
+	const ci::fs::path			mPath;
+	const ci::gl::Texture2d::Format	mFormat;
+
+	ci::gl::Texture2dRef		mTexture;
+	ci::Area					mArea;
+	AtlasRegionRef				mRegion;
+	ci::signals::ScopedConnection	mRegionMovedConnection;
+	ImageLoader::RequestRef		mRequest;
+	float						mPriority;
+	size_t						mNumBytes;
+	ci::ivec2					mSize;
+	uint64_t					mLastDrawnFrame;
+	bool						mHasFailed;
+
+	TextureChangedSignal		mSignalTextureChanged;
+};
+
+//! Process-wide cache of textures keyed by path and texture format. Handles are reference counted, so the same
+//! image is only loaded and uploaded once no matter how many views display it.
+//!
+//! Once the resident bytes exceed the budget, textures that aren't used by any handle are evicted first, followed
+//! by the least recently drawn ones. Textures that have been drawn since the last update are never evicted, so
+//! the budget can be exceeded temporarily by what's on screen. Evicted textures keep their handle and are reloaded
+//! the next time they're drawn. The BaseApp updates the shared instance once per frame.
+class TextureCache {
+
+public:
+	struct Stats {
+		size_t	numTextures			= 0;	//! All cached handles
+		size_t	numResident			= 0;	//! Handles with a resident texture
+		size_t	numResidentBytes	= 0;
+		size_t	numEvictions		= 0;	//! Total number of evicted textures
+		size_t	numHits				= 0;	//! Total number of load() calls that returned an existing handle
+		size_t	numMisses			= 0;	//! Total number of load() calls that created a new handle
+	};
+
+	//! Shared instance that is updated by the BaseApp.
+	static TextureCacheRef get();
+
+	TextureCache();
+	~TextureCache();
+
+	//! Returns the shared handle for path and format and starts loading it if it isn't resident yet.
+	//! Relative paths are resolved as asset paths by the ImageLoader.
+	CachedTextureRef		load(const ci::fs::path & path, const ci::gl::Texture2d::Format & format = ci::gl::Texture2d::Format(), const float priority = 0);
+
+	//! Enforces the budget and cancels loads that aren't used anymore. Main thread only.
+	void					update();
+
+	//! Evicts and removes all textures that aren't used by any handle.
+	void					purgeUnused();
+
+	//! Evicts all textures and removes all handles that aren't used. Used handles are reloaded when they're drawn again.
+	void					clear();
+
+	//! Maximum number of resident bytes before textures are evicted. Unused textures are kept resident within the budget so that
+	//! they can be reused without reloading. 0 releases textures as soon as no handle uses them and never evicts used ones. Defaults to 0.
+	void					setBudget(const size_t numBytes)	{ mBudget = numBytes; }
+	size_t					getBudget() const					{ return mBudget; }
+
+	size_t					getNumResidentBytes() const			{ return mNumResidentBytes; }
+	Stats					getStats() const;
+	uint64_t				getFrameId() const					{ return mFrameId; }
+
+	//! Estimated GPU memory of a texture of size with format, including mip levels.
+	static size_t			estimateNumBytes(const ci::ivec2 & size, const ci::gl::Texture2d::Format & format);
+
+	//! Estimated GPU memory of texture, including mip levels. Takes BC1, BC2, BC3 and BC7 compression into account.
+	static size_t			estimateNumBytes(const ci::gl::Texture2dRef & texture);
+
+protected:
+	friend class CachedTexture;
+
+	static std::string		getKey(const ci::fs::path & path, const ci::gl::Texture2d::Format & format);
+
+	void					handleResident(CachedTexture & texture);
+	void					handleEvicted(CachedTexture & texture);
+
+	void					evictOverBudget();
+
+	std::unordered_map<std::string, CachedTextureRef>	mTextures;
+
+	size_t					mBudget;
+	size_t					mNumResidentBytes;
+	uint64_t				mFrameId;
+	bool					mHasWarnedOverBudget;
+	Stats					mStats;
+};
+
+}
+}
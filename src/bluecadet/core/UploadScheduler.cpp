@@ -0,0 +1,164 @@
+#include "UploadScheduler.h"
+
+#include "cinder/Timer.h"
+
+#include <algorithm>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace core {
+
+//==================================================
+// Task
+//
+
+UploadScheduler::Task::Task(UploadFn uploadFn, const size_t numBytes, const float priority) :
+	mUploadFn(uploadFn),
+	mNumBytes(numBytes),
+	mPriority(priority),
+	mIsCanceled(false),
+	mIsComplete(false)
+{
+}
+
+//==================================================
+// Lifecycle
+//
+
+UploadSchedulerRef UploadScheduler::get() {
+	static auto instance = std::make_shared<UploadScheduler>();
+	return instance;
+}
+
+UploadScheduler::UploadScheduler() :
+	mIsEnabled(true),
+	mByteBudget(16 * 1024 * 1024),
+	mTimeBudget(0.004),
+	mNumFrameBytes(0),
+	mFrameTime(0),
+	mNumCompleted(0)
+{
+}
+
+UploadScheduler::~UploadScheduler() {
+}
+
+//==================================================
+// Scheduling
+//
+
+UploadScheduler::TaskRef UploadScheduler::schedule(UploadFn uploadFn, const size_t numBytes, const float priority) {
+	TaskRef task(new Task(uploadFn, numBytes, priority));
+
+	if (!mIsEnabled) {
+		run(*task);
+		return task;
+	}
+
+	mTasks.push_back(task);
+	return task;
+}
+
+void UploadScheduler::update() {
+	mNumFrameBytes = 0;
+	mFrameTime = 0;
+
+	mTasks.erase(remove_if(mTasks.begin(), mTasks.end(), [](const TaskRef & task) {
+		return task->isCanceled();
+	}), mTasks.end());
+
+	if (mTasks.empty()) {
+		return;
+	}
+
+	stable_sort(mTasks.begin(), mTasks.end(), [](const TaskRef & a, const TaskRef & b) {
+		return a->getPriority() > b->getPriority();
+	});
+
+	// tasks can schedule or cancel other tasks while they're run
+	vector<TaskRef> tasks;
+	tasks.swap(mTasks);
+
+	size_t numRun = 0;
+	auto it = tasks.begin();
+
+	for (; it != tasks.end(); ++it) {
+		Task & task = **it;
+
+		if (task.isCanceled()) {
+			continue;
+		}
+
+		if (numRun > 0 && !hasBudget(task.mNumBytes)) {
+			break;
+		}
+
+		run(task);
+		numRun++;
+	}
+
+	// remaining tasks stay ahead of the ones that have been scheduled in the meantime
+	mTasks.insert(mTasks.begin(), it, tasks.end());
+}
+
+void UploadScheduler::run(Task & task) {
+	// move the function out so that its captures are released once it's done
+	UploadFn uploadFn = std::move(task.mUploadFn);
+	task.mUploadFn = nullptr;
+	task.mIsComplete = true;
+
+	Timer timer(true);
+
+	if (uploadFn) {
+		uploadFn();
+	}
+
+	addUploadedBytes(task.mNumBytes, timer.getSeconds());
+	mNumCompleted++;
+}
+
+//==================================================
+// Budget
+//
+
+bool UploadScheduler::hasBudget(const size_t numBytes) const {
+	const bool hasBytes = mByteBudget == 0 || mNumFrameBytes + numBytes <= mByteBudget;
+	const bool hasTime = mTimeBudget <= 0 || mFrameTime < mTimeBudget;
+	return hasBytes && hasTime;
+}
+
+size_t UploadScheduler::getRemainingBytes() const {
+	if (!mIsEnabled) {
+		return numeric_limits<size_t>::max();
+	}
+
+	if (mTimeBudget > 0 && mFrameTime >= mTimeBudget) {
+		return 0;
+	}
+
+	if (mByteBudget == 0) {
+		return numeric_limits<size_t>::max();
+	}
+
+	return mByteBudget > mNumFrameBytes ? mByteBudget - mNumFrameBytes : 0;
+}
+
+void UploadScheduler::addUploadedBytes(const size_t numBytes, const double seconds) {
+	mNumFrameBytes += numBytes;
+	mFrameTime += seconds;
+}
+
+UploadScheduler::Stats UploadScheduler::getStats() const {
+	Stats stats;
+	stats.numQueued = mTasks.size();
+	stats.numCompleted = mNumCompleted;
+	stats.numUploadedBytes = mNumFrameBytes;
+	stats.uploadTime = mFrameTime;
+	return stats;
+}
+
+}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace bluecadet {
+namespace core {
+
+typedef std::shared_ptr<class UploadScheduler> UploadSchedulerRef;
+
+//! Spreads GPU resource creation across frames. Views queue texture, FBO and buffer uploads as tasks with an estimated
+//! number of bytes, and the BaseApp runs queued tasks once per frame until either the byte or the time budget of that
+//! frame is spent. At least one task is run per frame so that large uploads can't stall the queue. Tasks with a higher
+//! priority run first; tasks of equal priority run in the order they've been scheduled.
+//!
+//! The ImageLoader uploads its chunks from whatever is left of the frame's budget after all tasks have run.
+//! Views should draw a fallback (e.g. nothing, a placeholder or their previous content) until their task completes.
+//! Main thread only.
+class UploadScheduler {
+
+public:
+	typedef std::function<void()> UploadFn;
+
+	//! Handle of a queued upload.
+	class Task {
+	public:
+		//! Removes the task from the queue without running it.
+		void		cancel()							{ mIsCanceled = true; mUploadFn = nullptr; }
+		bool		isCanceled() const					{ return mIsCanceled; }
+		bool		isComplete() const					{ return mIsComplete; }
+
+		void		setPriority(const float value)		{ mPriority = value; }
+		float		getPriority() const					{ return mPriority; }
+
+		size_t		getNumBytes() const					{ return mNumBytes; }
+
+	protected:
+		friend class UploadScheduler;
+
+		Task(UploadFn uploadFn, const size_t numBytes, const float priority);
+
+		UploadFn	mUploadFn;
+		size_t		mNumBytes;
+		float		mPriority;
+		bool		mIsCanceled;
+		bool		mIsComplete;
+	};
+
+	typedef std::shared_ptr<Task> TaskRef;
+
+	struct Stats {
+		size_t	numQueued			= 0;	//! Tasks waiting for the next frame
+		size_t	numCompleted		= 0;	//! Total number of tasks that have been run
+		size_t	numUploadedBytes	= 0;	//! Bytes uploaded during the last update, including ImageLoader uploads
+		double	uploadTime			= 0;	//! Seconds spent on uploads during the last update, including ImageLoader uploads
+	};
+
+	//! Shared instance that is updated by the BaseApp.
+	static UploadSchedulerRef get();
+
+	UploadScheduler();
+	~UploadScheduler();
+
+	//! Queues uploadFn, which is expected to upload roughly numBytes. If scheduling is disabled, uploadFn is called immediately.
+	TaskRef				schedule(UploadFn uploadFn, const size_t numBytes, const float priority = 0);
+
+	//! Starts a new frame and runs queued tasks within the budget.
+	void				update();
+
+	//! Bytes left in the current frame's budget. For uploaders that split their own work into chunks.
+	size_t				getRemainingBytes() const;
+
+	//! Counts uploads that haven't been scheduled as tasks towards the current frame's budget.
+	void				addUploadedBytes(const size_t numBytes, const double seconds);
+
+	//! When disabled, tasks are run as soon as they're scheduled. Defaults to true.
+	void				setEnabled(const bool value)			{ mIsEnabled = value; }
+	bool				isEnabled() const						{ return mIsEnabled; }
+
+	//! Maximum number of bytes uploaded per frame. 0 disables the limit. Defaults to 16MB.
+	void				setByteBudget(const size_t numBytes)	{ mByteBudget = numBytes; }
+	size_t				getByteBudget() const					{ return mByteBudget; }
+
+	//! Maximum number of seconds spent on uploads per frame. 0 disables the limit. Defaults to 4ms.
+	void				setTimeBudget(const double seconds)		{ mTimeBudget = seconds; }
+	double				getTimeBudget() const					{ return mTimeBudget; }
+
+	Stats				getStats() const;
+
+protected:
+	bool				hasBudget(const size_t numBytes) const;
+	void				run(Task & task);
+
+	std::vector<TaskRef>	mTasks;
+
+	bool				mIsEnabled;
+	size_t				mByteBudget;
+	double				mTimeBudget;
+
+	size_t				mNumFrameBytes;
+	double				mFrameTime;
+	size_t				mNumCompleted;
+};
+
+}
+}
@@ -1,5 +1,7 @@
 #include "Touch.h"
 
+#include <chrono>
+
 using namespace ci;
 using namespace ci::app;
 using namespace std;
@@ -7,12 +9,18 @@ using namespace std;
 namespace bluecadet {
 namespace touch {
 
+double getTouchTime() {
+	static const auto startTime = chrono::steady_clock::now();
+	return chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+}
+
 Touch::Touch(const int id, const ci::ivec2 windowPosition, const TouchType type, const TouchPhase phase) :
 	id(id),
 	windowPosition(windowPosition),
 	appPosition(windowPosition),
 	type(type),
-	phase(phase) {
+	phase(phase),
+	timestamp(getTouchTime()) {
 }
 
 
@@ -21,6 +29,13 @@ const string TouchEvent::Type::TOUCH = "touch";
 TouchEvent::TouchEvent(const Touch & touch)	:
 	TouchEvent(touch.id, touch.windowPosition, touch.appPosition, touch.type, touch.phase)
 {
+	timestamp = touch.timestamp;
+
+	if (touch.hasPrediction) {
+		hasPrediction = true;
+		predictedGlobalPosition = touch.predictedAppPosition;
+		predictedLocalPosition = touch.predictedAppPosition;
+	}
 }
 
 TouchEvent::TouchEvent(const int touchId, const ci::ivec2 & windowPosition, const ci::vec2 & globalPosition, const TouchType touchType, const TouchPhase touchPhase) :
@@ -30,7 +45,9 @@ TouchEvent::TouchEvent(const int touchId, const ci::ivec2 & windowPosition, cons
 	globalPosition(globalPosition),
 	localPosition(globalPosition),
 	touchPhase(touchPhase),
-	touchType(touchType) {
+	touchType(touchType),
+	predictedGlobalPosition(globalPosition),
+	predictedLocalPosition(globalPosition) {
 }
 
 }
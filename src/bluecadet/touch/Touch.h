@@ -21,6 +21,9 @@ enum class TouchPhase { Began, Moved, Ended };
 
 typedef ci::signals::Signal<void(const struct TouchEvent & touchEvent)> TouchSignal;
 
+//! Monotonic, high-resolution time in seconds that is used to timestamp touches. Independent of the app's elapsed time and safe to call from any thread.
+double getTouchTime();
+
 //! Touches are used to store the state of active touches within the TouchManager.
 struct Touch {
 
@@ -34,6 +37,14 @@ struct Touch {
 	//! Mostly used for touch simulation
 	bool			isVirtual		= false;
 
+	// Latency timestamps based on getTouchTime()
+	double			timestamp		= 0;	//! Time at which the driver received this touch. Set automatically when created with the id/position constructor or when added without a timestamp.
+	double			dequeueTime		= 0;	//! Time at which the TouchManager picked up this touch on the main thread
+
+	// Optional prediction set by plugins (e.g. plugins::TouchPredictionPlugin)
+	bool			hasPrediction			= false;
+	ci::vec2		predictedAppPosition	= ci::vec2(0);	//! Expected app position at the time this touch will be presented
+
 	Touch() {};
 	Touch(const int id, const ci::ivec2 windowPosition, const TouchType type, const TouchPhase phase);
 };
@@ -53,11 +64,17 @@ struct TouchEvent : public views::ViewEvent {
 	int					touchId			= -1;
 	TouchType			touchType		= TouchType::Other;
 	TouchPhase			touchPhase		= TouchPhase::Began;
+	double				timestamp		= 0;	//! Time at which the driver received the touch (see getTouchTime())
 
 	// Optional values
 	views::TouchViewRef	touchTarget		= nullptr;
 	bool				isCanceled		= false;
 
+	// Predicted positions. Same as globalPosition/localPosition unless hasPrediction is true.
+	bool				hasPrediction			= false;
+	ci::vec2			predictedGlobalPosition	= ci::vec2(0);	//! Expected global position at the time this event will be presented
+	ci::vec2			predictedLocalPosition	= ci::vec2(0);	//! Expected local position at the time this event will be presented
+
 	TouchEvent() : ViewEvent(TouchEvent::Type::TOUCH) {};
 	TouchEvent(const Touch & touch);
 	TouchEvent(const int touchId, const ci::ivec2 & windowPosition, const ci::vec2 & globalPosition, const TouchType touchType, const TouchPhase phase);
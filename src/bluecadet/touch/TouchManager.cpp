@@ -19,6 +19,8 @@ using namespace bluecadet::views;
 //
 
 TouchManager::TouchManager() :
+	mTouchSlots(256),
+	mNumViewTouches(0),
 	mDiscardMissedTouches(true),
 	mMultiTouchEnabled(true),
 	mLatestTouchTime(0) {
@@ -39,6 +41,12 @@ void TouchManager::update(BaseViewRef rootView, const vec2 & appSize, const mat4
 	mAppSize = appSize;
 	mAppTransform = appTransform;
 
+	// stamp all queued touches with the time they're picked up on the main thread
+	const double dequeueTime = getTouchTime();
+	for (auto & touch : mTouchQueue) {
+		touch.dequeueTime = dequeueTime;
+	}
+
 	// pre update plugins
 	for (auto plugin : mPlugins) {
 		plugin->preUpdate(this, mTouchQueue);
@@ -75,6 +83,10 @@ void TouchManager::addTouch(Touch & touch) {
 	const vec2 transformedPos = vec2(mAppTransform * vec4(touch.windowPosition, 0, 1));
 	touch.appPosition = transformedPos;
 
+	if (touch.timestamp <= 0) {
+		touch.timestamp = getTouchTime();
+	}
+
 	lock_guard<recursive_mutex> scopedUpdateLock(mQueueMutex);
 	mTouchQueue.push_back(touch);
 	mLatestTouchTime = (float)getElapsedSeconds(); // Update the most recent touch time on the app
@@ -83,19 +95,19 @@ void TouchManager::addTouch(Touch & touch) {
 void TouchManager::mainThreadTouchesBegan(const Touch & touch, views::BaseViewRef rootView) {
 
 	// ignore rare touches with duplicate IDs
-	if (mTouchesById.find(touch.id) != mTouchesById.end()) {
+	if (mTouchSlots.find(touch.id).isValid()) {
 		CI_LOG_W("Duplicate touch detected for ID '" << touch.id << "'");
 		return;
 	}
 
 	// only store virtual touches, but don't process further
 	if (touch.isVirtual) {
-		mTouchesById[touch.id] = touch;
+		mTouchSlots.get(mTouchSlots.insert(touch.id))->touch = touch;
 		return;
 	}
 
 	// cancel if multi touch is not enabled and we already have touches
-	if (!mMultiTouchEnabled && !mViewsByTouchId.empty()) {
+	if (!mMultiTouchEnabled && mNumViewTouches > 0) {
 		return;
 	}
 
@@ -108,21 +120,27 @@ void TouchManager::mainThreadTouchesBegan(const Touch & touch, views::BaseViewRe
 		touchEvent.target = viewRef;
 		touchEvent.touchTarget = viewRef;
 		touchEvent.localPosition = view->convertGlobalToLocal(touchEvent.globalPosition);
+		touchEvent.predictedLocalPosition = touchEvent.hasPrediction ? view->convertGlobalToLocal(touchEvent.predictedGlobalPosition) : touchEvent.localPosition;
 	}
 
 	mSignalTouchBegan.emit(touchEvent);
 
 	if (view) {
-		// save and process touch
-		mViewsByTouchId[touchEvent.touchId] = views::TouchViewWeakRef(touchEvent.touchTarget);
+		// save touch before processing; handlers can cancel it or add other touches
+		auto slot = mTouchSlots.get(mTouchSlots.insert(touchEvent.touchId));
+		slot->touch = touch;
+		slot->viewRef = touchEvent.touchTarget;
+		slot->view = view;
+		mNumViewTouches++;
+
 		view->processTouchBegan(touchEvent);
 		view->dispatchEvent(touchEvent); // TODO: move this into processTouch...()
-		mTouchesById[touchEvent.touchId] = touch;
 
 	} else if (!mDiscardMissedTouches) {
 		// make touch virtual if it's discarded
-		mTouchesById[touchEvent.touchId] = Touch(touch);
-		mTouchesById[touchEvent.touchId].isVirtual = true;
+		auto slot = mTouchSlots.get(mTouchSlots.insert(touchEvent.touchId));
+		slot->touch = touch;
+		slot->touch.isVirtual = true;
 	}
 
 	// process event in plugins
@@ -132,33 +150,42 @@ void TouchManager::mainThreadTouchesBegan(const Touch & touch, views::BaseViewRe
 }
 
 void TouchManager::mainThreadTouchesMoved(const Touch & touch, views::BaseViewRef rootView) {
+	const auto handle = mTouchSlots.find(touch.id);
+	auto slot = mTouchSlots.get(handle);
+
 	// only store virtual touches, but don't process further
 	if (touch.isVirtual) {
-		mTouchesById[touch.id] = touch;
+		if (!slot) slot = mTouchSlots.get(mTouchSlots.insert(touch.id));
+		slot->touch = touch;
 		return;
 	}
 
 	TouchEvent touchEvent(touch);
-	auto view = getViewForTouchId(touchEvent.touchId);
+	TouchViewRef view = (slot && slot->view) ? slot->viewRef.lock() : nullptr;
 
 	if (view) {
 		touchEvent.target = view;
 		touchEvent.touchTarget = view;
 		touchEvent.localPosition = view->convertGlobalToLocal(touchEvent.globalPosition);
+		touchEvent.predictedLocalPosition = touchEvent.hasPrediction ? view->convertGlobalToLocal(touchEvent.predictedGlobalPosition) : touchEvent.localPosition;
 	}
 
 	mSignalTouchMoved.emit(touchEvent);
 
-	if (view) {
+	// signal handlers can add or end touches, so the slot has to be looked up again
+	slot = mTouchSlots.get(handle);
+
+	if (view && slot) {
 		// save and process touch
+		slot->touch = touch;
 		view->processTouchMoved(touchEvent);
 		view->dispatchEvent(touchEvent); // TODO: move this into processTouch...()
-		mTouchesById[touchEvent.touchId] = touch;
 
-	} else if (!mDiscardMissedTouches) {
+	} else if (!view && !mDiscardMissedTouches) {
 		// make touch virtual if it's discarded
-		mTouchesById[touchEvent.touchId] = Touch(touch);
-		mTouchesById[touchEvent.touchId].isVirtual = true;
+		if (!slot) slot = mTouchSlots.get(mTouchSlots.insert(touch.id));
+		slot->touch = touch;
+		slot->touch.isVirtual = true;
 	}
 
 	// process event in plugins
@@ -176,18 +203,15 @@ void TouchManager::mainThreadTouchesEnded(const Touch & touch, views::BaseViewRe
 	{// scoped lock start
 		lock_guard<recursive_mutex> scopedTouchMapLock(mTouchIdMutex);
 
-		// remove view
-		const auto viewIt = mViewsByTouchId.find(touchEvent.touchId);
+		// remove view and touch
+		const auto slot = mTouchSlots.get(touchEvent.touchId);
 
-		if (viewIt != mViewsByTouchId.end()) {
-			view = viewIt->second.lock();
-			mViewsByTouchId.erase(viewIt);
-		}
-
-		// remove event
-		const auto eventIt = mTouchesById.find(touchEvent.touchId);
-		if (eventIt != mTouchesById.end()) {
-			mTouchesById.erase(eventIt);
+		if (slot) {
+			if (slot->view) {
+				view = slot->viewRef.lock();
+				mNumViewTouches--;
+			}
+			mTouchSlots.erase(touchEvent.touchId);
 		}
 
 	}// scoped lock end
@@ -196,6 +220,7 @@ void TouchManager::mainThreadTouchesEnded(const Touch & touch, views::BaseViewRe
 		touchEvent.target = view;
 		touchEvent.touchTarget = view;
 		touchEvent.localPosition = view->convertGlobalToLocal(touchEvent.globalPosition);
+		touchEvent.predictedLocalPosition = touchEvent.hasPrediction ? view->convertGlobalToLocal(touchEvent.predictedGlobalPosition) : touchEvent.localPosition;
 	}
 
 	if (touch.isVirtual) {
@@ -217,25 +242,45 @@ void TouchManager::mainThreadTouchesEnded(const Touch & touch, views::BaseViewRe
 }
 
 void TouchManager::cancelTouch(TouchViewRef touchView) {
-	vector<Touch> touchesToEnd;
+	vector<pair<TouchSlotTable::Handle, Touch>> touchesToEnd;
 
 	{// scoped lock start
 		lock_guard<recursive_mutex> scopedUpdateLock(mQueueMutex);
 		lock_guard<recursive_mutex> scopedTouchMapLock(mTouchIdMutex);
 
-		for (auto & it : mViewsByTouchId) {
-			if (it.second.lock() == touchView) {
-				const auto & touch = mTouchesById[it.first];
-				touchesToEnd.push_back(touch);
+		const auto & slots = mTouchSlots.getSlots();
+
+		for (uint32_t i = 0; i < (uint32_t)slots.size(); ++i) {
+			const auto & slot = slots[i];
+			if (slot.isActive && slot.view == touchView.get()) {
+				TouchSlotTable::Handle handle;
+				handle.index = i;
+				handle.generation = slot.generation;
+				touchesToEnd.push_back(make_pair(handle, slot.touch));
 			}
 		}
 	}// scoped lock end
 
-	for (const auto & touch : touchesToEnd) {
-		mainThreadTouchesEnded(touch, touchView, true);
+	for (const auto & it : touchesToEnd) {
+		// skip touches that have already been ended by handlers of previous touches
+		if (!mTouchSlots.get(it.first)) {
+			continue;
+		}
+		mainThreadTouchesEnded(it.second, touchView, true);
 	}
 }
 
+bool TouchManager::isViewHandlingTouch(const views::TouchView * view, const int touchId) {
+	lock_guard<recursive_mutex> scopedTouchMapLock(mTouchIdMutex);
+	const auto slot = mTouchSlots.get(touchId);
+	return slot && slot->view == view && !slot->viewRef.expired();
+}
+
+size_t TouchManager::getNumTouches() {
+	lock_guard<recursive_mutex> scopedTouchMapLock(mTouchIdMutex);
+	return mTouchSlots.size();
+}
+
 
 //==================================================
 // View Helpers
@@ -243,16 +288,15 @@ void TouchManager::cancelTouch(TouchViewRef touchView) {
 
 TouchViewRef TouchManager::getViewForTouchId(const int touchId) {
 	lock_guard<recursive_mutex> scopedTouchMapLock(mTouchIdMutex);
-	const auto touchViewIt = mViewsByTouchId.find(touchId);
-	const bool containsId = touchViewIt != mViewsByTouchId.end();
+	const auto slot = mTouchSlots.get(touchId);
 
-	if (!containsId) {
+	if (!slot || !slot->view) {
 		// Stop if we can't find this object
 		return nullptr;
 	}
 
 	// Try to get a strong pointer; This could return nullptr
-	return touchViewIt->second.lock();
+	return slot->viewRef.lock();
 }
 
 TouchView * TouchManager::getTopViewForTouch(const Touch & touch, BaseViewRef view) {
@@ -386,9 +430,10 @@ void TouchManager::debugDrawTouch(const Touch & touch, const bool isVirtual) {
 void TouchManager::debugDrawTouches() {
 	lock_guard<recursive_mutex> scopedTouchMapLock(mTouchIdMutex);
 	//gl::ScopedBlendPremult scopedBlend;
-	for (const auto & it : mTouchesById) {
-		const auto & touch = it.second;
-		debugDrawTouch(touch, touch.isVirtual);
+	for (const auto & slot : mTouchSlots.getSlots()) {
+		if (slot.isActive) {
+			debugDrawTouch(slot.touch, slot.touch.isVirtual);
+		}
 	}
 }
 
@@ -15,6 +15,7 @@
 
 #include "Touch.h"
 #include "TouchManagerPlugin.h"
+#include "TouchSlotTable.h"
 #include "../views/TouchView.h"
 
 namespace bluecadet {
@@ -57,6 +58,12 @@ public:
 	//! Removes a touch if it exists. Views associated to this event will be notifed with touchEnded.
 	void					cancelTouch(views::TouchViewRef touchView);
 
+	//! Returns true if touchId is currently assigned to view.
+	bool					isViewHandlingTouch(const views::TouchView * view, const int touchId);
+
+	//! Number of touches that are currently tracked, including virtual touches.
+	size_t					getNumTouches();
+
 
 	//==================================================
 	// Accessors
@@ -117,8 +124,8 @@ protected:
 	TouchSignal									mSignalTouchEnded;	//! Fired before any touch objects receive this event
 
 	std::recursive_mutex						mTouchIdMutex;
-	std::map<int, views::TouchViewWeakRef>		mViewsByTouchId;	// Stores views that are currently being touched
-	std::map<int, Touch>						mTouchesById;		// Whatever the latest event is for a touch id
+	TouchSlotTable								mTouchSlots;		// Latest state and touched view for each touch id
+	size_t										mNumViewTouches;	// Number of touches that are assigned to a view
 
 	std::recursive_mutex						mQueueMutex;
 	std::deque<Touch>							mTouchQueue;		 // Collects all touch events until they're processed on the main thread
@@ -0,0 +1,223 @@
+#include "TouchRecording.h"
+
+#include "cinder/Log.h"
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+
+//==================================================
+// Record
+//
+
+namespace recording {
+
+Record::Record(const Touch & touch, const double time, const uint32_t frame) :
+	time(time),
+	frame(frame),
+	id(touch.id),
+	x(touch.windowPosition.x),
+	y(touch.windowPosition.y),
+	type((uint8_t)touch.type),
+	phase((uint8_t)touch.phase),
+	flags(touch.isVirtual ? Virtual : None)
+{
+}
+
+Touch Record::toTouch() const {
+	Touch touch(id, ivec2(x, y), (TouchType)type, (TouchPhase)phase);
+	touch.isVirtual = (flags & Virtual) != 0;
+	return touch;
+}
+
+}
+
+//==================================================
+// Writer
+//
+
+TouchRecordingWriter::TouchRecordingWriter() :
+	mBlockSize(1024),
+	mNumRecords(0)
+{
+}
+
+TouchRecordingWriter::~TouchRecordingWriter() {
+	close();
+}
+
+bool TouchRecordingWriter::open(const ci::fs::path & path) {
+	close();
+
+	mStream.open(path.string(), ios::out | ios::binary | ios::trunc);
+
+	if (!mStream.is_open()) {
+		CI_LOG_E("Could not open touch recording '" << path << "' for writing");
+		return false;
+	}
+
+	recording::FileHeader header;
+	header.recordSize = sizeof(recording::Record);
+	mStream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	mBuffer.clear();
+	mBuffer.reserve(mBlockSize);
+	mNumRecords = 0;
+
+	return true;
+}
+
+void TouchRecordingWriter::close() {
+	if (!mStream.is_open()) {
+		return;
+	}
+	flush();
+	mStream.close();
+}
+
+void TouchRecordingWriter::write(const Touch & touch, const double time, const uint32_t frame) {
+	if (!mStream.is_open()) {
+		return;
+	}
+
+	mBuffer.push_back(recording::Record(touch, time, frame));
+	mNumRecords++;
+
+	if (mBuffer.size() >= mBlockSize) {
+		flush();
+	}
+}
+
+void TouchRecordingWriter::flush() {
+	if (!mStream.is_open() || mBuffer.empty()) {
+		return;
+	}
+
+	recording::BlockHeader header;
+	header.numRecords = (uint32_t)mBuffer.size();
+	header.firstFrame = mBuffer.front().frame;
+	header.lastFrame = mBuffer.back().frame;
+	header.firstTime = mBuffer.front().time;
+	header.lastTime = mBuffer.back().time;
+
+	mStream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	mStream.write(reinterpret_cast<const char *>(mBuffer.data()), mBuffer.size() * sizeof(recording::Record));
+	mStream.flush();
+
+	mBuffer.clear();
+}
+
+//==================================================
+// Reader
+//
+
+TouchRecordingReader::TouchRecordingReader() :
+	mNumRecords(0)
+{
+}
+
+TouchRecordingReader::~TouchRecordingReader() {
+	close();
+}
+
+bool TouchRecordingReader::open(const ci::fs::path & path) {
+	close();
+
+	mStream.open(path.string(), ios::in | ios::binary);
+
+	if (!mStream.is_open()) {
+		CI_LOG_E("Could not open touch recording '" << path << "'");
+		return false;
+	}
+
+	recording::FileHeader fileHeader;
+	mStream.read(reinterpret_cast<char *>(&fileHeader), sizeof(fileHeader));
+
+	if (!mStream || fileHeader.magic != recording::FileHeader::kMagic) {
+		CI_LOG_E("'" << path << "' is not a touch recording");
+		close();
+		return false;
+	}
+
+	if (fileHeader.version != recording::FileHeader::kVersion || fileHeader.recordSize != sizeof(recording::Record)) {
+		CI_LOG_E("Touch recording '" << path << "' has an unsupported version (" << fileHeader.version << ")");
+		close();
+		return false;
+	}
+
+	const streamoff headerEnd = mStream.tellg();
+	mStream.seekg(0, ios::end);
+	const streamoff fileSize = mStream.tellg();
+	mStream.seekg(headerEnd);
+
+	// index all blocks by jumping from header to header
+	while (true) {
+		recording::BlockHeader blockHeader;
+		mStream.read(reinterpret_cast<char *>(&blockHeader), sizeof(blockHeader));
+
+		if (!mStream || blockHeader.magic != recording::BlockHeader::kMagic) {
+			break;
+		}
+
+		BlockInfo info;
+		info.offset = mStream.tellg();
+		info.header = blockHeader;
+
+		const streamoff blockEnd = info.offset + (streamoff)(blockHeader.numRecords * sizeof(recording::Record));
+
+		if (blockEnd > fileSize) {
+			CI_LOG_W("Touch recording '" << path << "' ends with an incomplete block; ignoring it");
+			break;
+		}
+
+		mStream.seekg(blockEnd);
+
+		mBlocks.push_back(info);
+		mNumRecords += blockHeader.numRecords;
+	}
+
+	mStream.clear();
+	return true;
+}
+
+void TouchRecordingReader::close() {
+	if (mStream.is_open()) {
+		mStream.close();
+	}
+	mBlocks.clear();
+	mNumRecords = 0;
+}
+
+bool TouchRecordingReader::readBlock(const size_t blockIndex, std::vector<recording::Record> & records) {
+	if (!mStream.is_open() || blockIndex >= mBlocks.size()) {
+		return false;
+	}
+
+	const auto & block = mBlocks[blockIndex];
+	records.resize(block.header.numRecords);
+
+	mStream.clear();
+	mStream.seekg(block.offset);
+	mStream.read(reinterpret_cast<char *>(records.data()), records.size() * sizeof(recording::Record));
+
+	if (!mStream) {
+		CI_LOG_E("Could not read block " << blockIndex << " of touch recording");
+		records.clear();
+		return false;
+	}
+
+	return true;
+}
+
+size_t TouchRecordingReader::findBlock(const double time) const {
+	// blocks are sorted by time, so find the last one that starts at or before time
+	auto it = upper_bound(mBlocks.begin(), mBlocks.end(), time, [](const double t, const BlockInfo & block) {
+		return t < block.header.firstTime;
+	});
+	return it == mBlocks.begin() ? 0 : (size_t)distance(mBlocks.begin(), it) - 1;
+}
+
+}
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+#include "Touch.h"
+
+namespace bluecadet {
+namespace touch {
+
+//==================================================
+// Binary touch recording format
+//
+// File layout:
+//   FileHeader
+//   BlockHeader, Record * BlockHeader::numRecords
+//   BlockHeader, Record * BlockHeader::numRecords
+//   ...
+//
+// Records are written in blocks, each of which starts with a small index header that contains the
+// time and frame range of its records. Readers can skip from block to block to seek without
+// parsing individual records and a file that was cut off (e.g. by a crash) stays readable up to its
+// last complete block. All values are little-endian.
+//
+
+namespace recording {
+
+#pragma pack(push, 1)
+
+struct FileHeader {
+	static const uint32_t kMagic = 0x52544342; // "BCTR"
+	static const uint32_t kVersion = 1;
+
+	uint32_t	magic		= kMagic;
+	uint32_t	version		= kVersion;
+	uint32_t	recordSize	= 0;	//! sizeof(Record) at the time of writing
+	uint32_t	reserved	= 0;
+};
+
+struct BlockHeader {
+	static const uint32_t kMagic = 0x4B434C42; // "BLCK"
+
+	uint32_t	magic		= kMagic;
+	uint32_t	numRecords	= 0;
+	uint32_t	firstFrame	= 0;
+	uint32_t	lastFrame	= 0;
+	double		firstTime	= 0;
+	double		lastTime	= 0;
+};
+
+struct Record {
+	enum Flags : uint8_t { None = 0, Virtual = 1 };
+
+	double		time		= 0;	//! Seconds since the start of the recording, based on Touch::timestamp
+	uint32_t	frame		= 0;	//! Index of the TouchManager update in which this touch was processed
+	int32_t		id			= -1;
+	int32_t		x			= 0;	//! Window position
+	int32_t		y			= 0;	//! Window position
+	uint8_t		type		= 0;	//! TouchType
+	uint8_t		phase		= 0;	//! TouchPhase
+	uint8_t		flags		= None;
+	uint8_t		reserved	= 0;
+
+	Record() {}
+	Record(const Touch & touch, const double time, const uint32_t frame);
+
+	//! Converts this record back into a touch. The touch timestamp is set to the current time.
+	Touch		toTouch() const;
+};
+
+#pragma pack(pop)
+
+}
+
+//==================================================
+// Writer
+//
+
+class TouchRecordingWriter {
+
+public:
+	TouchRecordingWriter();
+	~TouchRecordingWriter();
+
+	//! Creates or overwrites the file at path. Returns false if the file can't be opened.
+	bool	open(const ci::fs::path & path);
+
+	//! Writes all buffered records and closes the file.
+	void	close();
+	bool	isOpen() const { return mStream.is_open(); }
+
+	//! Buffers a touch and writes a new block once the block size is reached. Time is in seconds since the start of the recording.
+	void	write(const Touch & touch, const double time, const uint32_t frame);
+
+	//! Writes all buffered records as a block.
+	void	flush();
+
+	//! Max number of records per block. Smaller blocks allow for more granular seeking, larger blocks have less overhead. Defaults to 1024.
+	size_t	getBlockSize() const { return mBlockSize; }
+	void	setBlockSize(const size_t value) { mBlockSize = std::max((size_t)1, value); }
+
+	size_t	getNumRecords() const { return mNumRecords; }
+
+protected:
+	std::ofstream					mStream;
+	std::vector<recording::Record>	mBuffer;
+	size_t							mBlockSize;
+	size_t							mNumRecords;
+};
+
+//==================================================
+// Reader
+//
+
+class TouchRecordingReader {
+
+public:
+	struct BlockInfo {
+		std::streamoff			offset;		//! File offset of the first record in this block
+		recording::BlockHeader	header;
+	};
+
+	TouchRecordingReader();
+	~TouchRecordingReader();
+
+	//! Opens a recording and indexes all of its blocks. Returns false if the file can't be read.
+	bool	open(const ci::fs::path & path);
+	void	close();
+	bool	isOpen() const { return mStream.is_open(); }
+
+	//! Reads all records of a block into records. Returns false if the block can't be read.
+	bool	readBlock(const size_t blockIndex, std::vector<recording::Record> & records);
+
+	//! Returns the index of the block that contains time (or the last block before it).
+	size_t	findBlock(const double time) const;
+
+	const std::vector<BlockInfo> &	getBlocks() const { return mBlocks; }
+	size_t	getNumBlocks() const	{ return mBlocks.size(); }
+	size_t	getNumRecords() const	{ return mNumRecords; }
+	double	getDuration() const		{ return mBlocks.empty() ? 0 : mBlocks.back().header.lastTime; }
+
+protected:
+	std::ifstream			mStream;
+	std::vector<BlockInfo>	mBlocks;
+	size_t					mNumRecords;
+};
+
+}
+}
@@ -0,0 +1,201 @@
+#include "TouchSlotTable.h"
+
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+
+TouchSlotTable::TouchSlotTable(const size_t initialCapacity) :
+	mNumActiveSlots(0),
+	mHashShift(28)
+{
+	size_t numBuckets = 16;
+	while (numBuckets < initialCapacity * 2) {
+		numBuckets *= 2;
+		mHashShift--;
+	}
+	mBuckets.resize(numBuckets);
+	mSlots.reserve(initialCapacity);
+	mFreeSlots.reserve(initialCapacity);
+}
+
+//==================================================
+// Slots
+//
+
+TouchSlotTable::Handle TouchSlotTable::insert(const int touchId) {
+	if (findBucket(touchId) != mBuckets.size()) {
+		return Handle();
+	}
+
+	if ((mNumActiveSlots + 1) * 2 > mBuckets.size()) {
+		growBuckets();
+	}
+
+	// reuse released slots before growing
+	uint32_t slotIndex;
+	if (!mFreeSlots.empty()) {
+		slotIndex = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	} else {
+		slotIndex = (uint32_t)mSlots.size();
+		mSlots.emplace_back();
+	}
+
+	Slot & slot = mSlots[slotIndex];
+	slot.isActive = true;
+	slot.touch = Touch();
+	slot.touch.id = touchId;
+	slot.viewRef.reset();
+	slot.view = nullptr;
+
+	size_t bucketIndex = getHomeBucket(touchId);
+	const size_t mask = mBuckets.size() - 1;
+	while (mBuckets[bucketIndex].slotIndex != kInvalidIndex) {
+		bucketIndex = (bucketIndex + 1) & mask;
+	}
+	mBuckets[bucketIndex].touchId = touchId;
+	mBuckets[bucketIndex].slotIndex = slotIndex;
+
+	mNumActiveSlots++;
+
+	Handle handle;
+	handle.index = slotIndex;
+	handle.generation = slot.generation;
+	return handle;
+}
+
+TouchSlotTable::Handle TouchSlotTable::find(const int touchId) const {
+	const size_t bucketIndex = findBucket(touchId);
+
+	if (bucketIndex == mBuckets.size()) {
+		return Handle();
+	}
+
+	Handle handle;
+	handle.index = mBuckets[bucketIndex].slotIndex;
+	handle.generation = mSlots[handle.index].generation;
+	return handle;
+}
+
+TouchSlotTable::Slot * TouchSlotTable::get(const Handle & handle) {
+	if (handle.index >= mSlots.size()) {
+		return nullptr;
+	}
+	Slot & slot = mSlots[handle.index];
+	return (slot.isActive && slot.generation == handle.generation) ? &slot : nullptr;
+}
+
+const TouchSlotTable::Slot * TouchSlotTable::get(const Handle & handle) const {
+	if (handle.index >= mSlots.size()) {
+		return nullptr;
+	}
+	const Slot & slot = mSlots[handle.index];
+	return (slot.isActive && slot.generation == handle.generation) ? &slot : nullptr;
+}
+
+bool TouchSlotTable::erase(const int touchId) {
+	size_t bucketIndex = findBucket(touchId);
+
+	if (bucketIndex == mBuckets.size()) {
+		return false;
+	}
+
+	// release slot and invalidate existing handles
+	const uint32_t slotIndex = mBuckets[bucketIndex].slotIndex;
+	Slot & slot = mSlots[slotIndex];
+	slot.isActive = false;
+	slot.generation++;
+	slot.viewRef.reset();
+	slot.view = nullptr;
+	mFreeSlots.push_back(slotIndex);
+	mNumActiveSlots--;
+
+	// backward shift deletion keeps probe sequences intact without tombstones
+	const size_t mask = mBuckets.size() - 1;
+	size_t nextIndex = bucketIndex;
+
+	while (true) {
+		nextIndex = (nextIndex + 1) & mask;
+		const Bucket & next = mBuckets[nextIndex];
+
+		if (next.slotIndex == kInvalidIndex) {
+			break;
+		}
+
+		const size_t homeIndex = getHomeBucket(next.touchId);
+		const bool canShift = (nextIndex > bucketIndex)
+			? (homeIndex <= bucketIndex || homeIndex > nextIndex)
+			: (homeIndex <= bucketIndex && homeIndex > nextIndex);
+
+		if (canShift) {
+			mBuckets[bucketIndex] = next;
+			bucketIndex = nextIndex;
+		}
+	}
+
+	mBuckets[bucketIndex] = Bucket();
+	return true;
+}
+
+void TouchSlotTable::clear() {
+	mFreeSlots.clear();
+	for (uint32_t i = 0; i < (uint32_t)mSlots.size(); ++i) {
+		Slot & slot = mSlots[i];
+		if (slot.isActive) {
+			slot.isActive = false;
+			slot.generation++;
+			slot.viewRef.reset();
+			slot.view = nullptr;
+		}
+		mFreeSlots.push_back(i);
+	}
+	std::fill(mBuckets.begin(), mBuckets.end(), Bucket());
+	mNumActiveSlots = 0;
+}
+
+//==================================================
+// Id remapping
+//
+
+inline size_t TouchSlotTable::getHomeBucket(const int touchId) const {
+	// fibonacci hashing spreads sequential ids evenly
+	return (size_t)(((uint32_t)touchId * 2654435769u) >> mHashShift);
+}
+
+size_t TouchSlotTable::findBucket(const int touchId) const {
+	const size_t mask = mBuckets.size() - 1;
+	size_t bucketIndex = getHomeBucket(touchId);
+
+	while (mBuckets[bucketIndex].slotIndex != kInvalidIndex) {
+		if (mBuckets[bucketIndex].touchId == touchId) {
+			return bucketIndex;
+		}
+		bucketIndex = (bucketIndex + 1) & mask;
+	}
+
+	return mBuckets.size();
+}
+
+void TouchSlotTable::growBuckets() {
+	vector<Bucket> prevBuckets;
+	prevBuckets.swap(mBuckets);
+	mBuckets.resize(prevBuckets.size() * 2);
+	mHashShift--;
+
+	const size_t mask = mBuckets.size() - 1;
+
+	for (const auto & bucket : prevBuckets) {
+		if (bucket.slotIndex == kInvalidIndex) {
+			continue;
+		}
+		size_t bucketIndex = getHomeBucket(bucket.touchId);
+		while (mBuckets[bucketIndex].slotIndex != kInvalidIndex) {
+			bucketIndex = (bucketIndex + 1) & mask;
+		}
+		mBuckets[bucketIndex] = bucket;
+	}
+}
+
+}
+}
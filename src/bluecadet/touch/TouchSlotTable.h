@@ -0,0 +1,86 @@
+#pragma once
+#include "cinder/app/App.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "Touch.h"
+#include "../views/TouchView.h"
+
+namespace bluecadet {
+namespace touch {
+
+//! Flat storage for the state of active touches.
+//!
+//! Driver touch ids are sparse and can grow indefinitely (e.g. TUIO session ids), so each id is remapped
+//! to a dense slot. Slots live in a single vector and are reused after their touch ends. The id remap is an
+//! open-addressing hash table, so lookups, inserts and erases are O(1) and don't allocate once the table
+//! has grown to the peak number of concurrent touches.
+//!
+//! Each slot has a generation that is incremented whenever its touch ends. Handles store the generation at
+//! the time they were created, so stale handles to reused slots can be detected.
+class TouchSlotTable {
+
+public:
+	static const uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+	struct Handle {
+		uint32_t	index		= kInvalidIndex;
+		uint32_t	generation	= 0;
+		bool		isValid() const { return index != kInvalidIndex; }
+	};
+
+	struct Slot {
+		Touch						touch;
+		views::TouchViewWeakRef		viewRef;
+		const views::TouchView *	view		= nullptr;	//! Raw pointer to the touched view for fast identity checks. Lock viewRef before using the view.
+		uint32_t					generation	= 0;
+		bool						isActive	= false;
+	};
+
+	TouchSlotTable(const size_t initialCapacity = 64);
+
+	//! Adds a new slot for touchId. Returns an invalid handle if touchId already has a slot.
+	Handle			insert(const int touchId);
+
+	//! Returns the slot handle for touchId or an invalid handle if it doesn't exist.
+	Handle			find(const int touchId) const;
+
+	//! Returns the slot for a handle or nullptr if the handle is invalid or stale.
+	Slot *			get(const Handle & handle);
+	const Slot *	get(const Handle & handle) const;
+
+	//! Convenience for get(find(touchId)).
+	Slot *			get(const int touchId)			{ return get(find(touchId)); }
+
+	//! Releases the slot of touchId. Returns false if touchId doesn't have a slot.
+	bool			erase(const int touchId);
+	void			clear();
+
+	//! Number of active slots.
+	size_t			size() const	{ return mNumActiveSlots; }
+	bool			empty() const	{ return mNumActiveSlots == 0; }
+
+	//! Dense slot storage including inactive slots. Check Slot::isActive when iterating.
+	const std::vector<Slot> &	getSlots() const	{ return mSlots; }
+	std::vector<Slot> &			getSlots()			{ return mSlots; }
+
+protected:
+	struct Bucket {
+		int			touchId		= -1;
+		uint32_t	slotIndex	= kInvalidIndex;	//! kInvalidIndex marks empty buckets
+	};
+
+	inline size_t	getHomeBucket(const int touchId) const;
+	size_t			findBucket(const int touchId) const;
+	void			growBuckets();
+
+	std::vector<Slot>		mSlots;
+	std::vector<uint32_t>	mFreeSlots;
+	std::vector<Bucket>		mBuckets;		//! Linear probing, power of two size, max 50% load
+	size_t					mNumActiveSlots;
+	uint32_t				mHashShift;		//! 32 - log2(number of buckets)
+};
+
+}
+}
@@ -0,0 +1,216 @@
+#include "ReplayTouchDriver.h"
+
+#include "cinder/Log.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+namespace drivers {
+
+ReplayTouchDriver::ReplayTouchDriver() :
+	mBlockIndex(0),
+	mRecordIndex(0),
+	mTouchManager(TouchManager::get()),
+	mMode(Mode::RealTime),
+	mSpeed(1.0f),
+	mLooping(false),
+	mAutoUpdate(true),
+	mIdOffset(0),
+	mIsRunning(false),
+	mIsFinished(false),
+	mPlaybackTime(0),
+	mPrevUpdateTime(0)
+{
+}
+
+ReplayTouchDriver::~ReplayTouchDriver() {
+	mUpdateConnection.disconnect();
+}
+
+bool ReplayTouchDriver::load(const ci::fs::path & path) {
+	stop();
+
+	if (!mReader.open(path)) {
+		return false;
+	}
+
+	CI_LOG_I("Loaded touch recording '" << path << "' (" << mReader.getNumRecords() << " touches, " << mReader.getDuration() << "s)");
+
+	seek(0);
+	return true;
+}
+
+//==================================================
+// Playback
+//
+
+void ReplayTouchDriver::start() {
+	if (mIsRunning || !mReader.isOpen()) {
+		return;
+	}
+
+	if (mIsFinished) {
+		seek(0);
+	}
+
+	mIsRunning = true;
+	mPrevUpdateTime = views::BaseView::getCurrentTime();
+
+	if (mAutoUpdate) {
+		mUpdateConnection.disconnect();
+		mUpdateConnection = AppBase::get()->getSignalUpdate().connect(bind(&ReplayTouchDriver::handleUpdate, this));
+	}
+}
+
+void ReplayTouchDriver::stop() {
+	mUpdateConnection.disconnect();
+	mIsRunning = false;
+	endActiveTouches();
+}
+
+void ReplayTouchDriver::seek(const double time) {
+	endActiveTouches();
+
+	mIsFinished = false;
+	mPlaybackTime = std::max(0.0, time);
+	mRecords.clear();
+	mRecordIndex = 0;
+
+	if (mReader.getNumBlocks() == 0) {
+		return;
+	}
+
+	loadBlock(mReader.findBlock(mPlaybackTime));
+
+	// skip all records before time; touches that began before time are ignored until they end
+	while (hasNextRecord() && mRecords[mRecordIndex].time < mPlaybackTime) {
+		mRecordIndex++;
+	}
+}
+
+void ReplayTouchDriver::advance(const double deltaTime) {
+	if (!mReader.isOpen() || mIsFinished) {
+		return;
+	}
+
+	if (mMode == Mode::AsFastAsPossible) {
+		if (!hasNextRecord()) {
+			handleEndOfRecording();
+			return;
+		}
+
+		const uint32_t frame = mRecords[mRecordIndex].frame;
+
+		while (hasNextRecord() && mRecords[mRecordIndex].frame == frame) {
+			const auto & record = mRecords[mRecordIndex++];
+			mPlaybackTime = record.time;
+			replayRecord(record);
+		}
+
+	} else {
+		mPlaybackTime += deltaTime * (double)mSpeed;
+
+		while (hasNextRecord() && mRecords[mRecordIndex].time <= mPlaybackTime) {
+			replayRecord(mRecords[mRecordIndex++]);
+		}
+	}
+
+	if (!hasNextRecord()) {
+		handleEndOfRecording();
+	}
+}
+
+void ReplayTouchDriver::handleUpdate() {
+	const double currTime = views::BaseView::getCurrentTime();
+	const double deltaTime = currTime - mPrevUpdateTime;
+	mPrevUpdateTime = currTime;
+
+	if (mIsRunning) {
+		advance(deltaTime);
+	}
+}
+
+void ReplayTouchDriver::handleEndOfRecording() {
+	mSignalFinished.emit();
+
+	if (mLooping) {
+		seek(0);
+		return;
+	}
+
+	mIsFinished = true;
+	stop();
+}
+
+//==================================================
+// Helpers
+//
+
+bool ReplayTouchDriver::loadBlock(const size_t blockIndex) {
+	mBlockIndex = blockIndex;
+	mRecordIndex = 0;
+
+	if (!mReader.readBlock(blockIndex, mRecords)) {
+		mRecords.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool ReplayTouchDriver::hasNextRecord() {
+	// load blocks on demand as the cursor moves past the end of the current one
+	while (mRecordIndex >= mRecords.size()) {
+		if (mBlockIndex + 1 >= mReader.getNumBlocks()) {
+			return false;
+		}
+		loadBlock(mBlockIndex + 1);
+	}
+	return true;
+}
+
+void ReplayTouchDriver::replayRecord(const recording::Record & record) {
+	Touch touch = record.toTouch();
+	touch.id += mIdOffset;
+
+	if (touch.phase == TouchPhase::Began) {
+		mActiveTouches[touch.id] = touch;
+
+	} else {
+		auto it = mActiveTouches.find(touch.id);
+
+		if (it == mActiveTouches.end()) {
+			// touch began before the current playback position (e.g. after seeking)
+			return;
+		}
+
+		if (touch.phase == TouchPhase::Ended) {
+			mActiveTouches.erase(it);
+		} else {
+			it->second = touch;
+		}
+	}
+
+	if (mTouchManager) {
+		mTouchManager->addTouch(touch);
+	}
+}
+
+void ReplayTouchDriver::endActiveTouches() {
+	if (mTouchManager) {
+		for (auto & it : mActiveTouches) {
+			Touch touch = it.second;
+			touch.phase = TouchPhase::Ended;
+			touch.timestamp = getTouchTime();
+			mTouchManager->addTouch(touch);
+		}
+	}
+	mActiveTouches.clear();
+}
+
+}
+}
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "cinder/app/App.h"
+#include "cinder/Signals.h"
+
+#include "../TouchManager.h"
+#include "../TouchRecording.h"
+
+namespace bluecadet {
+namespace touch {
+namespace drivers {
+
+//! Plays back touch recordings created by plugins::TouchRecorderPlugin through TouchManager::addTouch().
+//!
+//! In RealTime mode, touches are replayed with their original timing (optionally scaled by speed).
+//! Playback time follows views::BaseView::getCurrentTime(), so in fixed timestep mode touches are replayed at the same
+//! fixed update steps on every run.
+//! In AsFastAsPossible mode, each call to advance() replays all touches of the next recorded frame,
+//! which makes runs deterministic and independent of the current frame rate (e.g. for benchmarks on a build box).
+class ReplayTouchDriver {
+
+public:
+	enum class Mode { RealTime, AsFastAsPossible };
+
+	ReplayTouchDriver();
+	~ReplayTouchDriver();
+
+	//! Opens a recording and rewinds to its start. Returns false if the file can't be read.
+	bool	load(const ci::fs::path & path);
+
+	//! Starts playback. Will advance on each app update if auto update is enabled.
+	void	start();
+
+	//! Pauses playback and ends all touches that are currently active.
+	void	stop();
+	bool	isRunning() const { return mIsRunning; }
+
+	//! Ends all active touches and jumps to time in seconds.
+	void	seek(const double time);
+
+	//! Advances playback by deltaTime in seconds (scaled by speed). In AsFastAsPossible mode deltaTime is ignored
+	//! and the next recorded frame is replayed. Called automatically if auto update is enabled, but can be called
+	//! manually for headless runs.
+	void	advance(const double deltaTime);
+
+	//! True once all touches have been replayed and looping is disabled.
+	bool	isFinished() const { return mIsFinished; }
+
+	double	getPlaybackTime() const	{ return mPlaybackTime; }
+	double	getDuration() const		{ return mReader.getDuration(); }
+	size_t	getNumRecords() const	{ return mReader.getNumRecords(); }
+
+	//! Defaults to RealTime.
+	Mode	getMode() const					{ return mMode; }
+	void	setMode(const Mode value)		{ mMode = value; }
+
+	//! Playback speed in RealTime mode. Defaults to 1.
+	float	getSpeed() const				{ return mSpeed; }
+	void	setSpeed(const float value)		{ mSpeed = value; }
+
+	//! Restarts from the beginning when the end of the recording is reached. Defaults to false.
+	bool	getLooping() const				{ return mLooping; }
+	void	setLooping(const bool value)	{ mLooping = value; }
+
+	//! Added to all replayed touch ids to prevent conflicts with live touches. Defaults to 0.
+	int		getIdOffset() const				{ return mIdOffset; }
+	void	setIdOffset(const int value)	{ mIdOffset = value; }
+
+	//! Connects to the app's update signal while running. Disable to drive playback via advance() only. Defaults to true.
+	bool	getAutoUpdate() const			{ return mAutoUpdate; }
+	void	setAutoUpdate(const bool value)	{ mAutoUpdate = value; }
+
+	//! Touches are added to this touch manager. Defaults to TouchManager::get().
+	TouchManagerRef	getTouchManager() const						{ return mTouchManager; }
+	void			setTouchManager(TouchManagerRef value)		{ mTouchManager = value; }
+
+	//! Triggered when the end of the recording is reached (also when looping).
+	ci::signals::Signal<void()> &	getSignalFinished() { return mSignalFinished; }
+
+protected:
+	void	handleUpdate();
+	bool	loadBlock(const size_t blockIndex);
+	bool	hasNextRecord();
+	void	replayRecord(const recording::Record & record);
+	void	endActiveTouches();
+	void	handleEndOfRecording();
+
+	TouchRecordingReader				mReader;
+	std::vector<recording::Record>		mRecords;
+	size_t								mBlockIndex;
+	size_t								mRecordIndex;
+	std::map<int, Touch>				mActiveTouches;	//! Last replayed state of each active touch by replayed id
+
+	TouchManagerRef						mTouchManager;
+	ci::signals::Connection				mUpdateConnection;
+	ci::signals::Signal<void()>			mSignalFinished;
+
+	Mode			mMode;
+	float			mSpeed;
+	bool			mLooping;
+	bool			mAutoUpdate;
+	int				mIdOffset;
+
+	bool			mIsRunning;
+	bool			mIsFinished;
+	double			mPlaybackTime;
+	double			mPrevUpdateTime;
+};
+
+}
+}
+}
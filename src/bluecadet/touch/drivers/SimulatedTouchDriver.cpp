@@ -12,34 +12,27 @@ namespace touch {
 namespace drivers {
 
 SimulatedTouchDriver::SimulatedTouchDriver() :
-	mBounds(Rectf()),
-	mTimeline(nullptr),
 	mIsRunning(false),
 	mTouchesPerSecond(0),
-	mMinTouchDuration(0),
-	mMaxTouchDuration(1.0f),
-	mMinDragDistance(0),
-	mMaxDragDistance(200.0f),
-	mTouchCounter(10000),
-	mTouchesToSpawn(0),
-	mPrevUpdateTime(0)
+	mPrevUpdateTime(0),
+	mGenerator(randInt()),
+	mDragModel(make_shared<TouchLoadGenerator::DragModel>(0.0f, 1.0f, 0.0f, 200.0f))
 {
+	mGenerator.clearGestureModels();
+	mGenerator.addGestureModel(mDragModel);
+	mGenerator.setSpawningEnabled(false);
 }
 
 SimulatedTouchDriver::~SimulatedTouchDriver() {
 	stop();
-	if (mConnection.isEnabled()) {
-		mConnection.disable();
-	}
-	if (mTimeline) {
-		mTimeline->clear();
-	}
+	mConnection.disconnect();
+	mGenerator.endAllGestures();
 }
 
 void SimulatedTouchDriver::setup(ci::Rectf bounds, float touchesPerSecond) {
-	mBounds = bounds;
-	mTouchesPerSecond = touchesPerSecond;
-	mTimeline = Timeline::create();
+	mGenerator.setBounds(bounds);
+	setTouchesPerSecond(touchesPerSecond);
+	mConnection.disconnect();
 	mConnection = AppBase::get()->getSignalUpdate().connect(std::bind(&SimulatedTouchDriver::update, this));
 }
 
@@ -49,44 +42,13 @@ void SimulatedTouchDriver::update() {
 	const double deltaTime = min(currTime - mPrevUpdateTime, 15.0 / (double)getFrameRate());
 	mPrevUpdateTime = currTime;
 
-	if (mIsRunning) {
-		mTouchesToSpawn += mTouchesPerSecond * deltaTime;
-	}
-
-	if (mTimeline) {
-		mTimeline->stepTo((float)currTime);
-	}
-
-	if (!mIsRunning && mTouchesToSpawn == 0) {
-		// stop updates once all timeline items have finished
+	if (!mIsRunning && mGenerator.getNumActiveGestures() == 0) {
+		// stop updates once all touches have finished
 		mConnection.disable();
 		return;
 	}
 
-	// generate touches
-	while (mTouchesToSpawn >= 1.0f) {
-
-		const int touchId = mTouchCounter++;
-		mSimulatedTouches.insert(make_pair(touchId, SimulatedTouch(touchId)));
-		SimulatedTouch & touch = mSimulatedTouches[touchId];
-
-		const float duration = randFloat(mMinTouchDuration, mMaxTouchDuration);
-		const float distance = randFloat(mMinDragDistance, mMaxDragDistance);
-
-		touch.relPosition = vec2(randFloat(mBounds.x1, mBounds.x2), randFloat(mBounds.y1, mBounds.y2));
-		const vec2 endPos = touch.relPosition.value() + randVec2() * distance;
-
-		mTimeline->apply(&touch.relPosition, endPos, duration, easeInOutQuad).startFn([&] {
-			TouchManager::get()->addTouch(touch.id, touch.relPosition.value(), TouchType::Simulator, TouchPhase::Began);
-		}).updateFn([&] {
-			TouchManager::get()->addTouch(touch.id, touch.relPosition.value(), TouchType::Simulator, TouchPhase::Moved);
-		}).finishFn([&] {
-			TouchManager::get()->addTouch(touch.id, touch.relPosition.value(), TouchType::Simulator, TouchPhase::Ended);
-			mSimulatedTouches.erase(touch.id);
-		});
-
-		mTouchesToSpawn -= 1.0f;
-	}
+	mGenerator.update(deltaTime);
 }
 
 void SimulatedTouchDriver::start() {
@@ -96,6 +58,7 @@ void SimulatedTouchDriver::start() {
 
 	mIsRunning = true;
 	mPrevUpdateTime = getElapsedSeconds();
+	mGenerator.setSpawningEnabled(true);
 
 	if (!mConnection.isEnabled()) {
 		mConnection.enable();
@@ -104,6 +67,7 @@ void SimulatedTouchDriver::start() {
 
 void SimulatedTouchDriver::stop() {
 	mIsRunning = false;
+	mGenerator.setSpawningEnabled(false);
 }
 
 bool SimulatedTouchDriver::isRunning() const {
@@ -7,11 +7,13 @@
 #pragma once
 #include "cinder/app/App.h"
 #include "../TouchManager.h"
+#include "TouchLoadGenerator.h"
 
 namespace bluecadet {
 namespace touch {
 namespace drivers {
 
+//! Spawns random drag touches for simple stress tests. See TouchLoadGenerator for more complex load scenarios.
 class SimulatedTouchDriver {
 public:
 	SimulatedTouchDriver();
@@ -23,51 +25,36 @@ public:
 	bool isRunning() const;
 
 	float getTouchesPerSecond() const { return mTouchesPerSecond; }
-	void setTouchesPerSecond(float value) { mTouchesPerSecond = value; }
+	void setTouchesPerSecond(float value) { mTouchesPerSecond = value; mGenerator.setGesturesPerSecond(value); }
 
-	float getMinTouchDuration() const { return mMinTouchDuration; }
-	void setMinTouchDuration(const float value) { mMinTouchDuration = value; }
+	float getMinTouchDuration() const { return mDragModel->minDuration; }
+	void setMinTouchDuration(const float value) { mDragModel->minDuration = value; }
 
-	float getMaxTouchDuration() const { return mMaxTouchDuration; }
-	void setMaxTouchDuration(const float value) { mMaxTouchDuration = value; }
+	float getMaxTouchDuration() const { return mDragModel->maxDuration; }
+	void setMaxTouchDuration(const float value) { mDragModel->maxDuration = value; }
 
-	float getMinDragDistance() const { return mMinDragDistance; }
-	void setMinDragDistance(const float value) { mMinDragDistance = value; }
+	float getMinDragDistance() const { return mDragModel->minDistance; }
+	void setMinDragDistance(const float value) { mDragModel->minDistance = value; }
 
-	float getMaxDragDistance() const { return mMaxDragDistance; }
-	void setMaxDragDistance(const float value) { mMaxDragDistance = value; }
+	float getMaxDragDistance() const { return mDragModel->maxDistance; }
+	void setMaxDragDistance(const float value) { mDragModel->maxDistance = value; }
 
-	ci::Rectf getBounds() const { return mBounds; }
-	void setBounds(const ci::Rectf value) { mBounds = value; }
+	ci::Rectf getBounds() const { return mGenerator.getBounds(); }
+	void setBounds(const ci::Rectf value) { mGenerator.setBounds(value); }
 
-private:
-	struct SimulatedTouch {
-		SimulatedTouch(const SimulatedTouch & touch) : id(touch.id) {}
-		SimulatedTouch(const int id) : id(id) {}
-		SimulatedTouch() : id(-1) {}
-		const int id;
-		ci::Anim<ci::vec2> relPosition;
-	};
+	//! The underlying generator, e.g. to add gesture models or change the spatial distribution.
+	TouchLoadGenerator & getGenerator() { return mGenerator; }
 
+private:
 	void update();
 
 	bool mIsRunning;
-
 	float mTouchesPerSecond;
-	float mTouchesToSpawn;
 	double mPrevUpdateTime;
-	int mTouchCounter;
-
-	ci::Rectf mBounds;
-
-	float mMinTouchDuration;
-	float mMaxTouchDuration;
-	float mMinDragDistance;
-	float mMaxDragDistance;
 
-	ci::TimelineRef	mTimeline;
+	TouchLoadGenerator mGenerator;
+	std::shared_ptr<TouchLoadGenerator::DragModel> mDragModel;
 	ci::signals::Connection	mConnection;
-	std::map<int, SimulatedTouch> mSimulatedTouches;
 };
 
 }
@@ -0,0 +1,331 @@
+#include "TouchLoadGenerator.h"
+
+#include "cinder/Easing.h"
+#include "cinder/Log.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+namespace drivers {
+
+// std::min() takes its arguments by reference, which requires a definition
+const size_t TouchLoadGenerator::kMaxFingers;
+
+//==================================================
+// Gesture models
+//
+
+TouchLoadGenerator::TapModel::TapModel(const float minDuration, const float maxDuration) :
+	minDuration(minDuration), maxDuration(maxDuration)
+{
+}
+
+void TouchLoadGenerator::TapModel::setup(Gesture & gesture, ci::Rand & rand) const {
+	gesture.duration = rand.nextFloat(minDuration, maxDuration);
+}
+
+TouchLoadGenerator::DragModel::DragModel(const float minDuration, const float maxDuration, const float minDistance, const float maxDistance) :
+	minDuration(minDuration), maxDuration(maxDuration), minDistance(minDistance), maxDistance(maxDistance)
+{
+}
+
+void TouchLoadGenerator::DragModel::setup(Gesture & gesture, ci::Rand & rand) const {
+	gesture.duration = rand.nextFloat(minDuration, maxDuration);
+	gesture.direction = rand.nextVec2() * rand.nextFloat(minDistance, maxDistance);
+}
+
+ci::vec2 TouchLoadGenerator::DragModel::getPosition(const Gesture & gesture, const size_t finger, const float t) const {
+	return gesture.origin + gesture.direction * easeInOutQuad(t);
+}
+
+TouchLoadGenerator::PinchModel::PinchModel(const float minDuration, const float maxDuration, const float minScale, const float maxScale, const float maxRotation) :
+	minDuration(minDuration), maxDuration(maxDuration), minScale(minScale), maxScale(maxScale), maxRotation(maxRotation)
+{
+}
+
+void TouchLoadGenerator::PinchModel::setup(Gesture & gesture, ci::Rand & rand) const {
+	gesture.numFingers = 2;
+	gesture.duration = rand.nextFloat(minDuration, maxDuration);
+	gesture.spread = rand.nextFloat(20.0f, 100.0f);
+	gesture.direction = rand.nextVec2();
+	gesture.scale = rand.nextFloat(minScale, maxScale);
+	gesture.rotation = rand.nextFloat(-maxRotation, maxRotation);
+}
+
+ci::vec2 TouchLoadGenerator::PinchModel::getPosition(const Gesture & gesture, const size_t finger, const float t) const {
+	const float progress = easeInOutQuad(t);
+	const float radius = gesture.spread * glm::mix(1.0f, gesture.scale, progress);
+	const float angle = atan2(gesture.direction.y, gesture.direction.x) + gesture.rotation * progress + (finger == 0 ? 0 : (float)M_PI);
+	return gesture.origin + vec2(cos(angle), sin(angle)) * radius;
+}
+
+TouchLoadGenerator::SwipeModel::SwipeModel(const size_t minFingers, const size_t maxFingers, const float minDuration, const float maxDuration, const float minDistance, const float maxDistance) :
+	minFingers(minFingers), maxFingers(maxFingers), minDuration(minDuration), maxDuration(maxDuration), minDistance(minDistance), maxDistance(maxDistance)
+{
+}
+
+void TouchLoadGenerator::SwipeModel::setup(Gesture & gesture, ci::Rand & rand) const {
+	const size_t minNumFingers = std::max((size_t)1, std::min(minFingers, kMaxFingers));
+	const size_t maxNumFingers = std::max(minNumFingers, std::min(maxFingers, kMaxFingers));
+	gesture.numFingers = minNumFingers + (size_t)rand.nextInt((int32_t)(maxNumFingers - minNumFingers + 1));
+	gesture.duration = rand.nextFloat(minDuration, maxDuration);
+	gesture.direction = rand.nextVec2() * rand.nextFloat(minDistance, maxDistance);
+	gesture.spread = rand.nextFloat(15.0f, 30.0f);
+}
+
+ci::vec2 TouchLoadGenerator::SwipeModel::getPosition(const Gesture & gesture, const size_t finger, const float t) const {
+	// fingers are lined up perpendicular to the swipe direction
+	const float length = glm::length(gesture.direction);
+	const vec2 normal = length > 0 ? vec2(-gesture.direction.y, gesture.direction.x) / length : vec2(1, 0);
+	const float offset = ((float)finger - 0.5f * (float)(gesture.numFingers - 1)) * gesture.spread;
+	return gesture.origin + normal * offset + gesture.direction * easeOutQuad(t);
+}
+
+TouchLoadGenerator::HoldModel::HoldModel(const float minDuration, const float maxDuration, const float jitter) :
+	minDuration(minDuration), maxDuration(maxDuration), jitter(jitter)
+{
+}
+
+void TouchLoadGenerator::HoldModel::setup(Gesture & gesture, ci::Rand & rand) const {
+	gesture.duration = rand.nextFloat(minDuration, maxDuration);
+	gesture.direction = rand.nextVec2() * jitter;
+	gesture.rotation = rand.nextFloat(5.0f, 15.0f);
+}
+
+ci::vec2 TouchLoadGenerator::HoldModel::getPosition(const Gesture & gesture, const size_t finger, const float t) const {
+	// deterministic wobble instead of random noise so positions only depend on t
+	return gesture.origin + gesture.direction * sin(t * gesture.duration * gesture.rotation);
+}
+
+//==================================================
+// Distributions and arrival curves
+//
+
+TouchLoadGenerator::SpatialDistribution TouchLoadGenerator::uniformDistribution() {
+	return [](Rand & rand, const Rectf & bounds) {
+		return vec2(rand.nextFloat(bounds.x1, bounds.x2), rand.nextFloat(bounds.y1, bounds.y2));
+	};
+}
+
+TouchLoadGenerator::SpatialDistribution TouchLoadGenerator::gaussianDistribution(const ci::vec2 center, const float deviation) {
+	return [=](Rand & rand, const Rectf & bounds) {
+		const vec2 relPos = center + vec2(rand.nextGaussian(), rand.nextGaussian()) * deviation;
+		const vec2 pos = bounds.getUpperLeft() + relPos * bounds.getSize();
+		return glm::clamp(pos, bounds.getUpperLeft(), bounds.getLowerRight());
+	};
+}
+
+TouchLoadGenerator::SpatialDistribution TouchLoadGenerator::hotspotDistribution(const std::vector<ci::vec2> & hotspots, const float radius) {
+	return [=](Rand & rand, const Rectf & bounds) {
+		if (hotspots.empty()) {
+			return bounds.getCenter();
+		}
+		const vec2 & hotspot = hotspots[rand.nextInt((int32_t)hotspots.size())];
+		const vec2 pos = bounds.getUpperLeft() + hotspot * bounds.getSize() + rand.nextVec2() * rand.nextFloat(radius);
+		return glm::clamp(pos, bounds.getUpperLeft(), bounds.getLowerRight());
+	};
+}
+
+TouchLoadGenerator::ArrivalCurve TouchLoadGenerator::constantArrivals(const float gesturesPerSecond) {
+	return [=](double time) {
+		return gesturesPerSecond;
+	};
+}
+
+TouchLoadGenerator::ArrivalCurve TouchLoadGenerator::rampArrivals(const float fromGesturesPerSecond, const float toGesturesPerSecond, const double duration) {
+	return [=](double time) {
+		const float t = duration > 0 ? (float)glm::clamp(time / duration, 0.0, 1.0) : 1.0f;
+		return glm::mix(fromGesturesPerSecond, toGesturesPerSecond, t);
+	};
+}
+
+TouchLoadGenerator::ArrivalCurve TouchLoadGenerator::burstArrivals(const float baseGesturesPerSecond, const float burstGesturesPerSecond, const double period, const double burstDuration) {
+	return [=](double time) {
+		if (period <= 0) {
+			return baseGesturesPerSecond;
+		}
+		return fmod(time, period) < burstDuration ? burstGesturesPerSecond : baseGesturesPerSecond;
+	};
+}
+
+//==================================================
+// Lifecycle
+//
+
+TouchLoadGenerator::TouchLoadGenerator(const uint32_t seed) :
+	mRand(seed),
+	mSeed(seed),
+	mTime(0),
+	mPrevUpdateTime(0),
+	mArrivalsToSpawn(0),
+	mTotalWeight(0),
+	mBounds(Rectf(0, 0, 1920, 1080)),
+	mSpatialDistribution(uniformDistribution()),
+	mArrivalCurve(constantArrivals(0)),
+	mSpawningEnabled(true),
+	mMaxNumTouches(10000),
+	mNumActiveTouches(0),
+	mNumGeneratedTouches(0),
+	mFirstTouchId(10000),
+	mTouchCounter(10000),
+	mTouchManager(TouchManager::get())
+{
+	mGestures.reserve(1024);
+	addGestureModel(make_shared<DragModel>());
+}
+
+TouchLoadGenerator::~TouchLoadGenerator() {
+	mUpdateConnection.disconnect();
+}
+
+void TouchLoadGenerator::reset(const uint32_t seed) {
+	endAllGestures();
+	mSeed = seed;
+	mRand.seed(seed);
+	mTime = 0;
+	mArrivalsToSpawn = 0;
+	mNumGeneratedTouches = 0;
+	mTouchCounter = mFirstTouchId;
+}
+
+void TouchLoadGenerator::start() {
+	if (isRunning()) {
+		return;
+	}
+	mPrevUpdateTime = getElapsedSeconds();
+	mUpdateConnection = AppBase::get()->getSignalUpdate().connect(bind(&TouchLoadGenerator::handleUpdate, this));
+}
+
+void TouchLoadGenerator::stop() {
+	mUpdateConnection.disconnect();
+}
+
+void TouchLoadGenerator::handleUpdate() {
+	const double currTime = getElapsedSeconds();
+	// avoid spawning huge batches after stalls (e.g. while loading or debugging)
+	const double deltaTime = std::min(currTime - mPrevUpdateTime, 15.0 / (double)getFrameRate());
+	mPrevUpdateTime = currTime;
+	update(deltaTime);
+}
+
+//==================================================
+// Models
+//
+
+void TouchLoadGenerator::addGestureModel(GestureModelRef model, const float weight) {
+	if (!model || weight <= 0) {
+		return;
+	}
+	mModels.push_back({model, weight});
+	mTotalWeight += weight;
+}
+
+void TouchLoadGenerator::clearGestureModels() {
+	endAllGestures();
+	mModels.clear();
+	mTotalWeight = 0;
+}
+
+//==================================================
+// Update
+//
+
+void TouchLoadGenerator::update(const double deltaTime) {
+	mTime += deltaTime;
+
+	// advance active gestures; finished gestures are swapped out so the vector stays dense
+	for (size_t i = 0; i < mGestures.size();) {
+		Gesture & gesture = mGestures[i];
+		const float t = gesture.duration > 0 ? (float)((mTime - gesture.startTime) / gesture.duration) : 1.0f;
+
+		if (t >= 1.0f) {
+			emitGesture(gesture, TouchPhase::Ended, 1.0f);
+			mNumActiveTouches -= gesture.numFingers;
+			gesture = mGestures.back();
+			mGestures.pop_back();
+			continue;
+		}
+
+		if (!gesture.model->isStationary()) {
+			emitGesture(gesture, TouchPhase::Moved, t);
+		}
+
+		++i;
+	}
+
+	// spawn new gestures
+	if (mSpawningEnabled && mArrivalCurve && !mModels.empty()) {
+		mArrivalsToSpawn += std::max(0.0, (double)mArrivalCurve(mTime) * deltaTime);
+
+		while (mArrivalsToSpawn >= 1.0) {
+			spawnGesture();
+			mArrivalsToSpawn -= 1.0;
+		}
+	}
+}
+
+void TouchLoadGenerator::spawnGesture() {
+	// pick a model by weight
+	float weight = mRand.nextFloat(mTotalWeight);
+	const GestureModel * model = mModels.back().model.get();
+
+	for (const auto & weightedModel : mModels) {
+		if (weight < weightedModel.weight) {
+			model = weightedModel.model.get();
+			break;
+		}
+		weight -= weightedModel.weight;
+	}
+
+	Gesture gesture;
+	gesture.model = model;
+	gesture.startTime = mTime;
+	gesture.origin = mSpatialDistribution ? mSpatialDistribution(mRand, mBounds) : mBounds.getCenter();
+	model->setup(gesture, mRand);
+	gesture.numFingers = std::max((size_t)1, std::min(gesture.numFingers, (size_t)kMaxFingers));
+
+	if (mNumActiveTouches + gesture.numFingers > mMaxNumTouches) {
+		return;
+	}
+
+	for (size_t i = 0; i < gesture.numFingers; ++i) {
+		gesture.ids[i] = mTouchCounter++;
+	}
+
+	mNumActiveTouches += gesture.numFingers;
+	mGestures.push_back(gesture);
+	emitGesture(gesture, TouchPhase::Began, 0);
+}
+
+void TouchLoadGenerator::endAllGestures() {
+	for (const auto & gesture : mGestures) {
+		const float t = gesture.duration > 0 ? glm::clamp((float)((mTime - gesture.startTime) / gesture.duration), 0.0f, 1.0f) : 1.0f;
+		emitGesture(gesture, TouchPhase::Ended, t);
+	}
+	mGestures.clear();
+	mNumActiveTouches = 0;
+}
+
+inline void TouchLoadGenerator::emitGesture(const Gesture & gesture, const TouchPhase phase, const float t) {
+	for (size_t i = 0; i < gesture.numFingers; ++i) {
+		emitTouch(gesture.ids[i], gesture.model->getPosition(gesture, i, t), phase);
+	}
+}
+
+inline void TouchLoadGenerator::emitTouch(const int id, const ci::vec2 & position, const TouchPhase phase) {
+	Touch touch(id, position, TouchType::Simulator, phase);
+	mNumGeneratedTouches++;
+
+	if (mTouchHandler) {
+		mTouchHandler(touch);
+	} else if (mTouchManager) {
+		mTouchManager->addTouch(touch);
+	}
+}
+
+}
+}
+}
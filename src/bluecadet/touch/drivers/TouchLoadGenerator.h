@@ -0,0 +1,225 @@
+#pragma once
+#include "cinder/app/App.h"
+#include "cinder/Rand.h"
+#include "cinder/Signals.h"
+
+#include "../TouchManager.h"
+
+namespace bluecadet {
+namespace touch {
+namespace drivers {
+
+typedef std::shared_ptr<class TouchLoadGenerator> TouchLoadGeneratorRef;
+
+//! Generates synthetic touch load for stress tests and benchmarks.
+//!
+//! New gestures are spawned based on an arrival curve (gestures per second over time), placed using a
+//! spatial distribution and animated by weighted gesture models (tap, drag, pinch, swipe, hold or custom).
+//! All randomness comes from a single seeded ci::Rand and all timing from the delta times passed to
+//! update(), so two generators with the same seed and the same sequence of update() calls produce
+//! identical touches. The generator doesn't depend on a window and can run headless by calling
+//! update() manually; use start() to drive it from the app's update signal instead.
+class TouchLoadGenerator {
+
+public:
+
+	static const size_t kMaxFingers = 5;
+
+	class GestureModel;
+
+	//! State of a single active gesture. Models use the generic parameters as they see fit.
+	struct Gesture {
+		const GestureModel *	model = nullptr;
+		double		startTime	= 0;
+		float		duration	= 0;
+		ci::vec2	origin		= ci::vec2(0);	//! Spawn position in window coordinates
+		ci::vec2	direction	= ci::vec2(0);	//! Direction and distance of travel
+		float		scale		= 1.0f;			//! Relative change in finger spread
+		float		rotation	= 0;			//! Change in finger angle in radians
+		float		spread		= 0;			//! Distance between fingers
+		size_t		numFingers	= 1;
+		int			ids[kMaxFingers];
+	};
+
+	//! Describes how a gesture moves. Models are stateless and can be shared between generators.
+	class GestureModel {
+	public:
+		virtual ~GestureModel() {}
+
+		//! Randomizes the gesture's parameters. Origin and start time are already set.
+		virtual void		setup(Gesture & gesture, ci::Rand & rand) const = 0;
+
+		//! Returns the position of finger at progress t (0-1) in window coordinates.
+		virtual ci::vec2	getPosition(const Gesture & gesture, const size_t finger, const float t) const = 0;
+
+		//! Stationary gestures don't send moved touches.
+		virtual bool		isStationary() const { return false; }
+	};
+	typedef std::shared_ptr<GestureModel> GestureModelRef;
+
+	//! Single finger that begins and ends in place.
+	class TapModel : public GestureModel {
+	public:
+		TapModel(const float minDuration = 0.05f, const float maxDuration = 0.15f);
+		void		setup(Gesture & gesture, ci::Rand & rand) const override;
+		ci::vec2	getPosition(const Gesture & gesture, const size_t finger, const float t) const override { return gesture.origin; }
+		bool		isStationary() const override { return true; }
+		float minDuration, maxDuration;
+	};
+
+	//! Single finger that travels in a random direction with ease-in-out.
+	class DragModel : public GestureModel {
+	public:
+		DragModel(const float minDuration = 0, const float maxDuration = 1.0f, const float minDistance = 0, const float maxDistance = 200.0f);
+		void		setup(Gesture & gesture, ci::Rand & rand) const override;
+		ci::vec2	getPosition(const Gesture & gesture, const size_t finger, const float t) const override;
+		float minDuration, maxDuration, minDistance, maxDistance;
+	};
+
+	//! Two fingers that move apart or together around the origin while rotating.
+	class PinchModel : public GestureModel {
+	public:
+		PinchModel(const float minDuration = 0.5f, const float maxDuration = 1.5f, const float minScale = 0.5f, const float maxScale = 2.0f, const float maxRotation = 1.0f);
+		void		setup(Gesture & gesture, ci::Rand & rand) const override;
+		ci::vec2	getPosition(const Gesture & gesture, const size_t finger, const float t) const override;
+		float minDuration, maxDuration, minScale, maxScale, maxRotation;
+	};
+
+	//! Multiple parallel fingers that quickly travel in the same direction.
+	class SwipeModel : public GestureModel {
+	public:
+		SwipeModel(const size_t minFingers = 2, const size_t maxFingers = 4, const float minDuration = 0.1f, const float maxDuration = 0.3f, const float minDistance = 100.0f, const float maxDistance = 400.0f);
+		void		setup(Gesture & gesture, ci::Rand & rand) const override;
+		ci::vec2	getPosition(const Gesture & gesture, const size_t finger, const float t) const override;
+		size_t minFingers, maxFingers;
+		float minDuration, maxDuration, minDistance, maxDistance;
+	};
+
+	//! Single finger that rests in place for a long time with a small amount of jitter.
+	class HoldModel : public GestureModel {
+	public:
+		HoldModel(const float minDuration = 2.0f, const float maxDuration = 6.0f, const float jitter = 2.0f);
+		void		setup(Gesture & gesture, ci::Rand & rand) const override;
+		ci::vec2	getPosition(const Gesture & gesture, const size_t finger, const float t) const override;
+		float minDuration, maxDuration, jitter;
+	};
+
+	//! Returns a spawn position within bounds.
+	typedef std::function<ci::vec2(ci::Rand & rand, const ci::Rectf & bounds)> SpatialDistribution;
+
+	//! Returns the number of gestures to spawn per second at time (in seconds since the generator started).
+	typedef std::function<float(double time)> ArrivalCurve;
+
+	//! Receives each generated touch. Defaults to adding touches to the generator's touch manager.
+	typedef std::function<void(Touch & touch)> TouchHandler;
+
+	//! Spatial distributions
+	static SpatialDistribution	uniformDistribution();
+	//! Normal distribution around a relative center (0-1) with a relative standard deviation.
+	static SpatialDistribution	gaussianDistribution(const ci::vec2 center = ci::vec2(0.5f), const float deviation = 0.15f);
+	//! Spawns around a set of relative hotspots (0-1) within radius in window coordinates.
+	static SpatialDistribution	hotspotDistribution(const std::vector<ci::vec2> & hotspots, const float radius = 50.0f);
+
+	//! Arrival curves
+	static ArrivalCurve			constantArrivals(const float gesturesPerSecond);
+	//! Ramps linearly from one rate to another over duration seconds, then holds.
+	static ArrivalCurve			rampArrivals(const float fromGesturesPerSecond, const float toGesturesPerSecond, const double duration);
+	//! Alternates between a base rate and a burst rate. Each burst lasts burstDuration seconds and repeats every period seconds.
+	static ArrivalCurve			burstArrivals(const float baseGesturesPerSecond, const float burstGesturesPerSecond, const double period, const double burstDuration);
+
+	TouchLoadGenerator(const uint32_t seed = 0);
+	~TouchLoadGenerator();
+
+	//! Resets the random generator and time and ends all active gestures.
+	void	reset(const uint32_t seed);
+	void	reset() { reset(mSeed); }
+
+	//! Advances all gestures by deltaTime seconds and spawns new ones based on the arrival curve.
+	void	update(const double deltaTime);
+
+	//! Ends all active gestures immediately.
+	void	endAllGestures();
+
+	//! Connects update() to the app's update signal using the app's elapsed time.
+	void	start();
+	void	stop();
+	bool	isRunning() const { return mUpdateConnection.isConnected(); }
+
+	//! When disabled, no new gestures are spawned but active gestures play out. Defaults to true.
+	bool	isSpawningEnabled() const				{ return mSpawningEnabled; }
+	void	setSpawningEnabled(const bool value)	{ mSpawningEnabled = value; }
+
+	//! Adds a gesture model that is picked relative to the weights of all models. The default is a single DragModel.
+	void	addGestureModel(GestureModelRef model, const float weight = 1.0f);
+	void	clearGestureModels();
+
+	//! Spawn area in window coordinates.
+	const ci::Rectf &	getBounds() const						{ return mBounds; }
+	void				setBounds(const ci::Rectf & value)		{ mBounds = value; }
+
+	//! Defaults to uniformDistribution().
+	void	setSpatialDistribution(SpatialDistribution value)	{ mSpatialDistribution = value; }
+
+	//! Defaults to constantArrivals(0).
+	void	setArrivalCurve(ArrivalCurve value)					{ mArrivalCurve = value; }
+	void	setGesturesPerSecond(const float value)				{ mArrivalCurve = constantArrivals(value); }
+	float	getGesturesPerSecond() const						{ return mArrivalCurve ? mArrivalCurve(mTime) : 0; }
+
+	//! Caps the number of concurrent touches. Arrivals beyond this are dropped. Defaults to 10,000.
+	size_t	getMaxNumTouches() const				{ return mMaxNumTouches; }
+	void	setMaxNumTouches(const size_t value)	{ mMaxNumTouches = value; }
+
+	//! Ids of generated touches start at this value. Defaults to 10,000.
+	int		getFirstTouchId() const					{ return mFirstTouchId; }
+	void	setFirstTouchId(const int value)		{ mFirstTouchId = value; }
+
+	//! Touches are added to this touch manager unless a touch handler is set. Defaults to TouchManager::get().
+	TouchManagerRef	getTouchManager() const					{ return mTouchManager; }
+	void			setTouchManager(TouchManagerRef value)	{ mTouchManager = value; }
+	void			setTouchHandler(TouchHandler value)		{ mTouchHandler = value; }
+
+	double	getTime() const					{ return mTime; }
+	size_t	getNumActiveGestures() const	{ return mGestures.size(); }
+	size_t	getNumActiveTouches() const		{ return mNumActiveTouches; }
+	size_t	getNumGeneratedTouches() const	{ return mNumGeneratedTouches; }
+
+protected:
+	void	handleUpdate();
+	void	spawnGesture();
+	void	emitGesture(const Gesture & gesture, const TouchPhase phase, const float t);
+	void	emitTouch(const int id, const ci::vec2 & position, const TouchPhase phase);
+
+	struct WeightedModel {
+		GestureModelRef	model;
+		float			weight;
+	};
+
+	ci::Rand					mRand;
+	uint32_t					mSeed;
+	double						mTime;
+	double						mPrevUpdateTime;
+	double						mArrivalsToSpawn;
+
+	std::vector<Gesture>		mGestures;		//! Active gestures. Unordered; finished gestures are swapped with the last one.
+	std::vector<WeightedModel>	mModels;
+	float						mTotalWeight;
+
+	ci::Rectf					mBounds;
+	SpatialDistribution			mSpatialDistribution;
+	ArrivalCurve				mArrivalCurve;
+	bool						mSpawningEnabled;
+
+	size_t						mMaxNumTouches;
+	size_t						mNumActiveTouches;
+	size_t						mNumGeneratedTouches;
+	int							mFirstTouchId;
+	int							mTouchCounter;
+
+	TouchManagerRef				mTouchManager;
+	TouchHandler				mTouchHandler;
+	ci::signals::Connection		mUpdateConnection;
+};
+
+}
+}
+}
@@ -0,0 +1,207 @@
+#include "TouchLatencyPlugin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+namespace plugins {
+
+namespace {
+	// bounds mPendingTouches if frameDidPresent() isn't called
+	const double kMaxPendingAge = 1.0;
+	const size_t kMaxPendingTouches = 1024;
+}
+
+//==================================================
+// Histogram
+//
+
+TouchLatencyPlugin::Histogram::Histogram(const double bucketSize, const double maxValue) :
+	mBucketSize(bucketSize),
+	mBuckets((size_t)ceil(maxValue / bucketSize) + 1, 0), // last bucket collects overflow
+	mNumSamples(0),
+	mSum(0),
+	mMax(0)
+{
+}
+
+void TouchLatencyPlugin::Histogram::addSample(const double value) {
+	const double clampedValue = std::max(0.0, value);
+	const size_t index = std::min((size_t)(clampedValue / mBucketSize), mBuckets.size() - 1);
+	mBuckets[index]++;
+	mNumSamples++;
+	mSum += clampedValue;
+	mMax = std::max(mMax, clampedValue);
+}
+
+void TouchLatencyPlugin::Histogram::reset() {
+	std::fill(mBuckets.begin(), mBuckets.end(), 0);
+	mNumSamples = 0;
+	mSum = 0;
+	mMax = 0;
+}
+
+double TouchLatencyPlugin::Histogram::getPercentile(const double percentile) const {
+	if (mNumSamples == 0) {
+		return 0;
+	}
+
+	const size_t targetCount = std::max((size_t)1, (size_t)ceil(percentile * (double)mNumSamples));
+	size_t count = 0;
+
+	for (size_t i = 0; i < mBuckets.size(); ++i) {
+		count += mBuckets[i];
+		if (count >= targetCount) {
+			// use the upper bound of the bucket, but never report more than the max sample
+			return std::min((double)(i + 1) * mBucketSize, mMax);
+		}
+	}
+
+	return mMax;
+}
+
+//==================================================
+// Lifecycle
+//
+
+TouchLatencyPlugin::TouchLatencyPlugin() :
+	TouchManagerPlugin(),
+	mDequeueTime(0),
+	mWindowStartTime(0),
+	mWindowDuration(1.0)
+{
+	mPendingTouches.reserve(256);
+}
+
+TouchLatencyPlugin::~TouchLatencyPlugin() {
+}
+
+void TouchLatencyPlugin::reset() {
+	for (auto & histogram : mHistograms) histogram.reset();
+	for (auto & histogram : mWindowHistograms) histogram.reset();
+	mWindowStats.fill(Stats());
+	mPendingTouches.clear();
+	mWindowStartTime = getTouchTime();
+}
+
+//==================================================
+// Measurements
+//
+
+void TouchLatencyPlugin::preUpdate(TouchManager * manager, std::deque<Touch> & touches) {
+	mDequeueTime = getTouchTime();
+
+	for (const auto & touch : touches) {
+		if (touch.isVirtual || touch.timestamp <= 0 || touch.dequeueTime <= 0) {
+			continue;
+		}
+		addSample(Phase::Queue, touch.dequeueTime - touch.timestamp);
+	}
+}
+
+void TouchLatencyPlugin::processEvent(TouchManager * manager, const TouchEvent & event) {
+	if (event.timestamp <= 0) {
+		return;
+	}
+
+	const double dispatchTime = getTouchTime();
+
+	// touches canceled outside of TouchManager::update() weren't dequeued this frame
+	if (mDequeueTime >= event.timestamp) {
+		addSample(Phase::Dispatch, dispatchTime - mDequeueTime);
+	}
+
+	// pending touches are ordered by dispatch time, so expired ones are at the front
+	auto firstPending = mPendingTouches.begin();
+
+	while (firstPending != mPendingTouches.end() && dispatchTime - firstPending->dispatchTime > kMaxPendingAge) {
+		++firstPending;
+	}
+
+	if (mPendingTouches.end() - firstPending >= (ptrdiff_t)kMaxPendingTouches) {
+		firstPending = mPendingTouches.end() - (kMaxPendingTouches - 1);
+	}
+
+	mPendingTouches.erase(mPendingTouches.begin(), firstPending);
+	mPendingTouches.push_back({event.timestamp, dispatchTime});
+}
+
+void TouchLatencyPlugin::frameDidPresent() {
+	const double presentTime = getTouchTime();
+
+	for (const auto & pending : mPendingTouches) {
+		addSample(Phase::Present, presentTime - pending.dispatchTime);
+		addSample(Phase::Total, presentTime - pending.timestamp);
+	}
+
+	mPendingTouches.clear();
+
+	if (mWindowStartTime <= 0) {
+		mWindowStartTime = presentTime;
+	}
+
+	if (presentTime - mWindowStartTime >= mWindowDuration) {
+		for (size_t i = 0; i < kNumPhases; ++i) {
+			mWindowStats[i] = getStats(mWindowHistograms[i]);
+			mWindowHistograms[i].reset();
+		}
+		mWindowStartTime = presentTime;
+	}
+}
+
+inline void TouchLatencyPlugin::addSample(const Phase phase, const double value) {
+	mHistograms[(size_t)phase].addSample(value);
+	mWindowHistograms[(size_t)phase].addSample(value);
+}
+
+//==================================================
+// Export
+//
+
+TouchLatencyPlugin::Stats TouchLatencyPlugin::getStats(const Histogram & histogram) {
+	Stats stats;
+	stats.p50 = histogram.getPercentile(0.5);
+	stats.p95 = histogram.getPercentile(0.95);
+	stats.p99 = histogram.getPercentile(0.99);
+	stats.mean = histogram.getMean();
+	stats.max = histogram.getMax();
+	stats.count = histogram.getNumSamples();
+	return stats;
+}
+
+std::string TouchLatencyPlugin::getPhaseName(const Phase phase) {
+	switch (phase) {
+		case Phase::Queue: return "queue";
+		case Phase::Dispatch: return "dispatch";
+		case Phase::Present: return "present";
+		case Phase::Total: return "total";
+		default: return "unknown";
+	}
+}
+
+std::string TouchLatencyPlugin::getSummary() const {
+	stringstream stream;
+	stream << fixed << setprecision(2);
+
+	for (size_t i = 0; i < kNumPhases; ++i) {
+		const Stats stats = getStats(mHistograms[i]);
+		stream << getPhaseName((Phase)i) << ": "
+			<< "p50 " << stats.p50 * 1000.0 << "ms, "
+			<< "p95 " << stats.p95 * 1000.0 << "ms, "
+			<< "p99 " << stats.p99 * 1000.0 << "ms, "
+			<< "max " << stats.max * 1000.0 << "ms "
+			<< "(" << stats.count << " samples)" << endl;
+	}
+
+	return stream.str();
+}
+
+}
+}
+}
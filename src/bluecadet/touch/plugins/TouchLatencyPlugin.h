@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../TouchManagerPlugin.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace bluecadet {
+namespace touch {
+namespace plugins {
+
+typedef std::shared_ptr<class TouchLatencyPlugin> TouchLatencyPluginRef;
+
+//! Measures how long touches take from the driver to the screen.
+//!
+//! Touches are timestamped by their driver (see Touch::timestamp) and again when the TouchManager
+//! picks them up. This plugin adds the time at which each touch was dispatched to its view and the time
+//! at which the frame that reflects it has finished drawing (call frameDidPresent() at the end of draw()).
+//! Latencies are collected in histograms per phase so that percentiles can be exported or plotted.
+class TouchLatencyPlugin : public TouchManagerPlugin {
+
+public:
+
+	enum class Phase {
+		Queue,		//! Driver to main thread (time spent in the touch queue)
+		Dispatch,	//! Main thread to view (hit-testing, plugins and event handlers)
+		Present,	//! View to end of the frame's draw
+		Total,		//! Driver to end of the frame's draw
+		NumPhases
+	};
+
+	//! Histogram with fixed-size buckets. Adding samples is O(1), percentiles are O(numBuckets).
+	class Histogram {
+	public:
+		//! Bucket size and maximum tracked latency in seconds. Anything above maxValue is counted in an overflow bucket.
+		Histogram(const double bucketSize = 0.0001, const double maxValue = 0.25);
+
+		void	addSample(const double value);
+		void	reset();
+
+		//! Returns the value in seconds below which `percentile` (0-1) of all samples fall. 0 if there are no samples.
+		double	getPercentile(const double percentile) const;
+
+		size_t	getNumSamples() const	{ return mNumSamples; }
+		double	getMean() const			{ return mNumSamples > 0 ? mSum / (double)mNumSamples : 0; }
+		double	getMax() const			{ return mMax; }
+
+	protected:
+		double				mBucketSize;
+		std::vector<size_t>	mBuckets;
+		size_t				mNumSamples;
+		double				mSum;
+		double				mMax;
+	};
+
+	//! Summary of a histogram. All values are in seconds.
+	struct Stats {
+		double p50		= 0;
+		double p95		= 0;
+		double p99		= 0;
+		double mean		= 0;
+		double max		= 0;
+		size_t count	= 0;
+	};
+
+	TouchLatencyPlugin();
+	~TouchLatencyPlugin();
+
+	//! Call at the very end of each frame's draw (after all views are drawn) to measure present latencies.
+	//! Touches that aren't presented within a second are dropped without being measured.
+	void				frameDidPresent();
+
+	//! Histograms for all samples since the last reset.
+	const Histogram &	getHistogram(const Phase phase) const	{ return mHistograms[(size_t)phase]; }
+	Stats				getStats(const Phase phase) const		{ return getStats(getHistogram(phase)); }
+
+	//! Stats of the most recently completed window (see getWindowDuration()). Useful for live graphs.
+	const Stats &		getWindowStats(const Phase phase) const	{ return mWindowStats[(size_t)phase]; }
+
+	//! The duration in seconds over which window stats are collected. Defaults to 1.
+	double				getWindowDuration() const				{ return mWindowDuration; }
+	void				setWindowDuration(const double value)	{ mWindowDuration = value; }
+
+	//! Clears all histograms and window stats.
+	void				reset();
+
+	//! Human readable p50/p95/p99 summary in milliseconds for all phases. Can be logged or written to a file.
+	std::string			getSummary() const;
+
+	static std::string	getPhaseName(const Phase phase);
+	static Stats		getStats(const Histogram & histogram);
+
+protected:
+
+	void preUpdate(TouchManager * manager, std::deque<Touch> & touches) override;
+	void processEvent(TouchManager * manager, const TouchEvent & event) override;
+
+	inline void addSample(const Phase phase, const double value);
+
+	struct PendingTouch {
+		double timestamp;
+		double dispatchTime;
+	};
+
+	static const size_t kNumPhases = (size_t)Phase::NumPhases;
+
+	std::array<Histogram, kNumPhases>	mHistograms;
+	std::array<Histogram, kNumPhases>	mWindowHistograms;
+	std::array<Stats, kNumPhases>		mWindowStats;
+
+	std::vector<PendingTouch>			mPendingTouches;	//! Dispatched touches that haven't been drawn yet
+
+	double								mDequeueTime;
+	double								mWindowStartTime;
+	double								mWindowDuration;
+};
+
+}
+}
+}
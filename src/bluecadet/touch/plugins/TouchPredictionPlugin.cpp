@@ -0,0 +1,328 @@
+#include "TouchPredictionPlugin.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+namespace plugins {
+
+namespace {
+	//! Weight of new measurements in the smoothed frame timings
+	const double kTimingSmoothing = 0.1;
+}
+
+//==================================================
+// Lifecycle
+//
+
+TouchPredictionPlugin::TouchPredictionPlugin(const Predictor predictor) :
+	TouchManagerPlugin(),
+	mPredictor(predictor),
+	mDisplayLatency(0),
+	mFrameTime(0),
+	mFrameInterval(0),
+	mPresentDelay(-1),
+	mMaxPredictionDistance(100.0f),
+	mNumLinearSamples(4),
+	mMinCutoff(1.0f),
+	mBeta(0.05f),
+	mProcessNoise(2000.0f),
+	mMeasurementNoise(2.0f),
+	mTouchSlots(16),
+	mErrorSum(0),
+	mRawErrorSum(0)
+{
+}
+
+TouchPredictionPlugin::~TouchPredictionPlugin() {
+}
+
+//==================================================
+// Frame timing
+//
+
+void TouchPredictionPlugin::frameDidPresent() {
+	if (mFrameTime <= 0) {
+		return;
+	}
+
+	const double delay = getTouchTime() - mFrameTime;
+	mPresentDelay = mPresentDelay >= 0 ? mPresentDelay + (delay - mPresentDelay) * kTimingSmoothing : delay;
+}
+
+TouchPredictionPlugin::TrackedTouch & TouchPredictionPlugin::getTrackedTouch(const int touchId, const bool reset) {
+	TouchSlotTable::Handle handle = mTouchSlots.find(touchId);
+	const bool isNew = !handle.isValid();
+
+	if (isNew) {
+		handle = mTouchSlots.insert(touchId);
+	}
+
+	// slots are reused, so tracked touches are indexed by slot
+	if (mTrackedTouches.size() <= handle.index) {
+		mTrackedTouches.resize(handle.index + 1);
+	}
+
+	TrackedTouch & tracked = mTrackedTouches[handle.index];
+
+	if (isNew || reset) {
+		tracked = TrackedTouch();
+	}
+
+	return tracked;
+}
+
+//==================================================
+// Prediction
+//
+
+void TouchPredictionPlugin::preUpdate(TouchManager * manager, std::deque<Touch> & touches) {
+	const double frameTime = getTouchTime();
+
+	if (mFrameTime > 0) {
+		const double interval = frameTime - mFrameTime;
+		mFrameInterval = mFrameInterval > 0 ? mFrameInterval + (interval - mFrameInterval) * kTimingSmoothing : interval;
+	}
+
+	mFrameTime = frameTime;
+
+	// all touches of this frame are predicted to when it will be on screen
+	const double targetTime = frameTime + getPresentDelay() + mDisplayLatency;
+
+	for (auto & touch : touches) {
+		if (touch.isVirtual) {
+			continue;
+		}
+
+		const double time = touch.timestamp > 0 ? touch.timestamp : touch.dequeueTime;
+
+		if (touch.phase == TouchPhase::Began) {
+			addSample(getTrackedTouch(touch.id, true), touch.appPosition, time);
+			continue;
+		}
+
+		if (touch.phase == TouchPhase::Ended) {
+			const TouchSlotTable::Handle handle = mTouchSlots.find(touch.id);
+
+			if (handle.isValid()) {
+				TrackedTouch & tracked = mTrackedTouches[handle.index];
+				addSample(tracked, touch.appPosition, time);
+				verifyPredictions(tracked);
+				mTouchSlots.erase(touch.id);
+			}
+			continue;
+		}
+
+		// moved touches that began before this plugin was added start a new history
+		TrackedTouch & tracked = getTrackedTouch(touch.id, false);
+
+		addSample(tracked, touch.appPosition, time);
+		verifyPredictions(tracked);
+
+		if (tracked.numSamples < 2) {
+			continue;
+		}
+
+		vec2 predicted = mPredictor == Predictor::Linear ? predictLinear(tracked, targetTime) : predictKalmanOneEuro(tracked, targetTime);
+
+		// limit overshoot
+		const vec2 offset = predicted - touch.appPosition;
+		const float distance = glm::length(offset);
+		if (distance > mMaxPredictionDistance && distance > 0) {
+			predicted = touch.appPosition + offset * (mMaxPredictionDistance / distance);
+		}
+
+		touch.hasPrediction = true;
+		touch.predictedAppPosition = predicted;
+
+		addPendingPrediction(tracked, predicted, touch.appPosition, targetTime);
+	}
+}
+
+void TouchPredictionPlugin::addSample(TrackedTouch & tracked, const ci::vec2 & position, const double time) {
+	if (tracked.numSamples == 0) {
+		tracked.head = 0;
+		tracked.history[0] = {position, time};
+		tracked.numSamples = 1;
+
+		// reset filters to the first position
+		const float measurementVariance = mMeasurementNoise * mMeasurementNoise;
+		tracked.kalmanX = KalmanAxis();
+		tracked.kalmanY = KalmanAxis();
+		tracked.kalmanX.position = position.x;
+		tracked.kalmanY.position = position.y;
+		tracked.kalmanX.p00 = tracked.kalmanY.p00 = measurementVariance;
+		tracked.kalmanX.p11 = tracked.kalmanY.p11 = mProcessNoise * mProcessNoise;
+		tracked.filteredVelocity = vec2(0);
+		return;
+	}
+
+	const float deltaTime = (float)(time - tracked.getSample(0).time);
+
+	if (deltaTime <= 0) {
+		// multiple samples with the same timestamp: keep the latest position
+		tracked.history[tracked.head].position = position;
+		return;
+	}
+
+	tracked.head = (tracked.head + 1) % kHistorySize;
+	tracked.history[tracked.head] = {position, time};
+	tracked.numSamples = std::min(tracked.numSamples + 1, (size_t)kHistorySize);
+
+	if (mPredictor == Predictor::KalmanOneEuro) {
+		updateKalman(tracked.kalmanX, position.x, deltaTime);
+		updateKalman(tracked.kalmanY, position.y, deltaTime);
+		updateOneEuro(tracked, deltaTime);
+	}
+}
+
+ci::vec2 TouchPredictionPlugin::predictLinear(const TrackedTouch & tracked, const double targetTime) const {
+	const Sample & latest = tracked.getSample(0);
+	const size_t numSamples = std::min(std::max(mNumLinearSamples, (size_t)2), tracked.numSamples);
+
+	// least-squares fit of velocity; times are relative to the latest sample to keep precision
+	double meanTime = 0;
+	vec2 meanPosition(0);
+
+	for (size_t i = 0; i < numSamples; ++i) {
+		const Sample & sample = tracked.getSample(i);
+		meanTime += sample.time - latest.time;
+		meanPosition += sample.position;
+	}
+
+	meanTime /= (double)numSamples;
+	meanPosition /= (float)numSamples;
+
+	double timeVariance = 0;
+	vec2 covariance(0);
+
+	for (size_t i = 0; i < numSamples; ++i) {
+		const Sample & sample = tracked.getSample(i);
+		const float deltaTime = (float)(sample.time - latest.time - meanTime);
+		timeVariance += deltaTime * deltaTime;
+		covariance += (sample.position - meanPosition) * deltaTime;
+	}
+
+	if (timeVariance <= 0) {
+		return latest.position;
+	}
+
+	const vec2 velocity = covariance / (float)timeVariance;
+	return latest.position + velocity * (float)(targetTime - latest.time);
+}
+
+ci::vec2 TouchPredictionPlugin::predictKalmanOneEuro(const TrackedTouch & tracked, const double targetTime) const {
+	const vec2 position(tracked.kalmanX.position, tracked.kalmanY.position);
+	return position + tracked.filteredVelocity * (float)(targetTime - tracked.getSample(0).time);
+}
+
+//==================================================
+// Filters
+//
+
+void TouchPredictionPlugin::updateKalman(KalmanAxis & axis, const float measurement, const float deltaTime) const {
+	const float dt = deltaTime;
+	const float dt2 = dt * dt;
+	const float q = mProcessNoise * mProcessNoise;
+	const float r = mMeasurementNoise * mMeasurementNoise;
+
+	// predict with constant velocity and white noise acceleration
+	axis.position += axis.velocity * dt;
+
+	const float p00 = axis.p00 + dt * (axis.p01 + axis.p10) + dt2 * axis.p11 + q * dt2 * dt2 * 0.25f;
+	const float p01 = axis.p01 + dt * axis.p11 + q * dt2 * dt * 0.5f;
+	const float p10 = axis.p10 + dt * axis.p11 + q * dt2 * dt * 0.5f;
+	const float p11 = axis.p11 + q * dt2;
+
+	// correct with measured position
+	const float innovation = measurement - axis.position;
+	const float s = p00 + r;
+	const float k0 = p00 / s;
+	const float k1 = p10 / s;
+
+	axis.position += k0 * innovation;
+	axis.velocity += k1 * innovation;
+
+	axis.p00 = (1.0f - k0) * p00;
+	axis.p01 = (1.0f - k0) * p01;
+	axis.p10 = p10 - k1 * p00;
+	axis.p11 = p11 - k1 * p01;
+}
+
+void TouchPredictionPlugin::updateOneEuro(TrackedTouch & tracked, const float deltaTime) const {
+	static const float twoPi = 2.0f * (float)M_PI;
+
+	// adaptive low-pass on the kalman velocity: heavy smoothing at low speeds to suppress jitter,
+	// light smoothing at high speeds to minimize lag
+	const vec2 velocity(tracked.kalmanX.velocity, tracked.kalmanY.velocity);
+	const float cutoff = mMinCutoff + mBeta * glm::length(velocity);
+	const float tau = 1.0f / (twoPi * cutoff);
+	const float alpha = 1.0f / (1.0f + tau / deltaTime);
+
+	tracked.filteredVelocity = glm::mix(tracked.filteredVelocity, velocity, alpha);
+}
+
+//==================================================
+// Error measurement
+//
+
+void TouchPredictionPlugin::addPendingPrediction(TrackedTouch & tracked, const ci::vec2 & predicted, const ci::vec2 & raw, const double targetTime) {
+	if (tracked.numPending == kMaxPendingPredictions) {
+		// drop the oldest prediction
+		tracked.pendingHead = (tracked.pendingHead + 1) % kMaxPendingPredictions;
+		tracked.numPending--;
+	}
+
+	const size_t index = (tracked.pendingHead + tracked.numPending) % kMaxPendingPredictions;
+	tracked.pending[index] = {predicted, raw, targetTime};
+	tracked.numPending++;
+}
+
+void TouchPredictionPlugin::verifyPredictions(TrackedTouch & tracked) {
+	const double latestTime = tracked.getSample(0).time;
+
+	while (tracked.numPending > 0) {
+		const PendingPrediction & prediction = tracked.pending[tracked.pendingHead];
+
+		if (prediction.targetTime > latestTime) {
+			// predictions are in chronological order
+			break;
+		}
+
+		// find the two samples around the target time and interpolate the actual position
+		for (size_t age = 0; age + 1 < tracked.numSamples; ++age) {
+			const Sample & next = tracked.getSample(age);
+			const Sample & prev = tracked.getSample(age + 1);
+
+			if (prev.time > prediction.targetTime) {
+				continue;
+			}
+
+			const double interval = next.time - prev.time;
+			const float t = interval > 0 ? (float)((prediction.targetTime - prev.time) / interval) : 1.0f;
+			const vec2 actual = glm::mix(prev.position, next.position, t);
+
+			const double error = (double)glm::distance(prediction.predicted, actual);
+			const double rawError = (double)glm::distance(prediction.raw, actual);
+
+			mErrorSum += error;
+			mRawErrorSum += rawError;
+			mErrorStats.count++;
+			mErrorStats.maxError = std::max(mErrorStats.maxError, error);
+			mErrorStats.meanError = mErrorSum / (double)mErrorStats.count;
+			mErrorStats.meanRawError = mRawErrorSum / (double)mErrorStats.count;
+			break;
+		}
+
+		tracked.pendingHead = (tracked.pendingHead + 1) % kMaxPendingPredictions;
+		tracked.numPending--;
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "../TouchManagerPlugin.h"
+#include "../TouchSlotTable.h"
+
+#include <array>
+#include <vector>
+
+namespace bluecadet {
+namespace touch {
+namespace plugins {
+
+typedef std::shared_ptr<class TouchPredictionPlugin> TouchPredictionPluginRef;
+
+//! Predicts where moving touches will be by the time the current frame is on screen.
+//!
+//! Keeps a short history of positions and driver timestamps per touch id and extrapolates each moved touch
+//! to the time at which the current frame is expected to be presented. That time is measured: call frameDidPresent()
+//! at the end of each frame's draw to track how long frames take from picking up touches to presenting them.
+//! Without those calls, frames are assumed to present one (measured) frame interval after touches are picked up. Predictions are
+//! stored in Touch::predictedAppPosition and delivered via TouchEvent::predictedGlobalPosition/predictedLocalPosition
+//! alongside the raw positions. Views opt in to use them (e.g. TouchView::setDragPredictionEnabled()).
+//!
+//! Each prediction is compared to the position that actually arrives at its target time, so the error
+//! can be monitored and the predictor tuned per installation.
+class TouchPredictionPlugin : public TouchManagerPlugin {
+
+public:
+
+	enum class Predictor {
+		Linear,			//! Least-squares velocity over the recent history. Responsive, but amplifies jitter.
+		KalmanOneEuro	//! Constant-velocity Kalman filter with a one-euro style adaptive low-pass on its velocity. Smooth at low speeds, responsive at high speeds.
+	};
+
+	//! Prediction error in app coordinates (pixels).
+	struct ErrorStats {
+		double	meanError		= 0;	//! Mean distance between predicted and actual positions
+		double	maxError		= 0;
+		double	meanRawError	= 0;	//! Mean distance between unpredicted (raw) and actual positions, for comparison
+		size_t	count			= 0;
+	};
+
+	TouchPredictionPlugin(const Predictor predictor = Predictor::KalmanOneEuro);
+	~TouchPredictionPlugin();
+
+	//! Defaults to KalmanOneEuro. Changing the predictor resets all touch histories.
+	Predictor	getPredictor() const					{ return mPredictor; }
+	void		setPredictor(const Predictor value)		{ mPredictor = value; mTouchSlots.clear(); }
+
+	//! Call at the very end of each frame's draw (after all views are drawn) to measure when frames are presented.
+	void		frameDidPresent();
+
+	//! Smoothed time in seconds from picking up touches to presenting the frame that reflects them.
+	double		getPresentDelay() const						{ return mPresentDelay >= 0 ? mPresentDelay : mFrameInterval; }
+
+	//! Time in seconds between the end of a frame's draw and it being visible (buffer swap, vsync and display),
+	//! which can't be measured in software. Added to the measured present time. Defaults to 0.
+	double		getDisplayLatency() const					{ return mDisplayLatency; }
+	void		setDisplayLatency(const double value)		{ mDisplayLatency = value; }
+
+	//! Caps how far predictions can be from the raw position to avoid overshooting on sudden stops. Defaults to 100.
+	float		getMaxPredictionDistance() const				{ return mMaxPredictionDistance; }
+	void		setMaxPredictionDistance(const float value)		{ mMaxPredictionDistance = value; }
+
+	//! Number of samples used by the linear predictor. Clamped to the history size. Defaults to 4.
+	size_t		getNumLinearSamples() const					{ return mNumLinearSamples; }
+	void		setNumLinearSamples(const size_t value)		{ mNumLinearSamples = value; }
+
+	//! One-euro filter parameters for the velocity low-pass: cutoff = minCutoff + beta * speed (in Hz). Defaults to 1 and 0.05.
+	//! Lower min cutoffs reduce jitter at low speeds, higher betas reduce lag at high speeds. See http://cristal.univ-lille.fr/~casiez/1euro/
+	float		getMinCutoff() const						{ return mMinCutoff; }
+	void		setMinCutoff(const float value)				{ mMinCutoff = value; }
+	float		getBeta() const								{ return mBeta; }
+	void		setBeta(const float value)					{ mBeta = value; }
+
+	//! Kalman filter noise parameters. Higher process noise follows changes in velocity faster.
+	float		getProcessNoise() const						{ return mProcessNoise; }
+	void		setProcessNoise(const float value)			{ mProcessNoise = value; }
+	float		getMeasurementNoise() const					{ return mMeasurementNoise; }
+	void		setMeasurementNoise(const float value)		{ mMeasurementNoise = value; }
+
+	//! Error of all predictions that have been verified since the last reset.
+	const ErrorStats &	getErrorStats() const				{ return mErrorStats; }
+	void				resetErrorStats()					{ mErrorStats = ErrorStats(); mErrorSum = 0; mRawErrorSum = 0; }
+
+protected:
+
+	void preUpdate(TouchManager * manager, std::deque<Touch> & touches) override;
+
+	static const size_t kHistorySize = 8;
+	static const size_t kMaxPendingPredictions = 16;
+
+	struct Sample {
+		ci::vec2	position;
+		double		time;
+	};
+
+	struct PendingPrediction {
+		ci::vec2	predicted;
+		ci::vec2	raw;
+		double		targetTime;
+	};
+
+	//! Constant velocity Kalman filter for one axis
+	struct KalmanAxis {
+		float	position = 0;
+		float	velocity = 0;
+		float	p00 = 1, p01 = 0, p10 = 0, p11 = 1; //! Covariance
+	};
+
+	struct TrackedTouch {
+		std::array<Sample, kHistorySize>					history;
+		size_t												numSamples	= 0;
+		size_t												head		= 0;	//! Index of the most recent sample
+
+		std::array<PendingPrediction, kMaxPendingPredictions>	pending;
+		size_t												numPending	= 0;
+		size_t												pendingHead	= 0;	//! Index of the oldest pending prediction
+
+		KalmanAxis											kalmanX;
+		KalmanAxis											kalmanY;
+		ci::vec2											filteredVelocity;
+
+		const Sample &	getSample(const size_t age) const	{ return history[(head + kHistorySize - age) % kHistorySize]; }
+	};
+
+	//! Returns the tracked state of touchId, starting a new history if it isn't tracked yet or if reset is true.
+	TrackedTouch &	getTrackedTouch(const int touchId, const bool reset);
+
+	void		addSample(TrackedTouch & tracked, const ci::vec2 & position, const double time);
+	ci::vec2	predictLinear(const TrackedTouch & tracked, const double targetTime) const;
+	ci::vec2	predictKalmanOneEuro(const TrackedTouch & tracked, const double targetTime) const;
+	void		verifyPredictions(TrackedTouch & tracked);
+	void		addPendingPrediction(TrackedTouch & tracked, const ci::vec2 & predicted, const ci::vec2 & raw, const double targetTime);
+
+	void		updateKalman(KalmanAxis & axis, const float measurement, const float deltaTime) const;
+	void		updateOneEuro(TrackedTouch & tracked, const float deltaTime) const;
+
+	Predictor					mPredictor;
+	double						mDisplayLatency;
+	double						mFrameTime;		//! Time at which touches were picked up this frame
+	double						mFrameInterval;	//! Smoothed time between frames
+	double						mPresentDelay;	//! Smoothed time from mFrameTime to frameDidPresent(). Negative until measured.
+	float						mMaxPredictionDistance;
+	size_t						mNumLinearSamples;
+	float						mMinCutoff;
+	float						mBeta;
+	float						mProcessNoise;
+	float						mMeasurementNoise;
+
+	TouchSlotTable				mTouchSlots;	//! Maps touch ids to indices in mTrackedTouches
+	std::vector<TrackedTouch>	mTrackedTouches;
+
+	ErrorStats					mErrorStats;
+	double						mErrorSum;
+	double						mRawErrorSum;
+};
+
+}
+}
+}
@@ -0,0 +1,64 @@
+#include "TouchRecorderPlugin.h"
+
+#include "cinder/Log.h"
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace touch {
+namespace plugins {
+
+TouchRecorderPlugin::TouchRecorderPlugin() :
+	TouchManagerPlugin(),
+	mStartTime(0),
+	mFrame(0)
+{
+}
+
+TouchRecorderPlugin::~TouchRecorderPlugin() {
+	stop();
+}
+
+bool TouchRecorderPlugin::start(const ci::fs::path & path) {
+	stop();
+
+	if (!mWriter.open(path)) {
+		return false;
+	}
+
+	mStartTime = getTouchTime();
+	mFrame = 0;
+
+	CI_LOG_I("Recording touches to '" << path << "'");
+	return true;
+}
+
+void TouchRecorderPlugin::stop() {
+	if (!mWriter.isOpen()) {
+		return;
+	}
+	mWriter.close();
+	CI_LOG_I("Stopped recording touches (" << mWriter.getNumRecords() << " touches in " << mFrame << " frames)");
+}
+
+void TouchRecorderPlugin::willBeRemovedFrom(TouchManager * manager) {
+	stop();
+}
+
+void TouchRecorderPlugin::preUpdate(TouchManager * manager, std::deque<Touch> & touches) {
+	if (!mWriter.isOpen()) {
+		return;
+	}
+
+	for (const auto & touch : touches) {
+		const double timestamp = touch.timestamp > 0 ? touch.timestamp : touch.dequeueTime;
+		mWriter.write(touch, std::max(0.0, timestamp - mStartTime), mFrame);
+	}
+
+	mFrame++;
+}
+
+}
+}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../TouchManagerPlugin.h"
+#include "../TouchRecording.h"
+
+namespace bluecadet {
+namespace touch {
+namespace plugins {
+
+typedef std::shared_ptr<class TouchRecorderPlugin> TouchRecorderPluginRef;
+
+//! Records all touches that reach the TouchManager into a binary log (see TouchRecording.h).
+//! Recordings can be played back with drivers::ReplayTouchDriver, e.g. to turn a busy day on the floor
+//! into a reproducible benchmark.
+class TouchRecorderPlugin : public TouchManagerPlugin {
+
+public:
+	TouchRecorderPlugin();
+	~TouchRecorderPlugin();
+
+	//! Starts recording to path. Any previous recording is stopped first. Returns false if the file can't be created.
+	bool	start(const ci::fs::path & path);
+
+	//! Stops recording and writes all remaining touches to disk.
+	void	stop();
+
+	bool	isRecording() const { return mWriter.isOpen(); }
+
+	//! Number of touches recorded since start() was called.
+	size_t	getNumRecords() const { return mWriter.getNumRecords(); }
+
+	//! Max number of touches per index block. Defaults to 1024.
+	size_t	getBlockSize() const { return mWriter.getBlockSize(); }
+	void	setBlockSize(const size_t value) { mWriter.setBlockSize(value); }
+
+protected:
+	void	willBeRemovedFrom(TouchManager * manager) override;
+	void	preUpdate(TouchManager * manager, std::deque<Touch> & touches) override;
+
+	TouchRecordingWriter	mWriter;
+	double					mStartTime;
+	uint32_t				mFrame;
+};
+
+}
+}
+}
@@ -9,25 +9,231 @@ using namespace std;
 namespace bluecadet {
 namespace views {
 
+//==================================================
+// Callback queue and cue pool
+// 
+
+namespace {
+	//! Growable FIFO ring buffer that reuses its slots
+	template <typename T>
+	class RingBuffer {
+	public:
+		RingBuffer(const size_t capacity) : mItems(max<size_t>(capacity, 1)), mHead(0), mSize(0) {}
+
+		void push(T && item) {
+			if (mSize == mItems.size()) {
+				grow();
+			}
+			mItems[(mHead + mSize) % mItems.size()] = std::move(item);
+			++mSize;
+		}
+
+		T & front() { return mItems[mHead]; }
+		void pop() { mHead = (mHead + 1) % mItems.size(); --mSize; }
+
+		size_t size() const { return mSize; }
+		bool empty() const { return mSize == 0; }
+
+	private:
+		void grow() {
+			vector<T> items(mItems.size() * 2);
+			for (size_t i = 0; i < mSize; ++i) {
+				items[i] = std::move(mItems[(mHead + i) % mItems.size()]);
+			}
+			mItems.swap(items);
+			mHead = 0;
+		}
+
+		vector<T>	mItems;
+		size_t		mHead;
+		size_t		mSize;
+	};
+
+	struct QueuedCallback {
+		AnimatedView::CallbackFn	fn;
+		bool						completed = false;
+	};
+
+	//! Max number of cues kept for reuse. Released cues beyond this are destroyed.
+	const size_t kMaxPooledCues = 1024;
+
+	//! Max number of pooled cues checked per acquire before a new cue is created.
+	const size_t kMaxCueLookups = 4;
+
+	RingBuffer<QueuedCallback> & getCallbackQueue() {
+		static RingBuffer<QueuedCallback> queue(256);
+		return queue;
+	}
+
+	RingBuffer<AnimatedView::CallbackCueRef> & getCuePool() {
+		static RingBuffer<AnimatedView::CallbackCueRef> pool(64);
+		return pool;
+	}
+}
+
+void AnimatedView::dispatchQueuedCallbacks() {
+	auto & queue = getCallbackQueue();
+
+	// callbacks queued during this loop are called during the next dispatch
+	for (size_t numCallbacks = queue.size(); numCallbacks > 0 && !queue.empty(); --numCallbacks) {
+		QueuedCallback & item = queue.front();
+		CallbackFn fn = std::move(item.fn);
+		const bool completed = item.completed;
+		item.fn = nullptr;
+		queue.pop();
+
+		if (fn) {
+			fn(completed);
+		}
+	}
+}
+
+size_t AnimatedView::getNumQueuedCallbacks() {
+	return getCallbackQueue().size();
+}
+
+void AnimatedView::queueCallback(CallbackFn && callback, const bool completed) {
+	QueuedCallback item;
+	item.fn = std::move(callback);
+	item.completed = completed;
+	getCallbackQueue().push(std::move(item));
+}
+
+void AnimatedView::dispatchCallback(CallbackFn & callback, const bool completed, const bool isAsync) {
+	if (!callback) {
+		return;
+	}
+	if (isAsync) {
+		queueCallback(std::move(callback), completed);
+	} else {
+		callback(completed);
+	}
+}
+
+AnimatedView::CallbackCueRef AnimatedView::acquireCue(const float time) {
+	auto & pool = getCuePool();
+	CallbackCueRef cue;
+
+	// cues are released in the order they're taken out of timelines, so the oldest ones are most likely free.
+	// cues that are still referenced (e.g. by timelines that haven't been stepped yet) are moved to the back.
+	for (size_t i = 0; i < kMaxCueLookups && i < pool.size(); ++i) {
+		CallbackCueRef candidate = std::move(pool.front());
+		pool.pop();
+
+		if (candidate.use_count() == 1) {
+			cue = std::move(candidate);
+			break;
+		}
+
+		pool.push(std::move(candidate));
+	}
+
+	if (!cue) {
+		cue = CallbackCueRef(new CallbackCue());
+	}
+
+	cue->recycle(this, time);
+	return cue;
+}
+
+void AnimatedView::releaseCue(CallbackCueRef & cue) {
+	if (!cue) {
+		return;
+	}
+
+	cue->mView = nullptr;
+
+	auto & pool = getCuePool();
+
+	if (pool.size() < kMaxPooledCues) {
+		pool.push(std::move(cue));
+	}
+
+	cue = nullptr;
+}
+
 //==================================================
 // Supporting Types
 // 
 
 AnimatedView::CallbackCue::CallbackCue(CallbackFn callback, float time) :
-	ci::Cue([=] {
-	mSignalCallback.emit(true); // success
-}, time) {
-	addCallback(callback);
+	ci::Cue([this] { notify(true, false); }, time),
+	mView(nullptr),
+	mIsNotified(false)
+{
+	addCallback(std::move(callback));
+}
+
+AnimatedView::CallbackCue::CallbackCue() :
+	ci::Cue([this] { notify(true, false); }, 0),
+	mView(nullptr),
+	mIsNotified(false)
+{
 }
 
 AnimatedView::CallbackCue::~CallbackCue() {
-	if (!isComplete()) {
-		mSignalCallback.emit(false); // canceled
+	if (!mIsNotified && !isComplete()) {
+		mView = nullptr;
+		notify(false, false); // canceled
+	}
+}
+
+void AnimatedView::CallbackCue::addCallback(CallbackFn callback, const bool isAsync) {
+	if (!callback) {
+		return;
+	}
+	Callback entry;
+	entry.fn = std::move(callback);
+	entry.isAsync = isAsync;
+	mCallbacks.push_back(std::move(entry));
+}
+
+void AnimatedView::CallbackCue::cancel() {
+	if (mIsNotified) {
+		return;
 	}
+	removeSelf();
+	mView = nullptr;
+	notify(false, true);
 }
 
-inline void AnimatedView::CallbackCue::addCallback(CallbackFn callback) {
-	mConnections += mSignalCallback.connect(callback);
+void AnimatedView::CallbackCue::recycle(AnimatedView * view, const float time) {
+	mParent = nullptr; // the timeline that contained this cue might not exist anymore
+	reset(true);
+	mMarkedForRemoval = false;
+	setStartTime(time);
+
+	mView = view;
+	mIsNotified = false;
+	mCallbacks.clear();
+}
+
+void AnimatedView::CallbackCue::notify(const bool completed, const bool deferSync) {
+	if (mIsNotified) {
+		return;
+	}
+
+	mIsNotified = true;
+
+	if (completed && mView) {
+		AnimatedView * view = mView;
+		mView = nullptr;
+		view->handleCueCompleted(this);
+	}
+
+	// sync callbacks can add more callbacks, so entries are accessed by index
+	for (size_t i = 0; i < mCallbacks.size(); ++i) {
+		CallbackFn fn = std::move(mCallbacks[i].fn);
+
+		if (mCallbacks[i].isAsync || deferSync) {
+			queueCallback(std::move(fn), completed);
+		} else if (fn) {
+			fn(completed);
+		}
+	}
+
+	mCallbacks.clear();
+	mSignalCallback.emit(completed);
 }
 
 //==================================================
@@ -43,32 +249,16 @@ AnimatedView::AnimatedView(bool showInitially) :
 }
 
 AnimatedView::~AnimatedView() {
+	cancelAnimationOn();
+	cancelAnimationOff();
 }
 
 void AnimatedView::animateOn(const Options & options, CallbackFn callback, bool isCallbackAsync) {
 	mIsInitialized = true; // override initial state
 
-	CallbackFn wrappedCallback = nullptr;
-	
-	if (callback) {
-		if (isCallbackAsync) {
-			wrappedCallback = [=] (bool completed) {
-				App::get()->dispatchAsync([=] {
-					if (callback) {
-						callback(completed);
-					}
-				});
-			};
-		} else {
-			wrappedCallback = callback;
-		}
-	}
-
 	if (mIsShowing && mShouldShow) {
-		// already showing; dispatch on next frame
-		if (wrappedCallback) {
-			wrappedCallback(true);
-		}
+		// already showing; async callbacks are dispatched on next frame
+		dispatchCallback(callback, true, isCallbackAsync);
 		return;
 	}
 
@@ -81,29 +271,22 @@ void AnimatedView::animateOn(const Options & options, CallbackFn callback, bool
 
 		addAnimationOn(getTimeline(), options);
 
-		mCueOn = make_shared<CallbackCue>([=](bool completed) {
-			if (completed) {
-				mIsShowing = true;
-				didAnimateOn();
-				mSignalDidAnimateOn.emit();
-			}
-			mCueOn = nullptr;
-
-		}, getTimeline()->getCurrentTime() + options.getDuration() + options.getDelay());
+		mCueOn = acquireCue(getTimeline()->getCurrentTime() + options.getDuration() + options.getDelay());
 
 		getTimeline()->insert(mCueOn);
+		requestAnimationStep(mCueOn->getStartTime());
 
 		willAnimateOn();
 		mSignalWillAnimateOn.emit();
 	}
 
-	if (wrappedCallback) {
+	if (callback) {
 		if (mCueOn) {
 			// add callback (multiple callbacks are possible)
-			mCueOn->getSignalCallback().connect(wrappedCallback);
+			mCueOn->addCallback(std::move(callback), isCallbackAsync);
 		} else {
 			// this can happen if willAnimateOn cancels the animation
-			wrappedCallback(false);
+			dispatchCallback(callback, false, isCallbackAsync);
 		}
 	}
 }
@@ -111,27 +294,9 @@ void AnimatedView::animateOn(const Options & options, CallbackFn callback, bool
 void AnimatedView::animateOff(const Options & options, CallbackFn callback, bool isCallbackAsync) {
 	mIsInitialized = true; // override initial state
 
-	CallbackFn wrappedCallback = nullptr;
-
-	if (callback) {
-		if (isCallbackAsync) {
-			wrappedCallback = [=] (bool completed) {
-				App::get()->dispatchAsync([=] {
-					if (callback) {
-						callback(completed);
-					}
-				});
-			};
-		} else {
-			wrappedCallback = callback;
-		}
-	}
-
 	if (!mIsShowing && !mShouldShow) {
-		// already hidden; dispatch on next frame
-		if (wrappedCallback) {
-			wrappedCallback(true);
-		}
+		// already hidden; async callbacks are dispatched on next frame
+		dispatchCallback(callback, true, isCallbackAsync);
 		return;
 	}
 
@@ -144,33 +309,42 @@ void AnimatedView::animateOff(const Options & options, CallbackFn callback, bool
 
 		addAnimationOff(getTimeline(), options);
 
-		mCueOff = make_shared<CallbackCue>([=](bool completed) {
-			if (completed) {
-				mIsShowing = false;
-				didAnimateOff();
-				mSignalDidAnimateOff.emit();
-			}
-			mCueOff = nullptr;
-		}, getTimeline()->getCurrentTime() + options.getDuration() + options.getDelay());
+		mCueOff = acquireCue(getTimeline()->getCurrentTime() + options.getDuration() + options.getDelay());
 
 		getTimeline()->insert(mCueOff);
+		requestAnimationStep(mCueOff->getStartTime());
 
 		willAnimateOff();
 		mSignalWillAnimateOff.emit();
 	}
 
-	if (wrappedCallback) {
+	if (callback) {
 		if (mCueOff) {
 			// add callback (multiple callbacks are possible)
-			mCueOff->getSignalCallback().connect(wrappedCallback);
+			mCueOff->addCallback(std::move(callback), isCallbackAsync);
 
 		} else {
 			// this can happen if willAnimateOff cancels the animation
-			wrappedCallback(false);
+			dispatchCallback(callback, false, isCallbackAsync);
 		}
 	}
 }
 
+void AnimatedView::handleCueCompleted(CallbackCue * cue) {
+	if (mCueOn && cue == mCueOn.get()) {
+		releaseCue(mCueOn);
+		mIsShowing = true;
+		didAnimateOn();
+		mSignalDidAnimateOn.emit();
+
+	} else if (mCueOff && cue == mCueOff.get()) {
+		releaseCue(mCueOff);
+		mIsShowing = false;
+		didAnimateOff();
+		mSignalDidAnimateOff.emit();
+	}
+}
+
 void AnimatedView::setToAnimatedOn() {
 	animateOn(Options().duration(0).easing(easeNone));
 	mShowInitially = true;
@@ -198,16 +372,18 @@ void AnimatedView::didMoveToView(BaseView * view) {
 
 void AnimatedView::cancelAnimationOn() {
 	if (mCueOn) {
-		mCueOn->removeSelf();
+		CallbackCueRef cue = mCueOn;
+		releaseCue(mCueOn);
+		cue->cancel();
 	}
-	mCueOn = nullptr;
 }
 
 void AnimatedView::cancelAnimationOff() {
 	if (mCueOff) {
-		mCueOff->removeSelf();
+		CallbackCueRef cue = mCueOff;
+		releaseCue(mCueOff);
+		cue->cancel();
 	}
-	mCueOff = nullptr;
 }
 
 void AnimatedView::cancelAnimations() {
@@ -23,7 +23,10 @@ typedef std::shared_ptr<class AnimatedView> AnimatedViewRef;
 //! When the animation gets canceled (e.g. when animateOff() gets called)
 //! the callback will be triggered with completed=false.
 //! 
-//! Callbacks are always called asynchronously on the timeline.
+//! Async callbacks and callbacks of canceled animations are queued and called
+//! in one batch per frame by the BaseApp (see dispatchQueuedCallbacks()).
+//! Completion cues are pooled, so animating views with callbacks doesn't
+//! allocate per call once the pool and queue have grown to their working size.
 class AnimatedView : public BaseView {
 
 public:
@@ -84,6 +87,21 @@ public:
 			return timeline->appendTo(target, endValue, mDuration, mEasing).delay(mDelay);
 		};
 
+		//! Applies these options to a tween on an AnimationScheduler. Chain owner() to invalidate and cancel with a view.
+		template <typename T>
+		inline AnimationScheduler::Options apply(AnimationSchedulerRef scheduler,
+											   typename ci::Anim<T> * target,
+											   T startValue,
+											   T endValue) const {
+			return scheduler->apply(target, startValue, endValue, mDuration, mEasing).delay(mDelay);
+		};
+		template <typename T>
+		inline AnimationScheduler::Options apply(AnimationSchedulerRef scheduler,
+											   typename ci::Anim<T> * target,
+											   T endValue) const {
+			return scheduler->apply(target, endValue, mDuration, mEasing).delay(mDelay);
+		};
+
 	private:
 		float mDuration = 0.33f;
 		float mDelay = 0;
@@ -97,18 +115,41 @@ public:
 		CallbackCue(CallbackFn callback, float time);
 		~CallbackCue();
 
-		//! Adds a single callback to the list
-		inline void addCallback(CallbackFn callback);
+		//! Adds a single callback to the list. Sync callbacks are called when the cue completes or is destroyed,
+		//! async callbacks are queued and called during the next dispatchQueuedCallbacks().
+		inline void addCallback(CallbackFn callback) { addCallback(std::move(callback), false); }
+		void addCallback(CallbackFn callback, const bool isAsync);
 
 		//! Removes callbacks without triggering them
-		inline void removeAllCallbacks() { mConnections.clear(); }
+		inline void removeAllCallbacks() { mCallbacks.clear(); }
 
 		//! Allows you to manually add callbacks, but connecting here will not allow you to use removeAllCallbacks()
 		inline CallbackSignal & getSignalCallback() { return mSignalCallback; }
 
+		//! Removes this cue from its timeline and queues all callbacks with completed=false. Does nothing if the cue has already triggered.
+		void cancel();
+
 	protected:
-		CallbackSignal mSignalCallback;
-		ci::signals::ConnectionList mConnections;
+		friend class AnimatedView;
+
+		struct Callback {
+			CallbackFn	fn;
+			bool		isAsync;
+		};
+
+		//! Used for pooled cues
+		CallbackCue();
+
+		//! Resets a pooled cue that is no longer referenced by any timeline so it can be inserted again at time
+		void recycle(AnimatedView * view, const float time);
+
+		//! Triggers all callbacks once. Sync callbacks are queued as well if deferSync is true.
+		void notify(const bool completed, const bool deferSync);
+
+		std::vector<Callback>	mCallbacks;		//! Keeps its capacity when pooled
+		AnimatedView *			mView;			//! Notified before any callbacks when the cue completes
+		bool					mIsNotified;
+		CallbackSignal			mSignalCallback;
 	};
 	typedef std::shared_ptr<CallbackCue> CallbackCueRef;
 
@@ -127,10 +168,10 @@ public:
 	void animateOff(const Options & options, CallbackFn callback = nullptr, bool isCallbackAsync = true);
 
 	//! Shortcut to animateOn() with default options.
-	void animateOn(CallbackFn callback = nullptr, bool isCallbackAsync = true) { animateOn(mDefaultOptions, callback, isCallbackAsync); };
+	void animateOn(CallbackFn callback = nullptr, bool isCallbackAsync = true) { animateOn(mDefaultOptions, std::move(callback), isCallbackAsync); };
 
 	//! Shortcut to animateOff() with default options.
-	void animateOff(CallbackFn callback = nullptr, bool isCallbackAsync = true) { animateOff(mDefaultOptions, callback, isCallbackAsync); };
+	void animateOff(CallbackFn callback = nullptr, bool isCallbackAsync = true) { animateOff(mDefaultOptions, std::move(callback), isCallbackAsync); };
 
 	//! Same as animating on with a duration of 0.
 	void setToAnimatedOn();
@@ -170,6 +211,12 @@ public:
 	//! returns default options
 	const Options & getDefaultOptions() { return mDefaultOptions; }
 
+	//! Calls all async callbacks and callbacks of canceled animations that have been queued before this call.
+	//! Callbacks queued during this call are dispatched next time. Called once per frame by the BaseApp; apps
+	//! that don't derive from BaseApp need to call this once per frame on the main thread.
+	static void dispatchQueuedCallbacks();
+	static size_t getNumQueuedCallbacks();
+
 protected:
 	//! Override this method to add your own animations to the timeline. Keep all animations based on the overall duration.
 	virtual void addAnimationOn(ci::TimelineRef timeline, const Options & options);
@@ -194,6 +241,16 @@ protected:
 
 private:
 
+	static void queueCallback(CallbackFn && callback, const bool completed);
+	static void dispatchCallback(CallbackFn & callback, const bool completed, const bool isAsync);
+
+	//! Returns a pooled cue that no timeline references anymore or creates a new one
+	CallbackCueRef acquireCue(const float time);
+	static void releaseCue(CallbackCueRef & cue);
+
+	//! Called by mCueOn and mCueOff when they complete
+	void handleCueCompleted(CallbackCue * cue);
+
 	CallbackCueRef mCueOn;
 	CallbackCueRef mCueOff;
 
@@ -0,0 +1,563 @@
+#include "AnimationEasing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLUECADET_EASING_AVX2
+#define BLUECADET_EASING_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLUECADET_EASING_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BLUECADET_EASING_NEON
+#endif
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Vector types
+//
+// Each type wraps one SIMD register and provides the same set of operators and functions, so that easing
+// kernels can be written once as templates. FloatX1 is used for remainders and when no SIMD is available.
+//
+
+namespace {
+
+static const float kPi = 3.14159265358979f;
+static const float kTwoPi = 6.28318530717959f;
+
+struct FloatX1 {
+	static const size_t kWidth = 1;
+	typedef bool Mask;
+	float v;
+	FloatX1() : v(0) {}
+	FloatX1(const float f) : v(f) {}
+	static FloatX1	load(const float * p)	{ return FloatX1(*p); }
+	void			store(float * p) const	{ *p = v; }
+};
+
+inline FloatX1 operator + (const FloatX1 & a, const FloatX1 & b) { return a.v + b.v; }
+inline FloatX1 operator - (const FloatX1 & a, const FloatX1 & b) { return a.v - b.v; }
+inline FloatX1 operator * (const FloatX1 & a, const FloatX1 & b) { return a.v * b.v; }
+inline FloatX1 operator - (const FloatX1 & a) { return -a.v; }
+inline FloatX1 vmin(const FloatX1 & a, const FloatX1 & b) { return std::min(a.v, b.v); }
+inline FloatX1 vmax(const FloatX1 & a, const FloatX1 & b) { return std::max(a.v, b.v); }
+inline FloatX1 vsqrt(const FloatX1 & a) { return std::sqrt(a.v); }
+inline FloatX1 vexp2(const FloatX1 & a) { return std::exp2(a.v); }
+inline FloatX1 vsin(const FloatX1 & a) { return std::sin(a.v); }
+inline bool lessThan(const FloatX1 & a, const FloatX1 & b) { return a.v < b.v; }
+inline bool equal(const FloatX1 & a, const FloatX1 & b) { return a.v == b.v; }
+inline FloatX1 select(const bool mask, const FloatX1 & a, const FloatX1 & b) { return mask ? a : b; }
+
+#if defined(BLUECADET_EASING_SSE2)
+
+struct FloatX4 {
+	static const size_t kWidth = 4;
+	typedef __m128 Mask;
+	__m128 v;
+	FloatX4() : v(_mm_setzero_ps()) {}
+	FloatX4(const float f) : v(_mm_set1_ps(f)) {}
+	FloatX4(const __m128 m) : v(m) {}
+	static FloatX4	load(const float * p)	{ return _mm_loadu_ps(p); }
+	void			store(float * p) const	{ _mm_storeu_ps(p, v); }
+};
+
+inline FloatX4 operator + (const FloatX4 & a, const FloatX4 & b) { return _mm_add_ps(a.v, b.v); }
+inline FloatX4 operator - (const FloatX4 & a, const FloatX4 & b) { return _mm_sub_ps(a.v, b.v); }
+inline FloatX4 operator * (const FloatX4 & a, const FloatX4 & b) { return _mm_mul_ps(a.v, b.v); }
+inline FloatX4 operator - (const FloatX4 & a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+inline FloatX4 vmin(const FloatX4 & a, const FloatX4 & b) { return _mm_min_ps(a.v, b.v); }
+inline FloatX4 vmax(const FloatX4 & a, const FloatX4 & b) { return _mm_max_ps(a.v, b.v); }
+inline FloatX4 vsqrt(const FloatX4 & a) { return _mm_sqrt_ps(a.v); }
+inline __m128 lessThan(const FloatX4 & a, const FloatX4 & b) { return _mm_cmplt_ps(a.v, b.v); }
+inline __m128 equal(const FloatX4 & a, const FloatX4 & b) { return _mm_cmpeq_ps(a.v, b.v); }
+inline FloatX4 select(const __m128 mask, const FloatX4 & a, const FloatX4 & b) { return _mm_or_ps(_mm_and_ps(mask, a.v), _mm_andnot_ps(mask, b.v)); }
+
+inline FloatX4 vfloor(const FloatX4 & a) {
+	// sse2 has no floor; truncate and correct negative values
+	const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a.v), _mm_set1_ps(1.0f)));
+}
+
+//! 2^n for integral n in [-126, 127]
+inline FloatX4 vpow2i(const FloatX4 & n) {
+	const __m128i exponent = _mm_add_epi32(_mm_cvttps_epi32(n.v), _mm_set1_epi32(127));
+	return _mm_castsi128_ps(_mm_slli_epi32(exponent, 23));
+}
+
+#endif
+
+#if defined(BLUECADET_EASING_AVX2)
+
+struct FloatX8 {
+	static const size_t kWidth = 8;
+	typedef __m256 Mask;
+	__m256 v;
+	FloatX8() : v(_mm256_setzero_ps()) {}
+	FloatX8(const float f) : v(_mm256_set1_ps(f)) {}
+	FloatX8(const __m256 m) : v(m) {}
+	static FloatX8	load(const float * p)	{ return _mm256_loadu_ps(p); }
+	void			store(float * p) const	{ _mm256_storeu_ps(p, v); }
+};
+
+inline FloatX8 operator + (const FloatX8 & a, const FloatX8 & b) { return _mm256_add_ps(a.v, b.v); }
+inline FloatX8 operator - (const FloatX8 & a, const FloatX8 & b) { return _mm256_sub_ps(a.v, b.v); }
+inline FloatX8 operator * (const FloatX8 & a, const FloatX8 & b) { return _mm256_mul_ps(a.v, b.v); }
+inline FloatX8 operator - (const FloatX8 & a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+inline FloatX8 vmin(const FloatX8 & a, const FloatX8 & b) { return _mm256_min_ps(a.v, b.v); }
+inline FloatX8 vmax(const FloatX8 & a, const FloatX8 & b) { return _mm256_max_ps(a.v, b.v); }
+inline FloatX8 vsqrt(const FloatX8 & a) { return _mm256_sqrt_ps(a.v); }
+inline __m256 lessThan(const FloatX8 & a, const FloatX8 & b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline __m256 equal(const FloatX8 & a, const FloatX8 & b) { return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ); }
+inline FloatX8 select(const __m256 mask, const FloatX8 & a, const FloatX8 & b) { return _mm256_blendv_ps(b.v, a.v, mask); }
+inline FloatX8 vfloor(const FloatX8 & a) { return _mm256_floor_ps(a.v); }
+
+inline FloatX8 vpow2i(const FloatX8 & n) {
+	const __m256i exponent = _mm256_add_epi32(_mm256_cvttps_epi32(n.v), _mm256_set1_epi32(127));
+	return _mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23));
+}
+
+#endif
+
+#if defined(BLUECADET_EASING_NEON)
+
+struct FloatX4 {
+	static const size_t kWidth = 4;
+	typedef uint32x4_t Mask;
+	float32x4_t v;
+	FloatX4() : v(vdupq_n_f32(0)) {}
+	FloatX4(const float f) : v(vdupq_n_f32(f)) {}
+	FloatX4(const float32x4_t m) : v(m) {}
+	static FloatX4	load(const float * p)	{ return vld1q_f32(p); }
+	void			store(float * p) const	{ vst1q_f32(p, v); }
+};
+
+inline FloatX4 operator + (const FloatX4 & a, const FloatX4 & b) { return vaddq_f32(a.v, b.v); }
+inline FloatX4 operator - (const FloatX4 & a, const FloatX4 & b) { return vsubq_f32(a.v, b.v); }
+inline FloatX4 operator * (const FloatX4 & a, const FloatX4 & b) { return vmulq_f32(a.v, b.v); }
+inline FloatX4 operator - (const FloatX4 & a) { return vnegq_f32(a.v); }
+inline FloatX4 vmin(const FloatX4 & a, const FloatX4 & b) { return vminq_f32(a.v, b.v); }
+inline FloatX4 vmax(const FloatX4 & a, const FloatX4 & b) { return vmaxq_f32(a.v, b.v); }
+inline FloatX4 vsqrt(const FloatX4 & a) { return vsqrtq_f32(a.v); }
+inline uint32x4_t lessThan(const FloatX4 & a, const FloatX4 & b) { return vcltq_f32(a.v, b.v); }
+inline uint32x4_t equal(const FloatX4 & a, const FloatX4 & b) { return vceqq_f32(a.v, b.v); }
+inline FloatX4 select(const uint32x4_t mask, const FloatX4 & a, const FloatX4 & b) { return vbslq_f32(mask, a.v, b.v); }
+inline FloatX4 vfloor(const FloatX4 & a) { return vrndmq_f32(a.v); }
+
+inline FloatX4 vpow2i(const FloatX4 & n) {
+	const int32x4_t exponent = vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127));
+	return vreinterpretq_f32_s32(vshlq_n_s32(exponent, 23));
+}
+
+#endif
+
+#if defined(BLUECADET_EASING_SSE2) || defined(BLUECADET_EASING_NEON)
+
+//! 2^x via integer/fraction split and a 7th order polynomial for the fraction
+template <typename V>
+inline V vexp2(const V & x) {
+	const V clamped = vmin(vmax(x, V(-126.0f)), V(126.0f));
+	const V whole = vfloor(clamped);
+	const V f = clamped - whole;
+	V p = V(1.52527338e-5f);
+	p = p * f + V(1.54035304e-4f);
+	p = p * f + V(1.33335581e-3f);
+	p = p * f + V(9.61812911e-3f);
+	p = p * f + V(5.55041087e-2f);
+	p = p * f + V(2.40226507e-1f);
+	p = p * f + V(6.93147181e-1f);
+	p = p * f + V(1.0f);
+	return p * vpow2i(whole);
+}
+
+//! sin(x) via range reduction to [-pi/2, pi/2] and an 11th order polynomial
+template <typename V>
+inline V vsin(const V & x) {
+	// reduce to [-pi, pi]
+	const V k = vfloor(x * V(1.0f / kTwoPi) + V(0.5f));
+	V r = x - k * V(kTwoPi);
+
+	// fold to [-pi/2, pi/2] using sin(pi - x) = sin(x)
+	r = select(lessThan(V(kPi * 0.5f), r), V(kPi) - r, r);
+	r = select(lessThan(r, V(-kPi * 0.5f)), V(-kPi) - r, r);
+
+	const V r2 = r * r;
+	V p = V(-2.50521084e-8f);
+	p = p * r2 + V(2.75573192e-6f);
+	p = p * r2 + V(-1.98412698e-4f);
+	p = p * r2 + V(8.33333333e-3f);
+	p = p * r2 + V(-1.66666667e-1f);
+	p = p * r2 + V(1.0f);
+	return p * r;
+}
+
+#endif
+
+//==================================================
+// Easing kernels
+//
+// Each family provides an in and an out function. In-out and out-in variants are composed from those,
+// which matches Cinder's implementations.
+//
+
+struct QuadIn { template <typename V> V operator()(const V & t) const { return t * t; } };
+struct QuadOut { template <typename V> V operator()(const V & t) const { return -t * (t - V(2.0f)); } };
+
+struct CubicIn { template <typename V> V operator()(const V & t) const { return t * t * t; } };
+struct CubicOut { template <typename V> V operator()(const V & t) const { const V u = t - V(1.0f); return u * u * u + V(1.0f); } };
+
+struct QuartIn { template <typename V> V operator()(const V & t) const { const V t2 = t * t; return t2 * t2; } };
+struct QuartOut { template <typename V> V operator()(const V & t) const { const V u = t - V(1.0f); const V u2 = u * u; return V(1.0f) - u2 * u2; } };
+
+struct QuintIn { template <typename V> V operator()(const V & t) const { const V t2 = t * t; return t2 * t2 * t; } };
+struct QuintOut { template <typename V> V operator()(const V & t) const { const V u = t - V(1.0f); const V u2 = u * u; return u2 * u2 * u + V(1.0f); } };
+
+struct SineIn { template <typename V> V operator()(const V & t) const { return V(1.0f) - vsin(t * V(kPi * 0.5f) + V(kPi * 0.5f)); } };
+struct SineOut { template <typename V> V operator()(const V & t) const { return vsin(t * V(kPi * 0.5f)); } };
+
+struct ExpoIn {
+	template <typename V> V operator()(const V & t) const {
+		return select(equal(t, V(0.0f)), V(0.0f), vexp2(V(10.0f) * (t - V(1.0f))));
+	}
+};
+struct ExpoOut {
+	template <typename V> V operator()(const V & t) const {
+		return select(equal(t, V(1.0f)), V(1.0f), V(1.0f) - vexp2(V(-10.0f) * t));
+	}
+};
+
+struct CircIn { template <typename V> V operator()(const V & t) const { return V(1.0f) - vsqrt(vmax(V(1.0f) - t * t, V(0.0f))); } };
+struct CircOut { template <typename V> V operator()(const V & t) const { const V u = t - V(1.0f); return vsqrt(vmax(V(1.0f) - u * u, V(0.0f))); } };
+
+struct BackIn {
+	float s;
+	BackIn(const float s) : s(s) {}
+	template <typename V> V operator()(const V & t) const { return t * t * (V(s + 1.0f) * t - V(s)); }
+};
+struct BackOut {
+	float s;
+	BackOut(const float s) : s(s) {}
+	template <typename V> V operator()(const V & t) const { const V u = t - V(1.0f); return u * u * (V(s + 1.0f) * u + V(s)) + V(1.0f); }
+};
+
+//! Cinder's bounce with end value c and overshoot a
+struct BounceOutHelper {
+	float c, a;
+	BounceOutHelper(const float c, const float a) : c(c), a(a) {}
+	template <typename V> V operator()(const V & t) const {
+		const V k(7.5625f);
+		const V u1 = t - V(6.0f / 11.0f);
+		const V u2 = t - V(9.0f / 11.0f);
+		const V u3 = t - V(21.0f / 22.0f);
+		const V seg0 = V(c) * k * t * t;
+		const V seg1 = V(c) - V(a) * (V(1.0f) - (k * u1 * u1 + V(0.75f)));
+		const V seg2 = V(c) - V(a) * (V(1.0f) - (k * u2 * u2 + V(0.9375f)));
+		const V seg3 = V(c) - V(a) * (V(1.0f) - (k * u3 * u3 + V(0.984375f)));
+		V result = select(lessThan(t, V(10.0f / 11.0f)), seg2, seg3);
+		result = select(lessThan(t, V(8.0f / 11.0f)), seg1, result);
+		result = select(lessThan(t, V(4.0f / 11.0f)), seg0, result);
+		return select(equal(t, V(1.0f)), V(c), result);
+	}
+};
+struct BounceOut {
+	BounceOutHelper helper;
+	BounceOut(const float a) : helper(1.0f, a) {}
+	template <typename V> V operator()(const V & t) const { return helper(t); }
+};
+struct BounceIn {
+	BounceOutHelper helper;
+	BounceIn(const float a) : helper(1.0f, a) {}
+	template <typename V> V operator()(const V & t) const { return V(1.0f) - helper(V(1.0f) - t); }
+};
+struct BounceOutIn {
+	BounceOutHelper helper;
+	BounceOutIn(const float a) : helper(0.5f, a) {}
+	template <typename V> V operator()(const V & t) const {
+		return select(lessThan(t, V(0.5f)), helper(t * V(2.0f)), V(1.0f) - helper(V(2.0f) - t * V(2.0f)));
+	}
+};
+
+//! Elastic with amplitude <= 1, which Cinder treats as 1 with s = period / 4
+struct ElasticIn {
+	float period;
+	ElasticIn(const float period) : period(period) {}
+	template <typename V> V operator()(const V & t) const {
+		const V u = t - V(1.0f);
+		const V result = -(vexp2(V(10.0f) * u) * vsin((u - V(period * 0.25f)) * V(kTwoPi / period)));
+		return select(equal(t, V(0.0f)), V(0.0f), select(equal(t, V(1.0f)), V(1.0f), result));
+	}
+};
+struct ElasticOut {
+	float period;
+	ElasticOut(const float period) : period(period) {}
+	template <typename V> V operator()(const V & t) const {
+		const V result = vexp2(V(-10.0f) * t) * vsin((t - V(period * 0.25f)) * V(kTwoPi / period)) + V(1.0f);
+		return select(equal(t, V(0.0f)), V(0.0f), select(equal(t, V(1.0f)), V(1.0f), result));
+	}
+};
+
+template <typename In, typename Out>
+struct InOut {
+	In in; Out out;
+	InOut(const In & in = In(), const Out & out = Out()) : in(in), out(out) {}
+	template <typename V> V operator()(const V & t) const {
+		const V half(0.5f);
+		const V t2 = t * V(2.0f);
+		return select(lessThan(t, half), in(t2) * half, out(t2 - V(1.0f)) * half + half);
+	}
+};
+
+template <typename Out, typename In>
+struct OutIn {
+	Out out; In in;
+	OutIn(const Out & out = Out(), const In & in = In()) : out(out), in(in) {}
+	template <typename V> V operator()(const V & t) const {
+		const V half(0.5f);
+		const V t2 = t * V(2.0f);
+		return select(lessThan(t, half), out(t2) * half, in(t2 - V(1.0f)) * half + half);
+	}
+};
+
+//==================================================
+// Batch processing
+//
+
+template <typename Kernel>
+inline void runKernel(const Kernel & kernel, const float * times, float * results, const size_t count) {
+	size_t i = 0;
+
+#if defined(BLUECADET_EASING_AVX2)
+	for (; i + FloatX8::kWidth <= count; i += FloatX8::kWidth) {
+		kernel(FloatX8::load(times + i)).store(results + i);
+	}
+#endif
+
+#if defined(BLUECADET_EASING_SSE2) || defined(BLUECADET_EASING_NEON)
+	for (; i + FloatX4::kWidth <= count; i += FloatX4::kWidth) {
+		kernel(FloatX4::load(times + i)).store(results + i);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		kernel(FloatX1::load(times + i)).store(results + i);
+	}
+}
+
+}
+
+//==================================================
+// Easing
+//
+
+float evaluateEase(const EaseId id, const float t) {
+	static const float s = 1.70158f;
+	static const float amplitude = 1.0f;
+	static const float period = 0.3f;
+
+	switch (id) {
+		case EaseId::None: return t;
+
+		case EaseId::InQuad: return easeInQuad(t);
+		case EaseId::OutQuad: return easeOutQuad(t);
+		case EaseId::InOutQuad: return easeInOutQuad(t);
+		case EaseId::OutInQuad: return easeOutInQuad(t);
+
+		case EaseId::InCubic: return easeInCubic(t);
+		case EaseId::OutCubic: return easeOutCubic(t);
+		case EaseId::InOutCubic: return easeInOutCubic(t);
+		case EaseId::OutInCubic: return easeOutInCubic(t);
+
+		case EaseId::InQuart: return easeInQuart(t);
+		case EaseId::OutQuart: return easeOutQuart(t);
+		case EaseId::InOutQuart: return easeInOutQuart(t);
+		case EaseId::OutInQuart: return easeOutInQuart(t);
+
+		case EaseId::InQuint: return easeInQuint(t);
+		case EaseId::OutQuint: return easeOutQuint(t);
+		case EaseId::InOutQuint: return easeInOutQuint(t);
+		case EaseId::OutInQuint: return easeOutInQuint(t);
+
+		case EaseId::InSine: return easeInSine(t);
+		case EaseId::OutSine: return easeOutSine(t);
+		case EaseId::InOutSine: return easeInOutSine(t);
+		case EaseId::OutInSine: return easeOutInSine(t);
+
+		case EaseId::InExpo: return easeInExpo(t);
+		case EaseId::OutExpo: return easeOutExpo(t);
+		case EaseId::InOutExpo: return easeInOutExpo(t);
+		case EaseId::OutInExpo: return easeOutInExpo(t);
+
+		case EaseId::InCirc: return easeInCirc(t);
+		case EaseId::OutCirc: return easeOutCirc(t);
+		case EaseId::InOutCirc: return easeInOutCirc(t);
+		case EaseId::OutInCirc: return easeOutInCirc(t);
+
+		case EaseId::InBack: return easeInBack(t, s);
+		case EaseId::OutBack: return easeOutBack(t, s);
+		case EaseId::InOutBack: return easeInOutBack(t, s);
+		case EaseId::OutInBack: return easeOutInBack(t, s);
+
+		case EaseId::InBounce: return easeInBounce(t, s);
+		case EaseId::OutBounce: return easeOutBounce(t, s);
+		case EaseId::InOutBounce: return easeInOutBounce(t, s);
+		case EaseId::OutInBounce: return easeOutInBounce(t, s);
+
+		case EaseId::InElastic: return easeInElastic(t, amplitude, period);
+		case EaseId::OutElastic: return easeOutElastic(t, amplitude, period);
+		case EaseId::InOutElastic: return easeInOutElastic(t, amplitude, period);
+
+		default: return t;
+	}
+}
+
+void evaluateEaseBatch(const EaseId id, const float * times, float * results, const size_t count) {
+	static const float s = 1.70158f;
+	static const float period = 0.3f;
+
+	switch (id) {
+		case EaseId::InQuad: runKernel(QuadIn(), times, results, count); break;
+		case EaseId::OutQuad: runKernel(QuadOut(), times, results, count); break;
+		case EaseId::InOutQuad: runKernel(InOut<QuadIn, QuadOut>(), times, results, count); break;
+		case EaseId::OutInQuad: runKernel(OutIn<QuadOut, QuadIn>(), times, results, count); break;
+
+		case EaseId::InCubic: runKernel(CubicIn(), times, results, count); break;
+		case EaseId::OutCubic: runKernel(CubicOut(), times, results, count); break;
+		case EaseId::InOutCubic: runKernel(InOut<CubicIn, CubicOut>(), times, results, count); break;
+		case EaseId::OutInCubic: runKernel(OutIn<CubicOut, CubicIn>(), times, results, count); break;
+
+		case EaseId::InQuart: runKernel(QuartIn(), times, results, count); break;
+		case EaseId::OutQuart: runKernel(QuartOut(), times, results, count); break;
+		case EaseId::InOutQuart: runKernel(InOut<QuartIn, QuartOut>(), times, results, count); break;
+		case EaseId::OutInQuart: runKernel(OutIn<QuartOut, QuartIn>(), times, results, count); break;
+
+		case EaseId::InQuint: runKernel(QuintIn(), times, results, count); break;
+		case EaseId::OutQuint: runKernel(QuintOut(), times, results, count); break;
+		case EaseId::InOutQuint: runKernel(InOut<QuintIn, QuintOut>(), times, results, count); break;
+		case EaseId::OutInQuint: runKernel(OutIn<QuintOut, QuintIn>(), times, results, count); break;
+
+		case EaseId::InSine: runKernel(SineIn(), times, results, count); break;
+		case EaseId::OutSine: runKernel(SineOut(), times, results, count); break;
+		case EaseId::InOutSine: runKernel(InOut<SineIn, SineOut>(), times, results, count); break;
+		case EaseId::OutInSine: runKernel(OutIn<SineOut, SineIn>(), times, results, count); break;
+
+		case EaseId::InExpo: runKernel(ExpoIn(), times, results, count); break;
+		case EaseId::OutExpo: runKernel(ExpoOut(), times, results, count); break;
+		case EaseId::InOutExpo: runKernel(InOut<ExpoIn, ExpoOut>(), times, results, count); break;
+		case EaseId::OutInExpo: runKernel(OutIn<ExpoOut, ExpoIn>(), times, results, count); break;
+
+		case EaseId::InCirc: runKernel(CircIn(), times, results, count); break;
+		case EaseId::OutCirc: runKernel(CircOut(), times, results, count); break;
+		case EaseId::InOutCirc: runKernel(InOut<CircIn, CircOut>(), times, results, count); break;
+		case EaseId::OutInCirc: runKernel(OutIn<CircOut, CircIn>(), times, results, count); break;
+
+		case EaseId::InBack: runKernel(BackIn(s), times, results, count); break;
+		case EaseId::OutBack: runKernel(BackOut(s), times, results, count); break;
+		case EaseId::InOutBack: runKernel(InOut<BackIn, BackOut>(BackIn(s * 1.525f), BackOut(s * 1.525f)), times, results, count); break;
+		case EaseId::OutInBack: runKernel(OutIn<BackOut, BackIn>(BackOut(s), BackIn(s)), times, results, count); break;
+
+		case EaseId::InBounce: runKernel(BounceIn(s), times, results, count); break;
+		case EaseId::OutBounce: runKernel(BounceOut(s), times, results, count); break;
+		case EaseId::InOutBounce: runKernel(InOut<BounceIn, BounceOut>(BounceIn(s), BounceOut(s)), times, results, count); break;
+		case EaseId::OutInBounce: runKernel(BounceOutIn(s), times, results, count); break;
+
+		case EaseId::InElastic: runKernel(ElasticIn(period), times, results, count); break;
+		case EaseId::OutElastic: runKernel(ElasticOut(period), times, results, count); break;
+		case EaseId::InOutElastic: runKernel(InOut<ElasticIn, ElasticOut>(ElasticIn(period), ElasticOut(period)), times, results, count); break;
+
+		default:
+			if (results != times) {
+				memcpy(results, times, count * sizeof(float));
+			}
+			break;
+	}
+}
+
+const char * getEaseBatchInstructionSet() {
+#if defined(BLUECADET_EASING_AVX2)
+	return "AVX2";
+#elif defined(BLUECADET_EASING_SSE2)
+	return "SSE2";
+#elif defined(BLUECADET_EASING_NEON)
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+EaseId getEaseId(const ci::EaseFn & fn) {
+	if (!fn) return EaseId::None;
+
+	if (fn.target<EaseNone>()) return EaseId::None;
+
+	if (fn.target<EaseInQuad>()) return EaseId::InQuad;
+	if (fn.target<EaseOutQuad>()) return EaseId::OutQuad;
+	if (fn.target<EaseInOutQuad>()) return EaseId::InOutQuad;
+	if (fn.target<EaseOutInQuad>()) return EaseId::OutInQuad;
+
+	if (fn.target<EaseInCubic>()) return EaseId::InCubic;
+	if (fn.target<EaseOutCubic>()) return EaseId::OutCubic;
+	if (fn.target<EaseInOutCubic>()) return EaseId::InOutCubic;
+	if (fn.target<EaseOutInCubic>()) return EaseId::OutInCubic;
+
+	if (fn.target<EaseInQuart>()) return EaseId::InQuart;
+	if (fn.target<EaseOutQuart>()) return EaseId::OutQuart;
+	if (fn.target<EaseInOutQuart>()) return EaseId::InOutQuart;
+	if (fn.target<EaseOutInQuart>()) return EaseId::OutInQuart;
+
+	if (fn.target<EaseInQuint>()) return EaseId::InQuint;
+	if (fn.target<EaseOutQuint>()) return EaseId::OutQuint;
+	if (fn.target<EaseInOutQuint>()) return EaseId::InOutQuint;
+	if (fn.target<EaseOutInQuint>()) return EaseId::OutInQuint;
+
+	if (fn.target<EaseInSine>()) return EaseId::InSine;
+	if (fn.target<EaseOutSine>()) return EaseId::OutSine;
+	if (fn.target<EaseInOutSine>()) return EaseId::InOutSine;
+	if (fn.target<EaseOutInSine>()) return EaseId::OutInSine;
+
+	if (fn.target<EaseInExpo>()) return EaseId::InExpo;
+	if (fn.target<EaseOutExpo>()) return EaseId::OutExpo;
+	if (fn.target<EaseInOutExpo>()) return EaseId::InOutExpo;
+	if (fn.target<EaseOutInExpo>()) return EaseId::OutInExpo;
+
+	if (fn.target<EaseInCirc>()) return EaseId::InCirc;
+	if (fn.target<EaseOutCirc>()) return EaseId::OutCirc;
+	if (fn.target<EaseInOutCirc>()) return EaseId::InOutCirc;
+	if (fn.target<EaseOutInCirc>()) return EaseId::OutInCirc;
+
+	return EaseId::Custom;
+}
+
+
+EaseId getEaseIdByName(const std::string & name) {
+	static const char * names[] = {
+		"None",
+		"InQuad", "OutQuad", "InOutQuad", "OutInQuad",
+		"InCubic", "OutCubic", "InOutCubic", "OutInCubic",
+		"InQuart", "OutQuart", "InOutQuart", "OutInQuart",
+		"InQuint", "OutQuint", "InOutQuint", "OutInQuint",
+		"InSine", "OutSine", "InOutSine", "OutInSine",
+		"InExpo", "OutExpo", "InOutExpo", "OutInExpo",
+		"InCirc", "OutCirc", "InOutCirc", "OutInCirc",
+		"InBack", "OutBack", "InOutBack", "OutInBack",
+		"InBounce", "OutBounce", "InOutBounce", "OutInBounce",
+		"InElastic", "OutElastic", "InOutElastic"
+	};
+	static_assert(sizeof(names) / sizeof(names[0]) == (size_t)EaseId::Custom, "Every EaseId needs a name");
+
+	for (size_t i = 0; i < (size_t)EaseId::Custom; ++i) {
+		if (name == names[i]) return (EaseId)i;
+	}
+
+	return EaseId::Custom;
+}
+
+}
+}
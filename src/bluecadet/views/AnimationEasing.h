@@ -0,0 +1,50 @@
+#pragma once
+
+#include "cinder/Easing.h"
+#include "cinder/Tween.h"
+
+#include <cstdint>
+#include <string>
+
+namespace bluecadet {
+namespace views {
+
+//! Identifies the standard Cinder easing functions so they can be evaluated without a std::function call per tween.
+//! Back and bounce use Cinder's default overshoot (1.70158). Elastic uses an amplitude of 1 and a period of 0.3.
+enum class EaseId : uint8_t {
+	None,
+	InQuad, OutQuad, InOutQuad, OutInQuad,
+	InCubic, OutCubic, InOutCubic, OutInCubic,
+	InQuart, OutQuart, InOutQuart, OutInQuart,
+	InQuint, OutQuint, InOutQuint, OutInQuint,
+	InSine, OutSine, InOutSine, OutInSine,
+	InExpo, OutExpo, InOutExpo, OutInExpo,
+	InCirc, OutCirc, InOutCirc, OutInCirc,
+	InBack, OutBack, InOutBack, OutInBack,
+	InBounce, OutBounce, InOutBounce, OutInBounce,
+	InElastic, OutElastic, InOutElastic,
+	Custom,		//! Evaluated with a ci::EaseFn
+	NumEaseIds
+};
+
+//! Evaluates easing `id` at normalized time t. Returns t for EaseId::Custom.
+float	evaluateEase(const EaseId id, const float t);
+
+//! Evaluates easing `id` for count normalized times and writes the eased values to results (can be the same array as times).
+//! Uses AVX2, SSE2 or NEON to evaluate multiple values per instruction when available. Sine, expo and elastic easings use
+//! polynomial approximations of sin and exp2 in the vectorized paths (max error around 1e-6). Copies times for EaseId::Custom.
+void	evaluateEaseBatch(const EaseId id, const float * times, float * results, const size_t count);
+
+//! Name of the instruction set used by evaluateEaseBatch() (e.g. "SSE2") or "Scalar" if none is available.
+const char *	getEaseBatchInstructionSet();
+
+//! Returns the EaseId of a ci::EaseFn if it wraps one of the parameterless Cinder easing functors (e.g. ci::EaseInOutQuad()).
+//! Returns EaseId::Custom for all other functions, including Back, Bounce and Elastic functors since their parameters are opaque.
+//! Returns EaseId::None for empty functions.
+EaseId	getEaseId(const ci::EaseFn & fn);
+
+//! Returns the EaseId with the same name as its enum value (e.g. "InOutQuad" or "None"). Returns EaseId::Custom for unknown names.
+EaseId	getEaseIdByName(const std::string & name);
+
+}
+}
@@ -0,0 +1,504 @@
+#include "AnimationScheduler.h"
+
+#include "AnimationSequence.h"
+#include "BaseView.h"
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Value interpolation
+//
+
+namespace {
+	template <typename T>
+	inline T lerpValue(const T & start, const T & end, const float t) { return start + (end - start) * t; }
+
+	template <>
+	inline quat lerpValue(const quat & start, const quat & end, const float t) { return glm::slerp(start, end, t); }
+}
+
+//==================================================
+// Options
+//
+
+AnimationScheduler::Options & AnimationScheduler::Options::delay(const float value) {
+	const TweenLocation * location = mScheduler->mLocationsByTarget.find(mTarget);
+	if (!location) return *this;
+
+	switch (location->type) {
+		case TweenType::Float: mScheduler->setTweenDelay(mScheduler->mFloatTweens, location->index, value); break;
+		case TweenType::Vec2: mScheduler->setTweenDelay(mScheduler->mVec2Tweens, location->index, value); break;
+		case TweenType::Quat: mScheduler->setTweenDelay(mScheduler->mQuatTweens, location->index, value); break;
+		case TweenType::Color: mScheduler->setTweenDelay(mScheduler->mColorTweens, location->index, value); break;
+		case TweenType::ColorA: mScheduler->setTweenDelay(mScheduler->mColorATweens, location->index, value); break;
+	}
+	return *this;
+}
+
+AnimationScheduler::Options & AnimationScheduler::Options::finishFn(const FinishFn & fn) {
+	const TweenLocation * location = mScheduler->mLocationsByTarget.find(mTarget);
+	if (!location) return *this;
+
+	switch (location->type) {
+		case TweenType::Float: mScheduler->setTweenFinishFn(mScheduler->mFloatTweens, location->index, fn); break;
+		case TweenType::Vec2: mScheduler->setTweenFinishFn(mScheduler->mVec2Tweens, location->index, fn); break;
+		case TweenType::Quat: mScheduler->setTweenFinishFn(mScheduler->mQuatTweens, location->index, fn); break;
+		case TweenType::Color: mScheduler->setTweenFinishFn(mScheduler->mColorTweens, location->index, fn); break;
+		case TweenType::ColorA: mScheduler->setTweenFinishFn(mScheduler->mColorATweens, location->index, fn); break;
+	}
+	return *this;
+}
+
+AnimationScheduler::Options & AnimationScheduler::Options::owner(BaseView * view) {
+	const TweenLocation * location = mScheduler->mLocationsByTarget.find(mTarget);
+	if (!location) return *this;
+
+	switch (location->type) {
+		case TweenType::Float: mScheduler->setTweenOwner(mScheduler->mFloatTweens, location->index, view); break;
+		case TweenType::Vec2: mScheduler->setTweenOwner(mScheduler->mVec2Tweens, location->index, view); break;
+		case TweenType::Quat: mScheduler->setTweenOwner(mScheduler->mQuatTweens, location->index, view); break;
+		case TweenType::Color: mScheduler->setTweenOwner(mScheduler->mColorTweens, location->index, view); break;
+		case TweenType::ColorA: mScheduler->setTweenOwner(mScheduler->mColorATweens, location->index, view); break;
+	}
+	return *this;
+}
+
+//==================================================
+// Lifecycle
+//
+
+AnimationSchedulerRef AnimationScheduler::get() {
+	static auto instance = std::make_shared<AnimationScheduler>();
+	return instance;
+}
+
+AnimationScheduler::AnimationScheduler() :
+	mSprings(new SpringAnimator(this)),
+	mCurrentTime(0),
+	mNextTweenId(1)
+{
+}
+
+AnimationScheduler::~AnimationScheduler() {
+}
+
+void AnimationScheduler::update(const double time) {
+	mCurrentTime = time;
+
+	updateTweens(mFloatTweens, time);
+	updateTweens(mVec2Tweens, time);
+	updateTweens(mQuatTweens, time);
+	updateTweens(mColorTweens, time);
+	updateTweens(mColorATweens, time);
+
+	// finish functions can add or cancel tweens, so they're called once all arrays are consistent
+	if (!mPendingFinishFns.empty()) {
+		vector<FinishFn> finishFns;
+		finishFns.swap(mPendingFinishFns);
+		for (auto & fn : finishFns) {
+			fn();
+		}
+		finishFns.clear();
+		if (mPendingFinishFns.empty()) {
+			mPendingFinishFns.swap(finishFns); // keep capacity
+		}
+	}
+
+	mSprings->update(time);
+
+	if (!mSequences.empty()) {
+		updateSequences(time);
+	}
+}
+
+//==================================================
+// Tween management
+//
+
+bool AnimationScheduler::cancel(const void * target) {
+	const TweenLocation * location = mLocationsByTarget.find(target);
+	if (!location) {
+		return false;
+	}
+	// removing the tween erases the location from the table
+	removeTween(TweenLocation(*location));
+	return true;
+}
+
+void AnimationScheduler::cancelAll(const BaseView * owner) {
+	if (!owner) return;
+	removeTweensOwnedBy(mFloatTweens, owner);
+	removeTweensOwnedBy(mVec2Tweens, owner);
+	removeTweensOwnedBy(mQuatTweens, owner);
+	removeTweensOwnedBy(mColorTweens, owner);
+	removeTweensOwnedBy(mColorATweens, owner);
+	mSprings->cancelAll(owner);
+
+	// sequences are removed during the next update since canceling can call into user code that plays other sequences
+	for (size_t i = 0; i < mSequences.size(); ++i) {
+		if (mSequences[i]->mOwner != owner) continue;
+		auto sequence = mSequences[i];
+		setSequenceOwner(*sequence, nullptr);
+		sequence->cancel();
+	}
+}
+
+void AnimationScheduler::clear() {
+	while (mFloatTweens.size() > 0) removeTween(mFloatTweens, (uint32_t)mFloatTweens.size() - 1);
+	while (mVec2Tweens.size() > 0) removeTween(mVec2Tweens, (uint32_t)mVec2Tweens.size() - 1);
+	while (mQuatTweens.size() > 0) removeTween(mQuatTweens, (uint32_t)mQuatTweens.size() - 1);
+	while (mColorTweens.size() > 0) removeTween(mColorTweens, (uint32_t)mColorTweens.size() - 1);
+	while (mColorATweens.size() > 0) removeTween(mColorATweens, (uint32_t)mColorATweens.size() - 1);
+	mSprings->clear();
+
+	for (auto & sequence : mSequences) {
+		setSequenceOwner(*sequence, nullptr);
+		sequence->mIsScheduled = false;
+		sequence->mState = AnimationSequence::State::IDLE;
+	}
+	mSequences.clear();
+}
+
+//==================================================
+// Sequences
+//
+
+void AnimationScheduler::play(AnimationSequenceRef sequence, BaseView * owner) {
+	if (!sequence) {
+		return;
+	}
+
+	sequence->cancel();
+	setSequenceOwner(*sequence, owner);
+
+	if (!sequence->mIsScheduled) {
+		sequence->mIsScheduled = true;
+		mSequences.push_back(sequence);
+	}
+
+	sequence->start(mCurrentTime);
+	sequence->update(mCurrentTime);
+}
+
+void AnimationScheduler::handleViewRemoved(const BaseView * view) {
+	// removals are infrequent, so sequences only check their steps against removed views on their next update
+	for (auto & sequence : mSequences) {
+		if (sequence->isPlaying()) {
+			sequence->mRemovedViews.push_back(view);
+		}
+	}
+}
+
+void AnimationScheduler::updateSequences(const double time) {
+	// sequences played during this loop are appended and have already been started by play()
+	const size_t numSequences = mSequences.size();
+
+	for (size_t i = 0; i < numSequences && i < mSequences.size(); ++i) {
+		auto sequence = mSequences[i]; // retain while calling into user code
+		sequence->update(time);
+	}
+
+	size_t numPlaying = 0;
+
+	for (size_t i = 0; i < mSequences.size(); ++i) {
+		auto & sequence = mSequences[i];
+		if (sequence->isPlaying()) {
+			mSequences[numPlaying++] = sequence;
+		} else {
+			setSequenceOwner(*sequence, nullptr);
+			sequence->mIsScheduled = false;
+		}
+	}
+
+	mSequences.resize(numPlaying);
+}
+
+void AnimationScheduler::setSequenceOwner(AnimationSequence & sequence, BaseView * owner) {
+	if (sequence.mOwner == owner) {
+		return;
+	}
+	if (sequence.mOwner) {
+		sequence.mOwner->mNumScheduledTweens--;
+	}
+	sequence.mOwner = owner;
+	if (owner) {
+		owner->mNumScheduledTweens++;
+	}
+}
+
+size_t AnimationScheduler::getNumTweens() const {
+	return mFloatTweens.size() + mVec2Tweens.size() + mQuatTweens.size() + mColorTweens.size() + mColorATweens.size();
+}
+
+void AnimationScheduler::removeTween(const TweenLocation & location) {
+	switch (location.type) {
+		case TweenType::Float: removeTween(mFloatTweens, location.index); break;
+		case TweenType::Vec2: removeTween(mVec2Tweens, location.index); break;
+		case TweenType::Quat: removeTween(mQuatTweens, location.index); break;
+		case TweenType::Color: removeTween(mColorTweens, location.index); break;
+		case TweenType::ColorA: removeTween(mColorATweens, location.index); break;
+	}
+}
+
+//==================================================
+// Typed helpers
+//
+
+template <> AnimationScheduler::TweenArray<float> & AnimationScheduler::getTweens<float>() { return mFloatTweens; }
+template <> AnimationScheduler::TweenArray<vec2> & AnimationScheduler::getTweens<vec2>() { return mVec2Tweens; }
+template <> AnimationScheduler::TweenArray<quat> & AnimationScheduler::getTweens<quat>() { return mQuatTweens; }
+template <> AnimationScheduler::TweenArray<Color> & AnimationScheduler::getTweens<Color>() { return mColorTweens; }
+template <> AnimationScheduler::TweenArray<ColorA> & AnimationScheduler::getTweens<ColorA>() { return mColorATweens; }
+
+template <> AnimationScheduler::TweenType AnimationScheduler::getTweenType<float>() { return TweenType::Float; }
+template <> AnimationScheduler::TweenType AnimationScheduler::getTweenType<vec2>() { return TweenType::Vec2; }
+template <> AnimationScheduler::TweenType AnimationScheduler::getTweenType<quat>() { return TweenType::Quat; }
+template <> AnimationScheduler::TweenType AnimationScheduler::getTweenType<Color>() { return TweenType::Color; }
+template <> AnimationScheduler::TweenType AnimationScheduler::getTweenType<ColorA>() { return TweenType::ColorA; }
+
+template <typename T>
+AnimationScheduler::TweenId AnimationScheduler::addTween(ci::Anim<T> * target, const T * startValue, const T & endValue, const float duration, const Easing & easing) {
+	if (!target) {
+		return 0;
+	}
+
+	// replace existing tweens and springs on the same target
+	cancel(target);
+	mSprings->cancel(target);
+
+	// remove any timeline tweens that would otherwise compete with this one
+	target->stop();
+
+	TweenArray<T> & tweens = getTweens<T>();
+	const TweenId id = mNextTweenId++;
+	const uint32_t index = (uint32_t)tweens.size();
+
+	tweens.targets.push_back(target);
+	tweens.startValues.push_back(startValue ? *startValue : target->value());
+	tweens.endValues.push_back(endValue);
+	tweens.startTimes.push_back(mCurrentTime);
+	tweens.invDurations.push_back(duration > 0 ? 1.0f / duration : 0.0f);
+	tweens.easeIds.push_back(easing.id);
+	tweens.flags.push_back(startValue ? 0 : NeedsStartValue);
+	tweens.owners.push_back(nullptr);
+	tweens.ids.push_back(id);
+	tweens.easeFns.push_back(easing.id == EaseId::Custom ? easing.fn : ci::EaseFn());
+	tweens.finishFns.emplace_back();
+
+	TweenLocation location;
+	location.type = getTweenType<T>();
+	location.index = index;
+	mLocationsByTarget.set(target, location);
+
+	return id;
+}
+
+template <typename T>
+void AnimationScheduler::updateTweens(TweenArray<T> & tweens, const double time) {
+	const size_t numTweens = tweens.size();
+
+	if (numTweens == 0) {
+		return;
+	}
+
+	mTimes.resize(numTweens);
+	mEasedTimes.resize(numTweens);
+
+	size_t numTweensPerEaseId[(size_t)EaseId::NumEaseIds] = {0};
+	size_t numActiveTweens = 0;
+
+	// normalized times; delayed tweens are marked with negative times
+	for (size_t i = 0; i < numTweens; ++i) {
+		const double elapsed = time - tweens.startTimes[i];
+
+		if (elapsed < 0) {
+			mTimes[i] = -1.0f;
+			continue;
+		}
+
+		uint8_t & flags = tweens.flags[i];
+
+		if (flags & NeedsStartValue) {
+			tweens.startValues[i] = tweens.targets[i]->value();
+			flags &= ~NeedsStartValue;
+		}
+
+		const float invDuration = tweens.invDurations[i];
+		mTimes[i] = invDuration > 0 ? std::min((float)elapsed * invDuration, 1.0f) : 1.0f;
+		numTweensPerEaseId[(size_t)tweens.easeIds[i]]++;
+		numActiveTweens++;
+	}
+
+	if (numActiveTweens == 0) {
+		return;
+	}
+
+	// evaluate easings in batches per ease id
+	const EaseId firstEaseId = tweens.easeIds[0];
+
+	if (numActiveTweens == numTweens && numTweensPerEaseId[(size_t)firstEaseId] == numTweens && firstEaseId != EaseId::Custom) {
+		// all tweens share the same easing, so no sorting is necessary
+		evaluateEaseBatch(firstEaseId, mTimes.data(), mEasedTimes.data(), numTweens);
+
+	} else {
+		// counting sort of active tweens by ease id
+		size_t batchOffsets[(size_t)EaseId::NumEaseIds];
+		size_t offset = 0;
+
+		for (size_t id = 0; id < (size_t)EaseId::NumEaseIds; ++id) {
+			batchOffsets[id] = offset;
+			offset += numTweensPerEaseId[id];
+		}
+
+		mBatchIndices.resize(numActiveTweens);
+		mBatchTimes.resize(numActiveTweens);
+
+		for (size_t i = 0; i < numTweens; ++i) {
+			if (mTimes[i] < 0) continue;
+			const size_t batchIndex = batchOffsets[(size_t)tweens.easeIds[i]]++;
+			mBatchIndices[batchIndex] = (uint32_t)i;
+			mBatchTimes[batchIndex] = mTimes[i];
+		}
+
+		offset = 0;
+
+		for (size_t id = 0; id < (size_t)EaseId::NumEaseIds; ++id) {
+			const size_t count = numTweensPerEaseId[id];
+
+			if (count == 0) continue;
+
+			float * batchTimes = mBatchTimes.data() + offset;
+
+			if ((EaseId)id == EaseId::Custom) {
+				for (size_t j = 0; j < count; ++j) {
+					batchTimes[j] = tweens.easeFns[mBatchIndices[offset + j]](batchTimes[j]);
+				}
+			} else {
+				evaluateEaseBatch((EaseId)id, batchTimes, batchTimes, count);
+			}
+
+			offset += count;
+		}
+
+		for (size_t j = 0; j < numActiveTweens; ++j) {
+			mEasedTimes[mBatchIndices[j]] = mBatchTimes[j];
+		}
+	}
+
+	// write values
+	for (size_t i = 0; i < numTweens; ++i) {
+		const float t = mTimes[i];
+
+		if (t < 0) continue;
+
+		if (tweens.flags[i] & HasOwner) {
+			// owners that can't be seen catch up once they're stepped again; completion is never delayed
+			if (tweens.owners[i]->mIsAnimationThrottled && t < 1.0f) continue;
+			tweens.owners[i]->invalidate();
+		}
+
+		*tweens.targets[i]->ptr() = lerpValue(tweens.startValues[i], tweens.endValues[i], mEasedTimes[i]);
+
+		if (t >= 1.0f) {
+			mCompletedIndices.push_back((uint32_t)i);
+		}
+	}
+
+	// remove in reverse order so that swapped-in tweens are never completed ones
+	for (auto it = mCompletedIndices.rbegin(); it != mCompletedIndices.rend(); ++it) {
+		if (tweens.finishFns[*it]) {
+			mPendingFinishFns.push_back(std::move(tweens.finishFns[*it]));
+		}
+		removeTween(tweens, *it);
+	}
+
+	mCompletedIndices.clear();
+}
+
+template <typename T>
+void AnimationScheduler::removeTween(TweenArray<T> & tweens, const uint32_t index) {
+	if (tweens.flags[index] & HasOwner) {
+		tweens.owners[index]->mNumScheduledTweens--;
+	}
+
+	mLocationsByTarget.erase(tweens.targets[index]);
+
+	// swap with last tween
+	const uint32_t lastIndex = (uint32_t)tweens.size() - 1;
+
+	if (index != lastIndex) {
+		tweens.targets[index] = tweens.targets[lastIndex];
+		tweens.startValues[index] = tweens.startValues[lastIndex];
+		tweens.endValues[index] = tweens.endValues[lastIndex];
+		tweens.startTimes[index] = tweens.startTimes[lastIndex];
+		tweens.invDurations[index] = tweens.invDurations[lastIndex];
+		tweens.easeIds[index] = tweens.easeIds[lastIndex];
+		tweens.flags[index] = tweens.flags[lastIndex];
+		tweens.owners[index] = tweens.owners[lastIndex];
+		tweens.ids[index] = tweens.ids[lastIndex];
+		tweens.easeFns[index] = std::move(tweens.easeFns[lastIndex]);
+		tweens.finishFns[index] = std::move(tweens.finishFns[lastIndex]);
+		mLocationsByTarget.find(tweens.targets[index])->index = index;
+	}
+
+	tweens.targets.pop_back();
+	tweens.startValues.pop_back();
+	tweens.endValues.pop_back();
+	tweens.startTimes.pop_back();
+	tweens.invDurations.pop_back();
+	tweens.easeIds.pop_back();
+	tweens.flags.pop_back();
+	tweens.owners.pop_back();
+	tweens.ids.pop_back();
+	tweens.easeFns.pop_back();
+	tweens.finishFns.pop_back();
+}
+
+template <typename T>
+void AnimationScheduler::removeTweensOwnedBy(TweenArray<T> & tweens, const BaseView * owner) {
+	for (size_t i = tweens.size(); i-- > 0;) {
+		if (tweens.owners[i] == owner) {
+			removeTween(tweens, (uint32_t)i);
+		}
+	}
+}
+
+template <typename T>
+void AnimationScheduler::setTweenOwner(TweenArray<T> & tweens, const uint32_t index, BaseView * owner) {
+	if (tweens.flags[index] & HasOwner) {
+		tweens.owners[index]->mNumScheduledTweens--;
+	}
+
+	tweens.owners[index] = owner;
+
+	if (owner) {
+		owner->mNumScheduledTweens++;
+		tweens.flags[index] |= HasOwner;
+	} else {
+		tweens.flags[index] &= ~HasOwner;
+	}
+}
+
+template <typename T>
+void AnimationScheduler::setTweenDelay(TweenArray<T> & tweens, const uint32_t index, const float delay) {
+	tweens.startTimes[index] = mCurrentTime + (double)delay;
+}
+
+template <typename T>
+void AnimationScheduler::setTweenFinishFn(TweenArray<T> & tweens, const uint32_t index, const FinishFn & fn) {
+	tweens.finishFns[index] = fn;
+}
+
+// explicit instantiations for all supported types
+template AnimationScheduler::TweenId AnimationScheduler::addTween<float>(ci::Anim<float> *, const float *, const float &, const float, const Easing &);
+template AnimationScheduler::TweenId AnimationScheduler::addTween<vec2>(ci::Anim<vec2> *, const vec2 *, const vec2 &, const float, const Easing &);
+template AnimationScheduler::TweenId AnimationScheduler::addTween<quat>(ci::Anim<quat> *, const quat *, const quat &, const float, const Easing &);
+template AnimationScheduler::TweenId AnimationScheduler::addTween<Color>(ci::Anim<Color> *, const Color *, const Color &, const float, const Easing &);
+template AnimationScheduler::TweenId AnimationScheduler::addTween<ColorA>(ci::Anim<ColorA> *, const ColorA *, const ColorA &, const float, const Easing &);
+
+}
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/Tween.h"
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "AnimationEasing.h"
+#include "AnimationTargetTable.h"
+#include "SpringAnimator.h"
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class AnimationScheduler> AnimationSchedulerRef;
+typedef std::shared_ptr<class AnimationSequence> AnimationSequenceRef;
+
+class BaseView;
+
+//! Central animation engine for large numbers of simultaneous property tweens.
+//!
+//! Instead of heap-allocating a tween per animation on a per-view ci::Timeline, active tweens are stored in flat,
+//! type-segregated arrays (float, vec2, quat, Color and ColorA) of start value, end value, start time, duration and
+//! easing id. All tweens are advanced in a single pass per frame and written directly into their ci::Anim targets.
+//! Standard Cinder easings are evaluated in vectorized batches per EaseId (see evaluateEaseBatch()) without a
+//! std::function call per tween, custom ci::EaseFns are supported as a fallback.
+//!
+//! The BaseApp advances the shared instance once per frame before updating the scene. Tweens that are owned by a
+//! view invalidate that view whenever they change its values and are canceled when the view is destroyed or its
+//! animations are canceled. The scheduler is not thread-safe and should only be used on the main thread.
+//!
+//! Values of tweens whose owner is throttled (see BaseView::sAnimationThrottling) are only written when the owner's animations
+//! are stepped. Finish functions are always called on time.
+//!
+//! The scheduler also advances AnimationSequences, which chain AnimatedView transitions, delays and function calls,
+//! and owns a SpringAnimator for physics-based interactive motion (see getSprings()).
+//!
+//! Each target can only have one scheduled tween or spring at a time. Applying a new tween replaces the existing one.
+//! Tweens on ci::Timelines and the scheduler shouldn't be mixed on the same target.
+class AnimationScheduler {
+
+public:
+
+	typedef uint32_t				TweenId;	//! 0 is never used as a valid id
+	typedef std::function<void()>	FinishFn;
+
+	//! Easing of a scheduled tween. Can be implicitly created from an EaseId or any ci::EaseFn.
+	struct Easing {
+		EaseId		id = EaseId::None;
+		ci::EaseFn	fn;	//! Only set for EaseId::Custom
+
+		Easing(const EaseId id = EaseId::None) : id(id) {}
+
+		template <typename F>
+		Easing(F easeFn) {
+			const ci::EaseFn wrappedFn(easeFn);
+			id = getEaseId(wrappedFn);
+			if (id == EaseId::Custom) fn = wrappedFn;
+		}
+	};
+
+	//! Chainable options of a scheduled tween, similar to ci::Tween::Options.
+	//! Only valid until the next call to update() or any call that removes tweens.
+	class Options {
+	public:
+		Options & delay(const float value);
+		Options & finishFn(const FinishFn & fn);
+
+		//! Invalidates owner whenever the tween changes its target and cancels the tween when the owner is destroyed.
+		Options & owner(BaseView * view);
+
+		TweenId getId() const { return mId; }
+
+	protected:
+		friend class AnimationScheduler;
+		Options(AnimationScheduler * scheduler, const void * target, const TweenId id) : mScheduler(scheduler), mTarget(target), mId(id) {}
+
+		AnimationScheduler *	mScheduler;
+		const void *			mTarget;
+		TweenId					mId;
+	};
+
+	//! Shared instance that is advanced by the BaseApp.
+	static AnimationSchedulerRef get();
+
+	AnimationScheduler();
+	~AnimationScheduler();
+
+	//! Advances all tweens to time in seconds (same time base as BaseView::FrameInfo::absoluteTime) and calls the finish functions of completed tweens.
+	//! Then advances all springs and playing sequences.
+	void				update(const double time);
+
+	//! The time of the last update. Delays of new tweens are relative to this time.
+	double				getCurrentTime() const { return mCurrentTime; }
+
+	//! Animates target from its value when the tween starts to endValue.
+	template <typename T>
+	Options				apply(ci::Anim<T> * target, const T & endValue, const float duration, const Easing & easing = Easing());
+
+	//! Animates target from startValue to endValue. The target is set to startValue once the tween starts.
+	template <typename T>
+	Options				apply(ci::Anim<T> * target, const T & startValue, const T & endValue, const float duration, const Easing & easing = Easing());
+
+	//! Removes the tween of target without calling its finish function. Returns false if target has no tween.
+	bool				cancel(const void * target);
+
+	//! Removes all tweens and springs owned by view without calling their finish functions and cancels all sequences owned by view.
+	void				cancelAll(const BaseView * owner);
+
+	//! Removes all tweens, springs and sequences without calling their finish functions.
+	void				clear();
+
+	//! Plays sequence from its first stage, starting immediately. Cancels and restarts the sequence if it's already playing.
+	//! Sequences with an owner are canceled when the owner is destroyed or its animations are canceled.
+	void				play(AnimationSequenceRef sequence, BaseView * owner = nullptr);
+
+	//! Called by BaseView when view is removed from its parent. Playing sequences with steps of view are canceled
+	//! during the next update unless view has been added to another parent by then.
+	void				handleViewRemoved(const BaseView * view);
+
+	bool				isAnimating(const void * target) const	{ return mLocationsByTarget.find(target) != nullptr; }
+	size_t				getNumTweens() const;
+	size_t				getNumSequences() const	{ return mSequences.size(); }
+
+	//! Springs that are advanced with this scheduler. Setting a spring on a target cancels its scheduled tween.
+	SpringAnimatorRef	getSprings() const		{ return mSprings; }
+
+protected:
+
+	enum class TweenType : uint8_t { Float, Vec2, Quat, Color, ColorA };
+
+	enum TweenFlags : uint8_t {
+		NeedsStartValue = 1 << 0,	//! Start value is read from the target when the tween starts
+		HasOwner		= 1 << 1
+	};
+
+	//! Struct of arrays for all tweens of one value type. Entries at the same index belong to the same tween.
+	template <typename T>
+	struct TweenArray {
+		std::vector<ci::Anim<T> *>	targets;
+		std::vector<T>				startValues;
+		std::vector<T>				endValues;
+		std::vector<double>			startTimes;
+		std::vector<float>			invDurations;	//! 1 / duration or 0 for tweens without duration
+		std::vector<EaseId>			easeIds;
+		std::vector<uint8_t>		flags;
+		std::vector<BaseView *>		owners;
+		std::vector<TweenId>		ids;
+		std::vector<ci::EaseFn>		easeFns;		//! Only set for EaseId::Custom
+		std::vector<FinishFn>		finishFns;
+
+		size_t size() const { return targets.size(); }
+	};
+
+	struct TweenLocation {
+		TweenType	type;
+		uint32_t	index;
+	};
+
+	template <typename T> struct IsSupportedType : std::integral_constant<bool,
+		std::is_same<T, float>::value || std::is_same<T, ci::vec2>::value || std::is_same<T, ci::quat>::value ||
+		std::is_same<T, ci::Color>::value || std::is_same<T, ci::ColorA>::value> {};
+
+	template <typename T> TweenArray<T> &	getTweens();
+	template <typename T> static TweenType	getTweenType();
+
+	template <typename T>
+	TweenId				addTween(ci::Anim<T> * target, const T * startValue, const T & endValue, const float duration, const Easing & easing);
+
+	template <typename T>
+	void				updateTweens(TweenArray<T> & tweens, const double time);
+
+	template <typename T>
+	void				removeTween(TweenArray<T> & tweens, const uint32_t index);
+	void				removeTween(const TweenLocation & location);
+
+	template <typename T>
+	void				removeTweensOwnedBy(TweenArray<T> & tweens, const BaseView * owner);
+
+	template <typename T>
+	void				setTweenOwner(TweenArray<T> & tweens, const uint32_t index, BaseView * owner);
+	template <typename T>
+	void				setTweenDelay(TweenArray<T> & tweens, const uint32_t index, const float delay);
+	template <typename T>
+	void				setTweenFinishFn(TweenArray<T> & tweens, const uint32_t index, const FinishFn & fn);
+
+	void				updateSequences(const double time);
+	void				setSequenceOwner(AnimationSequence & sequence, BaseView * owner);
+
+	TweenArray<float>		mFloatTweens;
+	TweenArray<ci::vec2>	mVec2Tweens;
+	TweenArray<ci::quat>	mQuatTweens;
+	TweenArray<ci::Color>	mColorTweens;
+	TweenArray<ci::ColorA>	mColorATweens;
+
+	AnimationTargetTable<TweenLocation>				mLocationsByTarget;
+
+	std::vector<AnimationSequenceRef>				mSequences;
+	SpringAnimatorRef								mSprings;
+
+	// Scratch buffers reused across updates
+	std::vector<float>		mTimes;				//! Normalized time per tween or -1 if delayed
+	std::vector<float>		mEasedTimes;
+	std::vector<uint32_t>	mBatchIndices;		//! Active tween indices sorted by ease id
+	std::vector<float>		mBatchTimes;		//! Normalized times sorted by ease id, eased in place
+	std::vector<uint32_t>	mCompletedIndices;
+	std::vector<FinishFn>	mPendingFinishFns;	//! Called after all tweens have been advanced
+
+	double					mCurrentTime;
+	TweenId					mNextTweenId;
+};
+
+//==================================================
+// Template implementations
+//
+
+template <typename T>
+AnimationScheduler::Options AnimationScheduler::apply(ci::Anim<T> * target, const T & endValue, const float duration, const Easing & easing) {
+	static_assert(IsSupportedType<T>::value, "AnimationScheduler only supports float, vec2, quat, Color and ColorA tweens");
+	return Options(this, target, addTween<T>(target, nullptr, endValue, duration, easing));
+}
+
+template <typename T>
+AnimationScheduler::Options AnimationScheduler::apply(ci::Anim<T> * target, const T & startValue, const T & endValue, const float duration, const Easing & easing) {
+	static_assert(IsSupportedType<T>::value, "AnimationScheduler only supports float, vec2, quat, Color and ColorA tweens");
+	return Options(this, target, addTween<T>(target, &startValue, endValue, duration, easing));
+}
+
+}
+}
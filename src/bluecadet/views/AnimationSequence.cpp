@@ -0,0 +1,270 @@
+#include "AnimationSequence.h"
+
+#include <algorithm>
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Steps
+//
+
+AnimationSequence::Step AnimationSequence::Step::animateOn(AnimatedViewRef view) {
+	Step step;
+	step.type = Type::ANIMATE_ON;
+	step.view = view;
+	return step;
+}
+
+AnimationSequence::Step AnimationSequence::Step::animateOn(AnimatedViewRef view, const AnimatedView::Options & options) {
+	Step step = animateOn(view);
+	step.options = options;
+	step.hasOptions = true;
+	return step;
+}
+
+AnimationSequence::Step AnimationSequence::Step::animateOff(AnimatedViewRef view) {
+	Step step;
+	step.type = Type::ANIMATE_OFF;
+	step.view = view;
+	return step;
+}
+
+AnimationSequence::Step AnimationSequence::Step::animateOff(AnimatedViewRef view, const AnimatedView::Options & options) {
+	Step step = animateOff(view);
+	step.options = options;
+	step.hasOptions = true;
+	return step;
+}
+
+AnimationSequence::Step AnimationSequence::Step::delay(const float seconds) {
+	Step step;
+	step.type = Type::DELAY;
+	step.seconds = seconds;
+	return step;
+}
+
+AnimationSequence::Step AnimationSequence::Step::call(std::function<void()> fn) {
+	Step step;
+	step.type = Type::CALL;
+	step.fn = fn;
+	return step;
+}
+
+//==================================================
+// Lifecycle
+//
+
+AnimationSequence::AnimationSequence() :
+	mState(State::IDLE),
+	mRunId(0),
+	mCurrentStage(0),
+	mIsStageStarted(false),
+	mStageStartTime(0),
+	mOwner(nullptr),
+	mIsScheduled(false)
+{
+}
+
+AnimationSequence::~AnimationSequence() {
+}
+
+//==================================================
+// Building
+//
+
+AnimationSequence & AnimationSequence::then(const Step & step) {
+	mSteps.push_back(step);
+	mStageEnds.push_back(mSteps.size());
+	return *this;
+}
+
+AnimationSequence & AnimationSequence::all(std::initializer_list<Step> steps) {
+	if (steps.size() == 0) {
+		return *this;
+	}
+	mSteps.insert(mSteps.end(), steps.begin(), steps.end());
+	mStageEnds.push_back(mSteps.size());
+	return *this;
+}
+
+void AnimationSequence::clear() {
+	cancel();
+	mSteps.clear();
+	mStageEnds.clear();
+	mCurrentStage = 0;
+	mIsStageStarted = false;
+}
+
+void AnimationSequence::cancel() {
+	if (mState != State::PLAYING) {
+		return;
+	}
+	finish(false);
+}
+
+//==================================================
+// Playback
+//
+
+void AnimationSequence::start(const double time) {
+	mRunId++;
+	mRemovedViews.clear();
+	mState = State::PLAYING;
+	mCurrentStage = 0;
+	mIsStageStarted = false;
+	mStageStartTime = time;
+}
+
+void AnimationSequence::update(const double time) {
+	const size_t runId = mRunId;
+
+	// checked here instead of when views are removed, so that views which are only moved to another parent don't cancel
+	if (!mRemovedViews.empty()) {
+		const bool isCanceled = hasRemovedStepView();
+		mRemovedViews.clear();
+
+		if (isCanceled) {
+			finish(false);
+			return;
+		}
+	}
+
+	// steps can cancel or restart this sequence, so state is re-checked after each stage
+	while (mState == State::PLAYING && runId == mRunId) {
+		if (mCurrentStage >= mStageEnds.size()) {
+			finish(true);
+			return;
+		}
+
+		if (!mIsStageStarted) {
+			startStage(time);
+			continue;
+		}
+
+		switch (getStageState(time)) {
+			case StageState::RUNNING:
+				return;
+			case StageState::CANCELED:
+				finish(false);
+				return;
+			case StageState::COMPLETED:
+				mCurrentStage++;
+				mIsStageStarted = false;
+				break;
+		}
+	}
+}
+
+void AnimationSequence::startStage(const double time) {
+	const size_t runId = mRunId;
+	const size_t begin = mCurrentStage == 0 ? 0 : mStageEnds[mCurrentStage - 1];
+	const size_t end = mStageEnds[mCurrentStage];
+
+	mIsStageStarted = true;
+	mStageStartTime = time;
+
+	for (size_t i = begin; i < end && mState == State::PLAYING && runId == mRunId; ++i) {
+		const Step & step = mSteps[i];
+
+		switch (step.type) {
+			case Step::Type::ANIMATE_ON: {
+				auto view = step.view.lock();
+				if (!view) break; // canceled when checking the stage
+				if (step.hasOptions) {
+					view->animateOn(step.options);
+				} else {
+					view->animateOn();
+				}
+				break;
+			}
+			case Step::Type::ANIMATE_OFF: {
+				auto view = step.view.lock();
+				if (!view) break;
+				if (step.hasOptions) {
+					view->animateOff(step.options);
+				} else {
+					view->animateOff();
+				}
+				break;
+			}
+			case Step::Type::CALL: {
+				if (step.fn) {
+					auto fn = step.fn; // the step can be removed while fn is running
+					fn();
+				}
+				break;
+			}
+			case Step::Type::DELAY:
+				break;
+		}
+	}
+}
+
+AnimationSequence::StageState AnimationSequence::getStageState(const double time) const {
+	const size_t begin = mCurrentStage == 0 ? 0 : mStageEnds[mCurrentStage - 1];
+	const size_t end = mStageEnds[mCurrentStage];
+	bool isRunning = false;
+
+	for (size_t i = begin; i < end; ++i) {
+		const Step & step = mSteps[i];
+
+		switch (step.type) {
+			case Step::Type::ANIMATE_ON: {
+				auto view = step.view.lock();
+				if (!view || !view->shouldShow()) return StageState::CANCELED;
+				if (!view->isShowing()) isRunning = true;
+				break;
+			}
+			case Step::Type::ANIMATE_OFF: {
+				auto view = step.view.lock();
+				if (!view || view->shouldShow()) return StageState::CANCELED;
+				if (view->isShowing()) isRunning = true;
+				break;
+			}
+			case Step::Type::DELAY: {
+				if (time < mStageStartTime + (double)step.seconds) isRunning = true;
+				break;
+			}
+			case Step::Type::CALL:
+				break;
+		}
+	}
+
+	return isRunning ? StageState::RUNNING : StageState::COMPLETED;
+}
+
+bool AnimationSequence::hasRemovedStepView() const {
+	const size_t begin = mCurrentStage == 0 ? 0 : mStageEnds[mCurrentStage - 1];
+
+	for (size_t i = begin; i < mSteps.size(); ++i) {
+		const Step & step = mSteps[i];
+
+		if (step.type != Step::Type::ANIMATE_ON && step.type != Step::Type::ANIMATE_OFF) {
+			continue;
+		}
+
+		auto view = step.view.lock();
+
+		if (view && !view->getParent() && find(mRemovedViews.begin(), mRemovedViews.end(), view.get()) != mRemovedViews.end()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void AnimationSequence::finish(const bool completed) {
+	mState = completed ? State::COMPLETED : State::CANCELED;
+
+	if (mFinishFn) {
+		auto fn = mFinishFn; // can be replaced or restart this sequence
+		fn(completed);
+	}
+}
+
+}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+#include "AnimatedView.h"
+#include "AnimationScheduler.h"
+
+namespace bluecadet {
+namespace views {
+
+//! Staged transition of multiple AnimatedViews, delays and function calls that is advanced by the AnimationScheduler.
+//!
+//! Steps are stored in a single flat list and grouped into stages. Stages run one after another, all steps within a
+//! stage run in parallel:
+//!
+//!		typedef AnimationSequence::Step Step;
+//!		auto sequence = AnimationSequence::create();
+//!		sequence->then(Step::animateOn(title))
+//!			.then(Step::delay(0.2f))
+//!			.all({ Step::animateOn(image), Step::animateOff(menu, AnimatedView::Options().duration(0.5f)) })
+//!			.then(Step::call([=] { startAttractLoop(); }));
+//!		view->playSequence(sequence);
+//!
+//! Unlike callback chains on AnimatedView, steps don't allocate cues, signal connections or async dispatches. The
+//! completion of animateOn/animateOff steps is polled once per frame. A sequence is canceled when its owner is destroyed
+//! or its animations are canceled, when a view of a running step is destroyed, when a view of a running or upcoming step
+//! is removed from its parent and not added to another one by the next update, or when a running step's view is animated
+//! in the opposite direction by someone else. Sequences keep their steps and can be played multiple times.
+class AnimationSequence {
+
+public:
+
+	typedef std::function<void(bool completed)> FinishFn;
+
+	//! A single step of a sequence. Create steps with the static factory methods.
+	struct Step {
+		enum class Type { ANIMATE_ON, ANIMATE_OFF, DELAY, CALL };
+
+		static Step	animateOn(AnimatedViewRef view);
+		static Step	animateOn(AnimatedViewRef view, const AnimatedView::Options & options);
+		static Step	animateOff(AnimatedViewRef view);
+		static Step	animateOff(AnimatedViewRef view, const AnimatedView::Options & options);
+		static Step	delay(const float seconds);
+		static Step	call(std::function<void()> fn);
+
+		Type						type = Type::DELAY;
+		std::weak_ptr<AnimatedView>	view;
+		AnimatedView::Options		options;
+		bool						hasOptions = false;	//! Uses the view's default options if false
+		float						seconds = 0;
+		std::function<void()>		fn;
+	};
+
+	static AnimationSequenceRef create() { return std::make_shared<AnimationSequence>(); }
+
+	AnimationSequence();
+	~AnimationSequence();
+
+	//! Adds a stage with a single step that starts once all previous stages have completed.
+	AnimationSequence &	then(const Step & step);
+
+	//! Adds a stage with multiple steps that start at the same time. The next stage starts once all of them have completed.
+	AnimationSequence &	all(std::initializer_list<Step> steps);
+
+	//! Called with true once all stages have completed or with false if the sequence is canceled.
+	AnimationSequence &	finishFn(const FinishFn & fn) { mFinishFn = fn; return *this; }
+
+	//! Removes all steps. Cancels the sequence if it's playing.
+	void				clear();
+
+	//! Stops the sequence and calls its finish function with completed=false. Steps that are already running aren't stopped.
+	void				cancel();
+
+	bool				isPlaying() const	{ return mState == State::PLAYING; }
+	bool				isCompleted() const	{ return mState == State::COMPLETED; }
+	bool				isCanceled() const	{ return mState == State::CANCELED; }
+
+	size_t				getNumStages() const	{ return mStageEnds.size(); }
+	size_t				getCurrentStage() const	{ return mCurrentStage; }
+
+protected:
+
+	friend class AnimationScheduler;
+
+	enum class State { IDLE, PLAYING, COMPLETED, CANCELED };
+	enum class StageState { RUNNING, COMPLETED, CANCELED };
+
+	//! Restarts the sequence at time. Called by AnimationScheduler::play().
+	void				start(const double time);
+
+	//! Advances stages until one is still running. Called once per frame by the AnimationScheduler.
+	void				update(const double time);
+
+	void				startStage(const double time);
+	StageState			getStageState(const double time) const;
+	//! True if a view in mRemovedViews belongs to a step of the current or a later stage and still has no parent.
+	bool				hasRemovedStepView() const;
+	void				finish(const bool completed);
+
+	std::vector<Step>	mSteps;
+	std::vector<size_t>	mStageEnds;	//! Exclusive end index in mSteps per stage
+
+	State				mState;
+	size_t				mRunId;		//! Incremented on each start to detect restarts from within steps
+	size_t				mCurrentStage;
+	bool				mIsStageStarted;
+	double				mStageStartTime;
+	FinishFn			mFinishFn;
+
+	// Managed by the AnimationScheduler
+	BaseView *			mOwner;
+	bool				mIsScheduled;
+	std::vector<const BaseView *>	mRemovedViews;	//! Views removed from their parent since the last update. Only compared, never dereferenced.
+};
+
+}
+}
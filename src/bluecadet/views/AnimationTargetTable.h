@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace bluecadet {
+namespace views {
+
+//! Maps animation targets (e.g. ci::Anim pointers) to a small value such as the location of their tween.
+//!
+//! Open-addressing hash table with linear probing and backward shift deletion like touch::TouchSlotTable, so
+//! lookups, inserts and erases are O(1) and don't allocate once the table has grown to the peak number of targets.
+template <typename Value>
+class AnimationTargetTable {
+
+public:
+	AnimationTargetTable(const size_t initialCapacity = 64);
+
+	//! Returns the value of target or nullptr if target isn't in the table. Only valid until the next call to set() or erase().
+	Value *			find(const void * target);
+	const Value *	find(const void * target) const;
+
+	//! Adds target or replaces its value.
+	void			set(const void * target, const Value & value);
+
+	//! Removes target. Returns false if target isn't in the table.
+	bool			erase(const void * target);
+	void			clear();
+
+	size_t			size() const	{ return mSize; }
+	bool			empty() const	{ return mSize == 0; }
+
+protected:
+	struct Bucket {
+		const void *	target	= nullptr;	//! nullptr marks empty buckets
+		Value			value	= Value();
+	};
+
+	inline size_t	getHomeBucket(const void * target) const;
+	size_t			findBucket(const void * target) const;
+	void			growBuckets();
+
+	std::vector<Bucket>	mBuckets;		//! Linear probing, power of two size, max 50% load
+	size_t				mSize;
+	uint32_t			mHashShift;		//! 64 - log2(number of buckets)
+};
+
+//==================================================
+// Template implementations
+//
+
+template <typename Value>
+AnimationTargetTable<Value>::AnimationTargetTable(const size_t initialCapacity) :
+	mSize(0),
+	mHashShift(60)
+{
+	size_t numBuckets = 16;
+	while (numBuckets < initialCapacity * 2) {
+		numBuckets *= 2;
+		mHashShift--;
+	}
+	mBuckets.resize(numBuckets);
+}
+
+template <typename Value>
+Value * AnimationTargetTable<Value>::find(const void * target) {
+	const size_t bucketIndex = findBucket(target);
+	return bucketIndex == mBuckets.size() ? nullptr : &mBuckets[bucketIndex].value;
+}
+
+template <typename Value>
+const Value * AnimationTargetTable<Value>::find(const void * target) const {
+	const size_t bucketIndex = findBucket(target);
+	return bucketIndex == mBuckets.size() ? nullptr : &mBuckets[bucketIndex].value;
+}
+
+template <typename Value>
+void AnimationTargetTable<Value>::set(const void * target, const Value & value) {
+	if (!target) {
+		return;
+	}
+
+	const size_t existingIndex = findBucket(target);
+
+	if (existingIndex != mBuckets.size()) {
+		mBuckets[existingIndex].value = value;
+		return;
+	}
+
+	if ((mSize + 1) * 2 > mBuckets.size()) {
+		growBuckets();
+	}
+
+	const size_t mask = mBuckets.size() - 1;
+	size_t bucketIndex = getHomeBucket(target);
+	while (mBuckets[bucketIndex].target) {
+		bucketIndex = (bucketIndex + 1) & mask;
+	}
+	mBuckets[bucketIndex].target = target;
+	mBuckets[bucketIndex].value = value;
+	mSize++;
+}
+
+template <typename Value>
+bool AnimationTargetTable<Value>::erase(const void * target) {
+	size_t bucketIndex = findBucket(target);
+
+	if (bucketIndex == mBuckets.size()) {
+		return false;
+	}
+
+	mSize--;
+
+	// backward shift deletion keeps probe sequences intact without tombstones
+	const size_t mask = mBuckets.size() - 1;
+	size_t nextIndex = bucketIndex;
+
+	while (true) {
+		nextIndex = (nextIndex + 1) & mask;
+		const Bucket & next = mBuckets[nextIndex];
+
+		if (!next.target) {
+			break;
+		}
+
+		const size_t homeIndex = getHomeBucket(next.target);
+		const bool canShift = (nextIndex > bucketIndex)
+			? (homeIndex <= bucketIndex || homeIndex > nextIndex)
+			: (homeIndex <= bucketIndex && homeIndex > nextIndex);
+
+		if (canShift) {
+			mBuckets[bucketIndex] = next;
+			bucketIndex = nextIndex;
+		}
+	}
+
+	mBuckets[bucketIndex] = Bucket();
+	return true;
+}
+
+template <typename Value>
+void AnimationTargetTable<Value>::clear() {
+	std::fill(mBuckets.begin(), mBuckets.end(), Bucket());
+	mSize = 0;
+}
+
+template <typename Value>
+inline size_t AnimationTargetTable<Value>::getHomeBucket(const void * target) const {
+	// fibonacci hashing spreads aligned addresses evenly
+	return (size_t)(((uint64_t)(uintptr_t)target * 11400714819323198485ull) >> mHashShift);
+}
+
+template <typename Value>
+size_t AnimationTargetTable<Value>::findBucket(const void * target) const {
+	if (!target) {
+		return mBuckets.size();
+	}
+
+	const size_t mask = mBuckets.size() - 1;
+	size_t bucketIndex = getHomeBucket(target);
+
+	while (mBuckets[bucketIndex].target) {
+		if (mBuckets[bucketIndex].target == target) {
+			return bucketIndex;
+		}
+		bucketIndex = (bucketIndex + 1) & mask;
+	}
+
+	return mBuckets.size();
+}
+
+template <typename Value>
+void AnimationTargetTable<Value>::growBuckets() {
+	std::vector<Bucket> prevBuckets;
+	prevBuckets.swap(mBuckets);
+	mBuckets.resize(prevBuckets.size() * 2);
+	mHashShift--;
+
+	const size_t mask = mBuckets.size() - 1;
+
+	for (const auto & bucket : prevBuckets) {
+		if (!bucket.target) {
+			continue;
+		}
+		size_t bucketIndex = getHomeBucket(bucket.target);
+		while (mBuckets[bucketIndex].target) {
+			bucketIndex = (bucketIndex + 1) & mask;
+		}
+		mBuckets[bucketIndex] = bucket;
+	}
+}
+
+}
+}
@@ -12,6 +12,15 @@ using namespace std;
 namespace bluecadet {
 namespace views {
 
+namespace {
+	// ci::Timeline doesn't expose its items, but derived classes can name the protected member and read it from any timeline
+	struct TimelineItemsAccess : public ci::Timeline {
+		static const std::multimap<void *, TimelineItemRef> & get(const ci::Timeline & timeline) {
+			return timeline.*(&TimelineItemsAccess::mItems);
+		}
+	};
+}
+
 //==================================================
 // Defaults
 // 
@@ -20,12 +29,16 @@ bool BaseView::sEventPropagationEnabled = true;
 bool BaseView::sContentInvalidationEnabled = true;
 bool BaseView::sDrawDebugInfo = false;
 bool BaseView::sDrawDebugInfoWhenInvisible = false;
+bool BaseView::sBatchingEnabled = true;
+BaseView::AnimationThrottling BaseView::sAnimationThrottling;
+double BaseView::sFixedTime = -1.0;
 
 //==================================================
 // Lifecycle
 // 
 
 size_t BaseView::sNumInstances = 0;
+size_t BaseView::sNumUpdatePhases = 0;
 
 BaseView::BaseView() :
 	mTransformOrigin(vec2(0.0f)),
@@ -51,6 +64,19 @@ BaseView::BaseView() :
 	mParent(nullptr),
 
 	mTimeline(nullptr),
+	mNumScheduledTweens(0),
+	mNumBindings(0),
+	mAnimationVisibility(AnimationVisibility::VISIBLE),
+	mIsAnimationThrottled(false),
+	mNextAnimationStepTime(0),
+	mNextRequestedAnimationStepTime(numeric_limits<double>::max()),
+	mNextTimelineItemEndTime(numeric_limits<double>::max()),
+	mHasTimelineChanged(false),
+
+	mUpdateInterval(0),
+	mUpdatePhase(0),
+	mLastUpdateTime(-1.0),
+	mNextUpdateTime(-numeric_limits<double>::max()),
 
 	mViewId(sNumInstances++),
 	mViewIdStr(to_string(mViewId)),
@@ -61,6 +87,12 @@ BaseView::BaseView() :
 
 BaseView::~BaseView() {
 	mParent = nullptr;
+	if (mNumScheduledTweens > 0) {
+		AnimationScheduler::get()->cancelAll(this);
+	}
+	if (mNumBindings > 0) {
+		PropertyBindings::get()->unbindAll(this);
+	}
 }
 
 void BaseView::reset() {
@@ -82,6 +114,9 @@ void BaseView::reset() {
 	mAlpha = 1.0;
 	mIsHidden = false;
 	mShouldForceInvisibleDraw = false;
+	if (mNumScheduledTweens > 0) {
+		AnimationScheduler::get()->cancelAll(this);
+	}
 	mTimeline->clear();
 	mTimeline->removeSelf();
 	mTimeline = nullptr;
@@ -148,6 +183,7 @@ void BaseView::removeChild(BaseViewRef child) {
 	child->willMoveFromView(this);
 	child->mParent = nullptr;
 	mChildren.remove(child);
+	AnimationScheduler::get()->handleViewRemoved(child.get());
 }
 
 void BaseView::removeChild(BaseView* childPtr) {
@@ -164,6 +200,7 @@ BaseViewList::iterator BaseView::removeChild(BaseViewList::iterator childIt) {
   child->invalidate(true, false);
 	child->willMoveFromView(this);
 	child->mParent = nullptr;
+	AnimationScheduler::get()->handleViewRemoved(child.get());
 	return mChildren.erase(childIt);
 }
 
@@ -289,9 +326,44 @@ void BaseView::updateScene(const BaseView::FrameInfo & frameInfo) {
 		dispatchEvent(ViewEvent(ViewEvent::Type::CONTENT_INVALIDATED, getSharedViewPtr()));
 	}
 
-	update(frameInfo);
+	if (mUpdateInterval <= 0) {
+		update(frameInfo);
+
+	} else if (frameInfo.absoluteTime >= mNextUpdateTime) {
+		const double time = frameInfo.absoluteTime;
+		const double deltaTime = mLastUpdateTime < 0 ? frameInfo.deltaTime : time - mLastUpdateTime;
+		const double offset = mUpdatePhase * mUpdateInterval;
+
+		// next update on this view's phase of the interval grid; frames that arrive late don't shift the grid
+		mLastUpdateTime = time;
+		mNextUpdateTime = (floor((time - offset) / mUpdateInterval) + 1.0) * mUpdateInterval + offset;
+
+		if (mNextUpdateTime <= time) {
+			mNextUpdateTime += mUpdateInterval;
+		}
+
+		update(FrameInfo(time, deltaTime));
+	}
+
+	if (sAnimationThrottling.enabled) {
+		updateAnimationThrottling(frameInfo.absoluteTime);
+	} else if (mIsAnimationThrottled || mAnimationVisibility != AnimationVisibility::VISIBLE) {
+		mAnimationVisibility = AnimationVisibility::VISIBLE;
+		mIsAnimationThrottled = false;
+	}
 
-	advanceTimeline(mTimeline, frameInfo);
+	if (!mIsAnimationThrottled) {
+		advanceTimeline(mTimeline, frameInfo);
+	}
+
+	if (frameInfo.absoluteTime >= mNextRequestedAnimationStepTime) {
+		// remove all requests that have been fulfilled by this step
+		const double time = frameInfo.absoluteTime;
+		mRequestedAnimationStepTimes.erase(remove_if(mRequestedAnimationStepTimes.begin(), mRequestedAnimationStepTimes.end(),
+			[time](const double requestedTime) { return requestedTime <= time; }), mRequestedAnimationStepTimes.end());
+		mNextRequestedAnimationStepTime = mRequestedAnimationStepTimes.empty() ? numeric_limits<double>::max()
+			: *min_element(mRequestedAnimationStepTimes.begin(), mRequestedAnimationStepTimes.end());
+	}
 
 	for (auto child : mChildren) {
 		child->updateScene(frameInfo);
@@ -364,6 +436,28 @@ void BaseView::drawScene(const ColorA & parentDrawColor) {
 	}
 }
 
+void BaseView::drawSceneBatched(SpriteBatch & batch, const ColorA & parentDrawColor) {
+	if (!mShouldForceInvisibleDraw && (mIsHidden || mAlpha <= 0.0f)) {
+		return;
+	}
+
+	validateTransforms();
+	validateContent();
+
+	const auto & tint = mTint.value();
+
+	mDrawColor.r = tint.r * parentDrawColor.r;
+	mDrawColor.g = tint.g * parentDrawColor.g;
+	mDrawColor.b = tint.b * parentDrawColor.b;
+	mDrawColor.a = mAlpha.value() * parentDrawColor.a;
+
+	mDrawBlendMode = mParent ? mParent->mDrawBlendMode : BlendMode::ALPHA;
+
+	willDraw();
+	drawBatched(batch, gl::getModelMatrix() * mTransform);
+	didDraw();
+}
+
 const std::string BaseView::getClassName(const bool stripNameSpace) const {
 	string name = typeid(*this).name();
 	if (stripNameSpace) {
@@ -429,6 +523,9 @@ void BaseView::cancelAnimations() {
 	if (mTimeline) {
 		mTimeline->clear();
 	}
+	if (mNumScheduledTweens > 0) {
+		AnimationScheduler::get()->cancelAll(this);
+	}
 	mPosition.stop();
 	mRotation.stop();
 	mScale.stop();
@@ -441,8 +538,11 @@ inline TimelineRef BaseView::getTimeline(bool stepToNow) {
 		mTimeline = Timeline::create();
 		mTimeline->setAutoRemove(false);
 	}
+	// callers can add items that need to end on time even if this view is throttled
+	mHasTimelineChanged = true;
+
 	if (stepToNow) {
-		advanceTimeline(mTimeline, FrameInfo(timeline().getCurrentTime()));
+		advanceTimeline(mTimeline, FrameInfo(sFixedTime >= 0 ? sFixedTime : timeline().getCurrentTime()));
 	}
 	return mTimeline;
 }
@@ -458,7 +558,110 @@ inline void BaseView::advanceTimeline(ci::TimelineRef timeline, const BaseView::
 }
 
 CueRef BaseView::dispatchAfter(std::function<void()> fn, float delay) {
-	return getTimeline()->add(fn, getTimeline()->getCurrentTime() + delay);
+	const float time = getTimeline()->getCurrentTime() + delay;
+	requestAnimationStep(time);
+	return getTimeline()->add(fn, time);
+}
+
+void BaseView::setUpdateInterval(const double interval, const double phase) {
+	mUpdateInterval = max(0.0, interval);
+
+	if (phase >= 0) {
+		mUpdatePhase = fmod(phase, 1.0);
+	} else {
+		// golden ratio sequence spreads any number of views evenly across the interval
+		mUpdatePhase = fmod((double)(sNumUpdatePhases++) * 0.6180339887498949, 1.0);
+	}
+
+	if (mUpdateInterval <= 0) {
+		mLastUpdateTime = -1.0;
+		mNextUpdateTime = -numeric_limits<double>::max();
+
+	} else if (mLastUpdateTime >= 0) {
+		const double offset = mUpdatePhase * mUpdateInterval;
+		mNextUpdateTime = (floor((mLastUpdateTime - offset) / mUpdateInterval) + 1.0) * mUpdateInterval + offset;
+	}
+}
+
+void BaseView::requestAnimationStep(const double time) {
+	mRequestedAnimationStepTimes.push_back(time);
+	mNextRequestedAnimationStepTime = std::min(mNextRequestedAnimationStepTime, time);
+}
+
+void BaseView::updateAnimationThrottling(const double time) {
+	mAnimationVisibility = getAnimationVisibility();
+
+	if (mAnimationVisibility == AnimationVisibility::VISIBLE) {
+		mIsAnimationThrottled = false;
+		mNextAnimationStepTime = time;
+		return;
+	}
+
+	if (mHasTimelineChanged) {
+		mNextTimelineItemEndTime = getNextTimelineItemEndTime();
+		mHasTimelineChanged = false;
+	}
+
+	mIsAnimationThrottled = time < mNextAnimationStepTime && time < mNextRequestedAnimationStepTime
+		&& time < mNextTimelineItemEndTime;
+
+	if (!mIsAnimationThrottled) {
+		const double interval = mAnimationVisibility == AnimationVisibility::OFFSCREEN
+			? sAnimationThrottling.offscreenInterval
+			: sAnimationThrottling.invisibleInterval;
+		mNextAnimationStepTime = time + interval;
+		// stepping completes items and their finish functions can add new ones
+		mHasTimelineChanged = true;
+	}
+}
+
+double BaseView::getNextTimelineItemEndTime() const {
+	double endTime = numeric_limits<double>::max();
+
+	if (!mTimeline || mTimeline->empty()) {
+		return endTime;
+	}
+
+	const double currentTime = mTimeline->getCurrentTime();
+
+	for (const auto & it : TimelineItemsAccess::get(*mTimeline)) {
+		const double itemEndTime = it.second->getEndTime();
+
+		if (itemEndTime > currentTime && itemEndTime < endTime) {
+			endTime = itemEndTime;
+		}
+	}
+
+	return endTime;
+}
+
+BaseView::AnimationVisibility BaseView::getAnimationVisibility() {
+	// a view's own timeline can still fade or show it, so only children of hidden or transparent views are invisible
+	if (mParent) {
+		const bool parentIsInvisible = mParent->mAnimationVisibility == AnimationVisibility::INVISIBLE
+			|| (!mParent->mShouldForceInvisibleDraw && (mParent->mIsHidden || mParent->mAlpha.value() <= 0.0f))
+			|| !mParent->areChildrenDrawn();
+
+		if (parentIsInvisible) {
+			return AnimationVisibility::INVISIBLE;
+		}
+	}
+
+	// only cull leaf views with animations since children can be drawn outside of their parent's bounds
+	const Rectf & cullingBounds = sAnimationThrottling.cullingBounds;
+
+	if (cullingBounds.getWidth() <= 0 || cullingBounds.getHeight() <= 0
+		|| !mChildren.empty() || mSize.x <= 0 || mSize.y <= 0
+		|| (!mTimeline && mNumScheduledTweens == 0)) {
+		return AnimationVisibility::VISIBLE;
+	}
+
+	const mat4 & transform = getGlobalTransform();
+	Rectf globalBounds(vec2(transform * vec4(0, 0, 0, 1)), vec2(transform * vec4(mSize.x, mSize.y, 0, 1)));
+	globalBounds.include(vec2(transform * vec4(mSize.x, 0, 0, 1)));
+	globalBounds.include(vec2(transform * vec4(0, mSize.y, 0, 1)));
+
+	return cullingBounds.intersects(globalBounds) ? AnimationVisibility::VISIBLE : AnimationVisibility::OFFSCREEN;
 }
 
 //==================================================
@@ -18,6 +18,9 @@
 
 #include "ViewEvent.h"
 #include "AnimOperators.h"
+#include "AnimationScheduler.h"
+#include "PropertyBindings.h"
+#include "SpriteBatch.h"
 
 namespace bluecadet {
 namespace views {
@@ -78,6 +81,34 @@ public:
 	//! Defaults to false. When sDrawDebugInfo is set to true, this setting will also draw any invisible views
 	static bool				sDrawDebugInfoWhenInvisible;
 
+	//! Defaults to true. Consecutive sibling views without children that can be drawn batched (see canDrawBatched())
+	//! are drawn with a shared SpriteBatch, e.g. ImageViews displaying images of the same TextureAtlas page.
+	static bool				sBatchingEnabled;
+
+	//! Level of detail for animations of views that can't be seen.
+	//! When enabled, timelines and scheduled tweens of children of hidden or fully transparent views, of children of FboViews
+	//! that haven't been drawn since the last update and of views outside of cullingBounds are advanced at a reduced rate.
+	//! They catch up as soon as the view becomes visible again. Throttled timelines are also stepped at the end time of each
+	//! of their items, so cues and tween finish functions still fire on time, as do AnimationScheduler finish functions.
+	//! Tween update functions are called at the reduced rate.
+	struct AnimationThrottling {
+		bool		enabled				= false;
+		double		invisibleInterval	= 0.5;			//! Seconds between animation steps of views with a hidden or fully transparent ancestor
+		double		offscreenInterval	= 1.0 / 15.0;	//! Seconds between animation steps of views outside of cullingBounds
+		ci::Rectf	cullingBounds		= ci::Rectf(0, 0, 0, 0);	//! Visible area in root view coordinates; Culling is disabled when empty. Set to the ScreenCamera viewport by BaseApp.
+	};
+
+	//! Disabled by default. BaseApp applies SettingsManager::mAnimationThrottlingEnabled during setup.
+	static AnimationThrottling	sAnimationThrottling;
+
+	//! Time in seconds that replaces wall time for default FrameInfos and for timelines that are created or stepped outside
+	//! of updateScene(). Negative by default, which uses wall time. Set by BaseApp in fixed timestep mode
+	//! (SettingsManager::mFixedTimestep) so that all view animations follow FrameInfo::absoluteTime.
+	static double				sFixedTime;
+
+	//! Returns sFixedTime if it's set or wall time since app launch otherwise.
+	static double				getCurrentTime() { return sFixedTime >= 0 ? sFixedTime : ci::app::getElapsedSeconds(); }
+
 	enum class BlendMode {
 		INHERIT,
 		ALPHA,
@@ -90,7 +121,7 @@ public:
 	struct FrameInfo {
 		double absoluteTime;
 		double deltaTime;
-		FrameInfo(double absoluteTime = ci::app::getElapsedSeconds(), double deltaTime = 0) : absoluteTime(absoluteTime), deltaTime(deltaTime) {}
+		FrameInfo(double absoluteTime = getCurrentTime(), double deltaTime = 0) : absoluteTime(absoluteTime), deltaTime(deltaTime) {}
 	};
 
 	//==================================================
@@ -270,7 +301,53 @@ public:
 	inline ci::TimelineRef	getTimeline(bool stepToNow = true);
 
 	//! Optional method to set this view's timeline to a specific timeline. Can be used to share timelines across views.
-	inline void				setTimeline(ci::TimelineRef timeline) { mTimeline = timeline; }
+	inline void				setTimeline(ci::TimelineRef timeline) { mTimeline = timeline; mHasTimelineChanged = true; }
+
+	//! Guarantees that this view's timeline is stepped at time (in timeline time) even if its animations are throttled.
+	//! Use this for cues that are added directly to the timeline and need to fire on time. See sAnimationThrottling.
+	void					requestAnimationStep(const double time);
+
+	//! True if this view's animations have been skipped during the last update because they can't be seen. See sAnimationThrottling.
+	bool					isAnimationThrottled() const { return mIsAnimationThrottled; }
+
+	//! Calls update() only every interval seconds instead of on every frame (e.g. 1.0 / 15.0 for a clock or data ticker).
+	//! Children, timelines and scheduled animations are not affected. 0 (the default) updates on every frame.
+	//! Phase offsets update() calls within the interval (0 to 1). By default, phases are assigned from a low-discrepancy sequence
+	//! so that views with the same interval are spread evenly across frames instead of all updating on the same frame.
+	//! FrameInfo::deltaTime passed to update() is the time since this view's previous update().
+	void					setUpdateInterval(const double interval, const double phase = -1.0);
+	double					getUpdateInterval() const	{ return mUpdateInterval; }
+	double					getUpdatePhase() const		{ return mUpdatePhase; }
+
+	//! Animates a property of this view (e.g. getPosition()) on the shared AnimationScheduler instead of this view's timeline.
+	//! Scales better than timelines for large numbers of simultaneous tweens. Tweens are canceled with cancelAnimations().
+	template <typename T>
+	AnimationScheduler::Options	animate(ci::Anim<T> & property, const T & endValue, const float duration, const AnimationScheduler::Easing & easing = AnimationScheduler::Easing()) {
+		return AnimationScheduler::get()->apply(&property, endValue, duration, easing).owner(this);
+	}
+	template <typename T>
+	AnimationScheduler::Options	animate(ci::Anim<T> & property, const T & startValue, const T & endValue, const float duration, const AnimationScheduler::Easing & easing = AnimationScheduler::Easing()) {
+		return AnimationScheduler::get()->apply(&property, startValue, endValue, duration, easing).owner(this);
+	}
+
+	//! Moves a property of this view towards target with a damped spring on the shared AnimationScheduler. Calling this again
+	//! while the spring is moving only retargets it and keeps its velocity, so it's safe to call on every touch move.
+	//! Springs are canceled with cancelAnimations(). See SpringAnimator.
+	template <typename T>
+	SpringAnimator::Options		spring(ci::Anim<T> & property, const T & target, const SpringAnimator::Params & params = SpringAnimator::Params()) {
+		return AnimationScheduler::get()->getSprings()->setTarget(&property, target, params).owner(this);
+	}
+
+	//! Binds a property of this view to fn(sources...) on the shared PropertyBindings. The binding is only evaluated when one
+	//! of its sources changes and is removed when this view is destroyed. Chain dependsOn() with the views that own the sources.
+	template <typename T, typename F, typename... S>
+	PropertyBindings::Options	bind(ci::Anim<T> & property, F fn, ci::Anim<S> &... sources) {
+		return PropertyBindings::get()->bind(property, fn, sources...).owner(this);
+	}
+
+	//! Plays an AnimationSequence on the shared AnimationScheduler. The sequence is canceled with cancelAnimations() or when this view is destroyed.
+	//! It's also canceled if the view of one of its remaining steps is removed from its parent (see AnimationSequence).
+	void						playSequence(AnimationSequenceRef sequence) { AnimationScheduler::get()->play(sequence, this); }
 
 	//==================================================
 	// Coordinate space conversions
@@ -361,6 +438,12 @@ protected:
 	inline virtual void	drawChildren(const ci::ColorA & parentDrawColor); //! Called by drawScene() after draw() and before didDraw(). Implemented at bottom of class.
 	inline virtual void	didDraw() {}							//! Called by drawScene after draw()
 
+	//! Return true if this view's draw() can be replaced with drawBatched() during the current frame. Views that return
+	//! true are drawn without their own GL state and their draw() isn't called, so implementations should only return true for
+	//! subclasses that explicitly opt in (see ImageView::setBatchingSupported()).
+	virtual bool		canDrawBatched() { return false; }
+	virtual void		drawBatched(SpriteBatch & batch, const ci::mat4 & transform) {}	//! Called instead of draw() with the view's model matrix if canDrawBatched() returns true.
+
 	inline virtual void didMoveToView(BaseView * parent) {}		//! Called when moved to a parent
 	inline virtual void willMoveFromView(BaseView * parent) {}	//! Called when removed from a parent
 
@@ -370,6 +453,13 @@ protected:
 	//! Progresses the timeline
 	virtual void			advanceTimeline(ci::TimelineRef timeline, const FrameInfo & frameInfo);
 
+	//! Determines whether animations of this view should be skipped at time based on sAnimationThrottling.
+	virtual void			updateAnimationThrottling(const double time);
+
+	//! Return false if this view's children haven't been drawn since the last update even though this view isn't hidden or
+	//! transparent, e.g. for views that draw their children offscreen. Children are then considered invisible by sAnimationThrottling.
+	virtual bool			areChildrenDrawn() const { return true; }
+
 	//! Marks the transformation matrix (and all of its children's matrices) as invalid. This will cause the matrices to be re-calculated when necessary.
 	//! When content is true, marks the content as invalid and will dispatch a content updated event
 	inline void invalidate(const bool transforms = true, const bool content = true);
@@ -380,20 +470,47 @@ protected:
 
 private:
 
+	friend class AnimationScheduler;
+	friend class SpringAnimator;
+	friend class PropertyBindings;
+
 	// Helpers
 	inline BaseViewList::iterator getChildIt(BaseViewRef child);
 	inline BaseViewList::iterator getChildIt(BaseView* childPtr);
 
+	//! Equivalent of drawScene() for views that can be drawn batched.
+	void								drawSceneBatched(SpriteBatch & batch, const ci::ColorA & parentDrawColor);
+
 	inline static ci::gl::BatchRef		getDefaultDrawBatch();	//! Default shader batch that draws the background in the default implementation of draw().
 	inline static ci::gl::GlslProgRef	getDefaultDrawProg();	//! Default glsl program used by the default batch that draws a rectangular background using background color and size.
 
+	enum class AnimationVisibility { VISIBLE, OFFSCREEN, INVISIBLE };
+	AnimationVisibility					getAnimationVisibility();
+	double								getNextTimelineItemEndTime() const;
+
 	static size_t sNumInstances;
+	static size_t sNumUpdatePhases;	// Number of automatically assigned update phases
 
 	// Properties
 	BaseView* mParent;
 	BaseViewList mChildren;
 
 	ci::TimelineRef mTimeline;
+	size_t mNumScheduledTweens;	// Number of tweens, springs and sequences owned by this view on the AnimationScheduler
+	size_t mNumBindings;		// Number of PropertyBindings owned by or depending on this view
+
+	AnimationVisibility mAnimationVisibility;
+	bool mIsAnimationThrottled;
+	double mNextAnimationStepTime;			// Next time throttled animations are advanced
+	double mNextRequestedAnimationStepTime;	// Earliest of mRequestedAnimationStepTimes
+	double mNextTimelineItemEndTime;		// Earliest end time of an item on mTimeline that hasn't been reached yet
+	bool mHasTimelineChanged;				// Set when mTimeline may have been modified since mNextTimelineItemEndTime was determined
+	std::vector<double> mRequestedAnimationStepTimes;
+
+	double mUpdateInterval;		// 0 to update on every frame
+	double mUpdatePhase;
+	double mLastUpdateTime;		// Time of the last update() if mUpdateInterval is set, otherwise -1
+	double mNextUpdateTime;
 
 	ci::Anim<float> mAlpha;
 	ci::Anim<ci::Color> mTint;
@@ -442,9 +559,25 @@ private:
 // 
 
 void BaseView::drawChildren(const ci::ColorA& parentDrawColor) {
+	if (!sBatchingEnabled || sDrawDebugInfo) {
+		for (auto child : mChildren) {
+			child->drawScene(parentDrawColor);
+		}
+		return;
+	}
+
+	SpriteBatch & batch = *SpriteBatch::get();
+
 	for (auto child : mChildren) {
-		child->drawScene(parentDrawColor);
+		if (child->mChildren.empty() && child->mBlendMode == BlendMode::INHERIT && child->canDrawBatched()) {
+			child->drawSceneBatched(batch, parentDrawColor);
+		} else {
+			batch.flush();
+			child->drawScene(parentDrawColor);
+		}
 	}
+
+	batch.flush();
 }
 
 void BaseView::validateTransforms(const bool force) {
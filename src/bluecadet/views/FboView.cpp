@@ -11,6 +11,8 @@ FboView::FboView() : BaseView(),
 mFbo(nullptr),
 mForceRedraw(false),
 mDrawsToScreen(true),
+mWasDrawnLastFrame(true),
+mHasDrawn(false),
 mResolution(1.0f),
 mClearColor(ci::ColorA(0, 0, 0, 0))
 {
@@ -23,6 +25,7 @@ mClearColor(ci::ColorA(0, 0, 0, 0))
 }
 
 FboView::~FboView() {
+	cancelFboTask();
 }
 
 void FboView::setup(const ci::ivec2 & size, const float resolution) {
@@ -45,11 +48,23 @@ ci::gl::FboRef FboView::createFbo(const ci::ivec2 & size, const ci::gl::Fbo::For
 }
 
 void FboView::validateFbo(){
+	if (isFboPending()) {
+		return;
+	}
+
 	const ivec2 size = glm::ceil(mResolution * getSize());
 	if (size.x > 0 && size.y > 0) {
-		mFbo = createFbo(size, getFboFormat());
-		// Invalidate content to confirm it will redraw to fbo
-		invalidate(false, true);
+		// rgba color texture plus a third for mip levels
+		size_t numBytes = (size_t)size.x * (size_t)size.y * 4;
+		if (getFboFormat().getColorTextureFormat().hasMipmapping()) {
+			numBytes += numBytes / 3;
+		}
+
+		mFboTask = core::UploadScheduler::get()->schedule([this, size] {
+			mFbo = createFbo(size, getFboFormat());
+			// Invalidate content to confirm it will redraw to fbo
+			invalidate(false, true);
+		}, numBytes);
 	}
 }
 
@@ -83,12 +98,18 @@ inline void FboView::validateContent(){
 		// Set mHasInvalidContent back to false so it doesn't continue to validate on every draw
 		BaseView::validateContent();
 	}
-	else {
+	else if (!isFboPending()) {
 		console() << "FboView Warning: No fbo to validate content in (size: " << getSize() << ")" << endl;
 	}
 
 }
 
+void FboView::updateAnimationThrottling(const double time) {
+	BaseView::updateAnimationThrottling(time);
+	mWasDrawnLastFrame = mHasDrawn;
+	mHasDrawn = false;
+}
+
 void FboView::handleEvent(ViewEvent& event) {
 	if (event.type == ViewEvent::Type::CONTENT_INVALIDATED) {
 		invalidate(false, true);
@@ -96,9 +117,14 @@ void FboView::handleEvent(ViewEvent& event) {
 }
 
 void FboView::draw() {
-	
+	mHasDrawn = true;
+
 	if (!mFbo) {
-		console() << "FboView Warning: No fbo to draw to (size: " << getSize() << ")" << endl;
+		if (isFboPending()) {
+			BaseView::draw(); // only draw the background until the fbo is allocated
+		} else {
+			console() << "FboView Warning: No fbo to draw to (size: " << getSize() << ")" << endl;
+		}
 		return;
 	}
 
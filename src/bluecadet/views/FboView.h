@@ -4,6 +4,7 @@
 #include "cinder/gl/gl.h"
 
 #include "BaseView.h"
+#include "../core/UploadScheduler.h"
 
 namespace bluecadet {
 namespace views {
@@ -24,7 +25,7 @@ public:
 	void			setSize(const ci::vec2 & size) override;
 
 	//! Will re-create the current fbo on the next draw call and marks the content to be re-drawn.
-	virtual void	invalidateFbo() { mFbo = nullptr; invalidate(false, true); }
+	virtual void	invalidateFbo() { cancelFboTask(); mFbo = nullptr; invalidate(false, true); }
 
 	//! Will create a new fbo with this format.
 	virtual void	setFboFormat(const ci::gl::Fbo::Format & format) { mFboFormat = format; invalidateFbo(); }
@@ -41,6 +42,7 @@ public:
 
 	//! Returns the fbo for this view. Be careful with this method since
 	//!  - The result might be nullptr if the FBO hasn't been initialized (e.g. if setup was called).
+	//!  - FBOs are allocated via the UploadScheduler, so a new FBO might only be available a few frames after it's been invalidated.
 	//!  - A new FBO might be recreated if the view's size is changed, so don't retain this FBO anywhere else.
 	ci::gl::FboRef			getFbo() const { return mFbo; }
 
@@ -65,11 +67,18 @@ protected:
 
 	virtual ci::gl::FboRef	createFbo(const ci::ivec2 & size, const ci::gl::Fbo::Format & format);
 
+	//! Queues the allocation of a new fbo with the UploadScheduler. Only the background is drawn until it's allocated.
 	void			validateFbo();
+	bool			isFboPending() const { return mFboTask && !mFboTask->isComplete() && !mFboTask->isCanceled(); }
+	void			cancelFboTask() { if (mFboTask) { mFboTask->cancel(); mFboTask = nullptr; } }
 
 	//! Redraw the fbo children
 	inline void		validateContent() override;
 
+	//! Children are only visible through the fbo, so their animations can be throttled while this view isn't drawn.
+	void			updateAnimationThrottling(const double time) override;
+	bool			areChildrenDrawn() const override { return mWasDrawnLastFrame; }
+
 	//! Draw content within this view
 	void			draw() override;
 
@@ -78,10 +87,13 @@ protected:
 
 	bool					mForceRedraw;
 	bool					mDrawsToScreen;
+	bool					mWasDrawnLastFrame;
+	bool					mHasDrawn;				//! Set by draw() and consumed on the next update
 	float					mResolution;
 
 	ci::gl::Fbo::Format		mFboFormat;
 	ci::gl::FboRef			mFbo; //! Careful, if fbo is invalidated this could be NULL!
+	core::UploadScheduler::TaskRef	mFboTask;
 
 	ci::ColorA				mClearColor;
 
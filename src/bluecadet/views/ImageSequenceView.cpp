@@ -0,0 +1,418 @@
+#include "ImageSequenceView.h"
+
+#include "cinder/Log.h"
+#include "cinder/Timer.h"
+
+#include "../core/UploadScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+namespace {
+	bool isCompressedTexture(const fs::path & path) {
+		string extension = path.extension().string();
+		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		return extension == ".dds" || extension == ".ktx";
+	}
+
+	bool isImage(const fs::path & path) {
+		static const vector<string> extensions = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".tif", ".tiff", ".dds", ".ktx" };
+		string extension = path.extension().string();
+		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		return find(extensions.begin(), extensions.end(), extension) != extensions.end();
+	}
+}
+
+//==================================================
+// Lifecycle
+//
+
+ImageSequenceView::ImageSequenceView() : ImageView(),
+	mFramesPerSecond(30.0f),
+	mSpeed(1.0f),
+	mLookAhead(8),
+	mIsPlaying(false),
+	mIsLooping(true),
+	mDropFramesEnabled(true),
+	mShouldResizeToFrames(true),
+	mIsStalled(false),
+	mTime(0),
+	mCurrentFrame(0),
+	mDisplayedFrame(-1),
+	mNumDecodedFramesInWindow(0),
+	mDecodeWindowStartTime(-1)
+{
+	// frames are drawn by ImageView::draw()
+	setBatchingSupported(true);
+}
+
+ImageSequenceView::~ImageSequenceView() {
+	releaseFrames();
+}
+
+void ImageSequenceView::reset() {
+	ImageView::reset();
+	releaseFrames();
+	mFrames.clear();
+	mFramePaths.clear();
+	mFrameTexture = nullptr;
+	mIsPlaying = false;
+	mIsStalled = false;
+	mTime = 0;
+	mCurrentFrame = 0;
+	mDisplayedFrame = -1;
+}
+
+void ImageSequenceView::setup(const std::vector<ci::fs::path> & framePaths, const float framesPerSecond, const bool resizeToFrames) {
+	releaseFrames();
+	mFrames.clear();
+
+	mFramePaths = framePaths;
+	mFramesPerSecond = framesPerSecond;
+	mShouldResizeToFrames = resizeToFrames;
+	mIsStalled = false;
+	mTime = 0;
+	mCurrentFrame = 0;
+	mDisplayedFrame = -1;
+
+	applyTexture(nullptr, Area(), resizeToFrames);
+	resetStats();
+}
+
+bool ImageSequenceView::load(const ci::fs::path & directory, const float framesPerSecond, const bool resizeToFrames) {
+	const fs::path resolvedPath = directory.is_absolute() ? directory : getAssetPath(directory);
+
+	if (resolvedPath.empty() || !fs::is_directory(resolvedPath)) {
+		CI_LOG_E("Could not find image sequence at '" << directory << "'");
+		return false;
+	}
+
+	vector<fs::path> framePaths;
+
+	for (fs::directory_iterator it(resolvedPath), end; it != end; ++it) {
+		if (fs::is_regular_file(it->path()) && isImage(it->path())) {
+			framePaths.push_back(it->path());
+		}
+	}
+
+	if (framePaths.empty()) {
+		CI_LOG_E("Image sequence at '" << directory << "' doesn't contain any images");
+		return false;
+	}
+
+	sort(framePaths.begin(), framePaths.end());
+	setup(framePaths, framesPerSecond, resizeToFrames);
+	return true;
+}
+
+void ImageSequenceView::willMoveFromView(BaseView * parent) {
+	ImageView::willMoveFromView(parent);
+
+	// the displayed frame stays in mFrameTexture; buffered frames are decoded again once this view is updated
+	releaseFrames();
+}
+
+//==================================================
+// Playback
+//
+
+void ImageSequenceView::play() {
+	if (!mIsLooping && mTime >= getDuration()) {
+		seek(0);
+	}
+
+	mIsPlaying = true;
+}
+
+void ImageSequenceView::stop() {
+	mIsPlaying = false;
+	seek(0);
+}
+
+void ImageSequenceView::seek(const int frameIndex) {
+	if (mFramePaths.empty()) {
+		return;
+	}
+
+	mCurrentFrame = std::max(0, std::min(frameIndex, getNumFrames() - 1));
+	mTime = mFramesPerSecond > 0 ? mCurrentFrame / (double)mFramesPerSecond : 0.0;
+	mIsStalled = false;
+}
+
+void ImageSequenceView::setLookAhead(const int value) {
+	// the buffer is resized on the next update
+	mLookAhead = std::max(0, value);
+}
+
+void ImageSequenceView::update(const FrameInfo & frameInfo) {
+	if (mFramePaths.empty()) {
+		return;
+	}
+
+	bool hasCompleted = false;
+
+	if (mIsPlaying && mFramesPerSecond > 0) {
+		mCurrentFrame = advance(frameInfo.deltaTime);
+
+		if (!mIsLooping && mTime >= getDuration()) {
+			mIsPlaying = false;
+			hasCompleted = true;
+		}
+	}
+
+	fillBuffer();
+
+	if (mCurrentFrame != mDisplayedFrame) {
+		FrameRef frame = findFrame(mCurrentFrame);
+
+		if (frame && frame->isReady) {
+			displayFrame(*frame);
+			mIsStalled = false;
+
+		} else if (mIsPlaying && !mIsStalled) {
+			mStats.numUnderruns++;
+			mIsStalled = true;
+		}
+	}
+
+	updateDecodeRate(frameInfo.absoluteTime);
+
+	if (hasCompleted) {
+		mSignalCompleted.emit();
+	}
+}
+
+int ImageSequenceView::advance(const double deltaTime) {
+	// wait for the current frame before moving on
+	if (!mDropFramesEnabled && mCurrentFrame != mDisplayedFrame) {
+		return mCurrentFrame;
+	}
+
+	const int numFrames = getNumFrames();
+	const double duration = getDuration();
+
+	double time = mTime + deltaTime * mSpeed;
+
+	if (time >= duration) {
+		time = mIsLooping ? fmod(time, duration) : duration;
+	}
+
+	int index = std::min((int)(time * mFramesPerSecond), numFrames - 1);
+	const int numSteps = getDistance(index);
+
+	if (!mDropFramesEnabled) {
+		// stop at the first frame that isn't decoded yet
+		for (int step = 1; step <= numSteps; ++step) {
+			const int nextIndex = (mCurrentFrame + step) % numFrames;
+			const FrameRef frame = findFrame(nextIndex);
+
+			if (!frame || !frame->isReady) {
+				index = nextIndex;
+				time = nextIndex / (double)mFramesPerSecond;
+				break;
+			}
+		}
+	}
+
+	// frames that the playhead moves past without displaying them
+	const int numPassedFrames = getDistance(index);
+
+	if (numPassedFrames > 0) {
+		mStats.numDroppedFrames += numPassedFrames - 1 + (mCurrentFrame != mDisplayedFrame ? 1 : 0);
+	}
+
+	mTime = time;
+	return index;
+}
+
+void ImageSequenceView::displayFrame(Frame & frame) {
+	const bool resizeToFrame = mShouldResizeToFrames && mDisplayedFrame < 0;
+
+	if (frame.surface) {
+		Timer timer(true);
+
+		if (mFrameTexture && mFrameTexture->getSize() == frame.surface->getSize()) {
+			mFrameTexture->update(*frame.surface);
+		} else {
+			mFrameTexture = gl::Texture2d::create(*frame.surface);
+		}
+
+		// count the copy towards this frame's upload budget so that other uploads back off while the sequence plays
+		const size_t numBytes = (size_t)frame.surface->getRowBytes() * frame.surface->getHeight();
+		core::UploadScheduler::get()->addUploadedBytes(numBytes, timer.getSeconds());
+
+		applyTexture(mFrameTexture, mFrameTexture->getBounds(), resizeToFrame);
+
+	} else if (frame.texture) {
+		applyTexture(frame.texture, frame.texture->getBounds(), resizeToFrame);
+	}
+
+	mDisplayedFrame = frame.index;
+	mStats.numDisplayedFrames++;
+}
+
+//==================================================
+// Buffering
+//
+
+void ImageSequenceView::fillBuffer() {
+	const int numFrames = getNumFrames();
+	const int numSlots = std::min(mLookAhead + 1, numFrames);
+
+	if ((int)mFrames.size() != numSlots) {
+		releaseFrames();
+		mFrames.resize(numSlots);
+
+		for (auto & frame : mFrames) {
+			frame = make_shared<Frame>();
+		}
+	}
+
+	// free slots of frames that the playhead has moved past
+	for (auto & frame : mFrames) {
+		if (frame->index >= 0) {
+			const int distance = getDistance(frame->index);
+
+			if (distance < 0 || distance >= numSlots) {
+				releaseFrame(*frame);
+			}
+		}
+	}
+
+	for (int i = 0; i < numSlots; ++i) {
+		int index = mCurrentFrame + i;
+
+		if (index >= numFrames) {
+			if (!mIsLooping) {
+				break;
+			}
+			index -= numFrames;
+		}
+
+		// frames closer to the playhead are decoded first
+		const float priority = getLoadPriority() + 1.0f - (float)i / (float)numSlots;
+
+		if (FrameRef frame = findFrame(index)) {
+			if (frame->request && !frame->isReady) {
+				frame->request->setPriority(priority);
+			}
+			continue;
+		}
+
+		for (auto & frame : mFrames) {
+			if (frame->index < 0) {
+				requestFrame(frame, index, priority);
+				break;
+			}
+		}
+	}
+
+	mStats.numBufferedFrames = count_if(mFrames.begin(), mFrames.end(), [](const FrameRef & frame) {
+		return frame->index >= 0 && frame->isReady;
+	});
+}
+
+void ImageSequenceView::requestFrame(FrameRef frame, const int index, const float priority) {
+	frame->index = index;
+	frame->isReady = false;
+
+	// requests are canceled before their frame is reused or this view is destroyed, so callbacks can access this view
+	weak_ptr<Frame> weakFrame = frame;
+
+	auto handleLoaded = [this, weakFrame, index](Surface8uRef surface, gl::Texture2dRef texture) {
+		auto frame = weakFrame.lock();
+
+		if (!frame || frame->index != index) {
+			return;
+		}
+
+		frame->surface = surface;
+		frame->texture = texture;
+		frame->isReady = true;
+
+		mStats.numDecodedFrames++;
+		mNumDecodedFramesInWindow++;
+	};
+
+	const fs::path & path = mFramePaths[index];
+
+	if (isCompressedTexture(path)) {
+		frame->request = core::ImageLoader::get()->load(path, [handleLoaded](gl::Texture2dRef texture) {
+			handleLoaded(nullptr, texture);
+		}, priority);
+
+	} else {
+		frame->request = core::ImageLoader::get()->loadSurface(path, [handleLoaded](Surface8uRef surface) {
+			handleLoaded(surface, nullptr);
+		}, priority);
+	}
+}
+
+void ImageSequenceView::releaseFrame(Frame & frame) {
+	if (frame.request) {
+		frame.request->cancel();
+	}
+
+	frame = Frame();
+}
+
+void ImageSequenceView::releaseFrames() {
+	for (auto & frame : mFrames) {
+		releaseFrame(*frame);
+	}
+}
+
+int ImageSequenceView::getDistance(const int index) const {
+	const int distance = index - mCurrentFrame;
+
+	if (mIsLooping && distance < 0) {
+		return distance + getNumFrames();
+	}
+
+	return distance;
+}
+
+ImageSequenceView::FrameRef ImageSequenceView::findFrame(const int index) const {
+	for (const auto & frame : mFrames) {
+		if (frame->index == index) {
+			return frame;
+		}
+	}
+
+	return nullptr;
+}
+
+//==================================================
+// Stats
+//
+
+void ImageSequenceView::resetStats() {
+	mStats = Stats();
+	mNumDecodedFramesInWindow = 0;
+	mDecodeWindowStartTime = -1;
+}
+
+void ImageSequenceView::updateDecodeRate(const double absoluteTime) {
+	if (mDecodeWindowStartTime < 0) {
+		mDecodeWindowStartTime = absoluteTime;
+		return;
+	}
+
+	const double elapsedTime = absoluteTime - mDecodeWindowStartTime;
+
+	if (elapsedTime >= 1.0) {
+		mStats.decodedFramesPerSecond = (float)(mNumDecodedFramesInWindow / elapsedTime);
+		mNumDecodedFramesInWindow = 0;
+		mDecodeWindowStartTime = absoluteTime;
+	}
+}
+
+}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Texture.h"
+#include "cinder/Signals.h"
+
+#include <vector>
+
+#include "ImageView.h"
+#include "../core/ImageLoader.h"
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class ImageSequenceView> ImageSequenceViewRef;
+
+//! Plays back a sequence of image files without loading all of them into memory. Frames are decoded by the ImageLoader
+//! workers into a small ring buffer that stays a configurable number of frames ahead of the playhead. The displayed
+//! frame is copied into a single texture that's reused for the entire sequence. GPU-compressed DDS and KTX frames are
+//! uploaded by the ImageLoader instead and displayed as is.
+//!
+//! The playhead advances by FrameInfo::deltaTime on each update, so playback follows the app's (fixed) timestep rather
+//! than wall time. Frames that aren't decoded by the time they're due are skipped by default to keep playback in sync.
+//! Disable frame dropping to pause on those frames instead.
+//!
+//! All scale modes of ImageView apply to the displayed frames.
+class ImageSequenceView : public ImageView {
+
+public:
+
+	struct Stats {
+		size_t	numDisplayedFrames		= 0;
+		size_t	numDroppedFrames		= 0;	//! Frames that were skipped because they weren't decoded in time or the app updates slower than the sequence plays
+		size_t	numUnderruns			= 0;	//! Number of times the playhead reached a frame that wasn't decoded yet
+		size_t	numDecodedFrames		= 0;
+		size_t	numBufferedFrames		= 0;	//! Decoded frames at and ahead of the playhead
+		float	decodedFramesPerSecond	= 0;	//! Decode throughput over the last second
+	};
+
+	ImageSequenceView();
+	virtual ~ImageSequenceView();
+
+	void reset() override;
+
+	//! Sets the frames of the sequence and rewinds to the first one. Relative paths are resolved as asset paths.
+	//! Resizes this view to the size of the first frame that's displayed if resizeToFrames is true.
+	void					setup(const std::vector<ci::fs::path> & framePaths, const float framesPerSecond = 30.0f, const bool resizeToFrames = true);
+
+	//! Plays all image files in directory in alphabetical order. Relative directories are resolved as asset paths.
+	//! Returns false if the directory doesn't contain any images. Directories can't be listed from asset packs.
+	bool					load(const ci::fs::path & directory, const float framesPerSecond = 30.0f, const bool resizeToFrames = true);
+
+	const std::vector<ci::fs::path> &	getFramePaths() const	{ return mFramePaths; }
+	int						getNumFrames() const			{ return (int)mFramePaths.size(); }
+
+	//! Restarts from the first frame if playback has completed.
+	void					play();
+	void					pause()							{ mIsPlaying = false; }
+	//! Pauses and rewinds to the first frame.
+	void					stop();
+	bool					isPlaying() const				{ return mIsPlaying; }
+
+	//! Moves the playhead to frameIndex. Frames around it are decoded and it's displayed once ready.
+	void					seek(const int frameIndex);
+	//! Index of the frame at the playhead, which might not be displayed yet if it's still decoding.
+	int						getCurrentFrame() const			{ return mCurrentFrame; }
+	//! Index of the frame that's shown or -1 if none has been decoded yet.
+	int						getDisplayedFrame() const		{ return mDisplayedFrame; }
+	double					getTime() const					{ return mTime; }
+	double					getDuration() const				{ return mFramesPerSecond > 0 ? (double)mFramePaths.size() / mFramesPerSecond : 0.0; }
+
+	void					setFramesPerSecond(const float value) { mFramesPerSecond = value; }
+	float					getFramesPerSecond() const		{ return mFramesPerSecond; }
+
+	//! Multiplier of FrameInfo::deltaTime. Negative values aren't supported. Defaults to 1.
+	void					setSpeed(const float value)		{ mSpeed = std::max(0.0f, value); }
+	float					getSpeed() const				{ return mSpeed; }
+
+	//! Defaults to true.
+	void					setLooping(const bool value)	{ mIsLooping = value; }
+	bool					getLooping() const				{ return mIsLooping; }
+
+	//! Number of frames after the playhead that are decoded in advance. Each buffered frame holds its decoded
+	//! pixels in memory, so keep this low for large frames. Defaults to 8.
+	void					setLookAhead(const int value);
+	int						getLookAhead() const			{ return mLookAhead; }
+
+	//! Skips frames that aren't decoded in time. If disabled, the playhead waits for them instead. Defaults to true.
+	void					setDropFramesEnabled(const bool value) { mDropFramesEnabled = value; }
+	bool					getDropFramesEnabled() const	{ return mDropFramesEnabled; }
+
+	//! Called once playback reaches the last frame when not looping.
+	ci::signals::Signal<void()> &	getSignalCompleted()	{ return mSignalCompleted; }
+
+	const Stats &			getStats() const				{ return mStats; }
+	void					resetStats();
+
+protected:
+
+	struct Frame {
+		int							index	= -1;		//! Frame index or -1 if unused
+		core::ImageLoader::RequestRef	request;
+		ci::Surface8uRef			surface;			//! Decoded pixels of regular images
+		ci::gl::Texture2dRef		texture;			//! Uploaded texture of DDS and KTX frames
+		bool						isReady	= false;	//! Finished loading, possibly with an error
+	};
+	typedef std::shared_ptr<Frame> FrameRef;
+
+	void					update(const FrameInfo & frameInfo) override;
+	void					willMoveFromView(BaseView * parent) override;
+
+	//! Moves the playhead by deltaTime and returns the frame it lands on. Stops at frames that aren't ready if dropping is disabled.
+	int						advance(const double deltaTime);
+
+	//! Requests all frames from mCurrentFrame up to the look-ahead and releases frames outside of that window.
+	void					fillBuffer();
+	void					requestFrame(FrameRef frame, const int index, const float priority);
+	void					releaseFrame(Frame & frame);
+	void					releaseFrames();
+
+	//! Number of frames from mCurrentFrame to index, taking looping into account. Negative for frames behind the playhead.
+	int						getDistance(const int index) const;
+	FrameRef				findFrame(const int index) const;
+	void					displayFrame(Frame & frame);
+	void					updateDecodeRate(const double absoluteTime);
+
+	std::vector<ci::fs::path>	mFramePaths;
+	std::vector<FrameRef>	mFrames;				//! Ring buffer with mLookAhead + 1 slots
+	ci::gl::Texture2dRef	mFrameTexture;			//! Reused for all decoded frames
+
+	float					mFramesPerSecond;
+	float					mSpeed;
+	int						mLookAhead;
+	bool					mIsPlaying;
+	bool					mIsLooping;
+	bool					mDropFramesEnabled;
+	bool					mShouldResizeToFrames;
+	bool					mIsStalled;
+
+	double					mTime;
+	int						mCurrentFrame;
+	int						mDisplayedFrame;
+
+	Stats					mStats;
+	size_t					mNumDecodedFramesInWindow;
+	double					mDecodeWindowStartTime;
+
+	ci::signals::Signal<void()>	mSignalCompleted;
+};
+
+}
+}
@@ -10,15 +10,45 @@ namespace views {
 
 ImageView::ScaleMode ImageView::sDefaultScaleMode = ImageView::ScaleMode::STRETCH;
 
+const std::array<uint16_t, 54> ImageView::sNineSliceIndices = [] {
+	std::array<uint16_t, 54> indices;
+	size_t i = 0;
+
+	for (uint16_t row = 0; row < 3; ++row) {
+		for (uint16_t column = 0; column < 3; ++column) {
+			const uint16_t upperLeft = row * 4 + column;
+			const uint16_t lowerLeft = upperLeft + 4;
+			indices[i++] = upperLeft;
+			indices[i++] = upperLeft + 1;
+			indices[i++] = lowerLeft + 1;
+			indices[i++] = upperLeft;
+			indices[i++] = lowerLeft + 1;
+			indices[i++] = lowerLeft;
+		}
+	}
+
+	return indices;
+}();
+
 ImageView::ImageView() : BaseView(),
 mTexture(nullptr),
+mTextureArea(0, 0, 0, 0),
 mScaleMode(sDefaultScaleMode),
 mTextureSourceArea(0, 0, 0, 0),
-mTextureDestRect(0, 0, 0, 0)
+mTextureDestRect(0, 0, 0, 0),
+mNineSliceInsets(0, 0, 0, 0),
+mNineSliceMesh(nullptr),
+mNineSliceMeshNeedsUpload(false),
+mIsBatchingSupported(false),
+mCachedTexture(nullptr),
+mShouldResizeToLoadedTexture(true),
+mLoadPriority(0),
+mPlaceholderColor(0, 0, 0, 0)
 {
 }
 
 ImageView::~ImageView() {
+	releaseCachedTexture();
 }
 
 void ImageView::reset() {
@@ -27,14 +57,23 @@ void ImageView::reset() {
 	setScaleMode(sDefaultScaleMode);
 	mTextureSourceArea = Area();
 	mTextureDestRect = Rectf();
+	mNineSliceInsets = Rectf();
+	mNineSliceMesh = nullptr;
 }
 
 inline void ImageView::setTexture(ci::gl::TextureRef texture, const bool resizeToTexture) {
+	releaseCachedTexture();
+	mLoadPath.clear();
+	applyTexture(texture, texture ? texture->getBounds() : Area(), resizeToTexture);
+}
+
+void ImageView::applyTexture(ci::gl::TextureRef texture, const ci::Area & area, const bool resizeToTexture) {
 	mTexture = texture;
+	mTextureArea = area;
 
 	if (resizeToTexture) {
 		if (mTexture) {
-			setSize(vec2(mTexture->getSize()));
+			setSize(vec2(mTextureArea.getSize()));
 		} else {
 			setSize(vec2());
 		}
@@ -43,7 +82,89 @@ inline void ImageView::setTexture(ci::gl::TextureRef texture, const bool resizeT
 	invalidate(false, true);
 }
 
+void ImageView::load(const ci::fs::path & path, const bool resizeToTexture, const ci::gl::Texture2d::Format & format) {
+	releaseCachedTexture();
+
+	mLoadPath = path;
+	mLoadFormat = format;
+	mShouldResizeToLoadedTexture = resizeToTexture;
+
+	acquireCachedTexture();
+}
+
+void ImageView::cancelLoading() {
+	if (isLoading()) {
+		releaseCachedTexture();
+	}
+	mLoadPath.clear();
+}
+
+void ImageView::acquireCachedTexture() {
+	mCachedTexture = core::TextureCache::get()->load(mLoadPath, mLoadFormat, mLoadPriority);
+	mTextureChangedConnection = mCachedTexture->getSignalTextureChanged().connect([this](gl::Texture2dRef texture) {
+		handleCachedTextureChanged(texture);
+	});
+
+	if (mCachedTexture->isResident()) {
+		handleCachedTextureChanged(mCachedTexture->getTexture());
+	}
+}
+
+void ImageView::releaseCachedTexture() {
+	// the cache cancels loads of textures that aren't used by anyone else during its next update
+	mTextureChangedConnection.disconnect();
+	mCachedTexture = nullptr;
+}
+
+void ImageView::handleCachedTextureChanged(ci::gl::Texture2dRef texture) {
+	if (texture) {
+		// only resize once so that reloads after eviction don't override sizes that have been set since
+		// also called with a new page texture and area when an atlased image has been moved
+		applyTexture(texture, mCachedTexture->getArea(), mShouldResizeToLoadedTexture);
+		mShouldResizeToLoadedTexture = false;
+
+	} else {
+		// evicted; release our reference so that the memory is freed. The texture is reloaded when this view is drawn again.
+		mTexture = nullptr;
+		invalidate(false, true);
+	}
+}
+
+void ImageView::didMoveToView(BaseView * parent) {
+	BaseView::didMoveToView(parent);
+
+	// restart loads that were canceled when this view was removed
+	if (!mLoadPath.empty() && !mCachedTexture) {
+		acquireCachedTexture();
+	}
+}
+
+void ImageView::willMoveFromView(BaseView * parent) {
+	BaseView::willMoveFromView(parent);
+
+	if (isLoading()) {
+		releaseCachedTexture();
+	}
+}
+
+bool ImageView::isInViewport() {
+	const Rectf & viewport = sAnimationThrottling.cullingBounds;
+
+	if (viewport.getWidth() <= 0 || viewport.getHeight() <= 0) {
+		return true;
+	}
+
+	const mat4 & transform = getGlobalTransform();
+	Rectf globalBounds(vec2(transform * vec4(0, 0, 0, 1)), vec2(transform * vec4(getWidth(), getHeight(), 0, 1)));
+	globalBounds.include(vec2(transform * vec4(getWidth(), 0, 0, 1)));
+	globalBounds.include(vec2(transform * vec4(0, getHeight(), 0, 1)));
+
+	return viewport.intersects(globalBounds);
+}
+
 void ImageView::validateContent() {
+	// called before every draw; only rebuild cached geometry after changes
+	const bool hadInvalidContent = hasInvalidContent();
 	BaseView::validateContent();
 
 	if (!mTexture) {
@@ -52,34 +173,141 @@ void ImageView::validateContent() {
 		return;
 	}
 
+	// source areas are relative to the image, which is only part of the texture if it's atlased
+	const Area imageBounds(ivec2(0), mTextureArea.getSize());
+
 	switch (mScaleMode) {
 		case ScaleMode::NONE:
-			mTextureDestRect = Rectf(vec2(), getSize());
+			// clipped to the image so that atlased images don't show their neighbors
+			mTextureDestRect = Rectf(vec2(), glm::min(getSize(), vec2(imageBounds.getSize())));
 			mTextureSourceArea = Area(mTextureDestRect);
 			break;
 		case ScaleMode::STRETCH:
 			mTextureDestRect = Rectf(vec2(), getSize());
-			mTextureSourceArea = Area(mTexture->getBounds());
+			mTextureSourceArea = imageBounds;
 			break;
 		case ScaleMode::FIT:
-			mTextureDestRect = Rectf(mTexture->getBounds()).getCenteredFit(Rectf(vec2(), getSize()), true);
-			mTextureSourceArea = Area(mTexture->getBounds());
+			mTextureDestRect = Rectf(imageBounds).getCenteredFit(Rectf(vec2(), getSize()), true);
+			mTextureSourceArea = imageBounds;
 			break;
 		case ScaleMode::COVER:
 			mTextureDestRect = Rectf(vec2(), getSize());
-			mTextureSourceArea = Area(mTextureDestRect.getCenteredFit(mTexture->getBounds(), true));
+			mTextureSourceArea = Area(mTextureDestRect.getCenteredFit(imageBounds, true));
 			break;
 		case ScaleMode::CUSTOM:
 			// do nothing
 			break;
+		case ScaleMode::NINE_SLICE:
+			mTextureDestRect = Rectf(vec2(), getSize());
+			mTextureSourceArea = imageBounds;
+			if (hadInvalidContent) {
+				updateNineSliceMesh();
+			}
+			break;
 	}
 }
 
+void ImageView::updateNineSliceMesh() {
+	const vec2 imageSize(mTextureArea.getSize());
+	const vec2 size = getSize();
+
+	// scale insets down if they don't fit, e.g. for pill shapes that are smaller than their image
+	const vec2 insetsSize(mNineSliceInsets.x1 + mNineSliceInsets.x2, mNineSliceInsets.y1 + mNineSliceInsets.y2);
+	const vec2 scale(
+		insetsSize.x > size.x && insetsSize.x > 0 ? size.x / insetsSize.x : 1.0f,
+		insetsSize.y > size.y && insetsSize.y > 0 ? size.y / insetsSize.y : 1.0f
+	);
+
+	const float xs[4] = { 0, mNineSliceInsets.x1 * scale.x, size.x - mNineSliceInsets.x2 * scale.x, size.x };
+	const float ys[4] = { 0, mNineSliceInsets.y1 * scale.y, size.y - mNineSliceInsets.y2 * scale.y, size.y };
+
+	// interpolate within the image's tex coords so that flipped and atlased textures are mapped correctly
+	const Rectf texCoords = mTexture->getAreaTexCoords(mTextureArea);
+	const float us[4] = { 0, mNineSliceInsets.x1, imageSize.x - mNineSliceInsets.x2, imageSize.x };
+	const float vs[4] = { 0, mNineSliceInsets.y1, imageSize.y - mNineSliceInsets.y2, imageSize.y };
+
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			const vec2 uv = imageSize.x > 0 && imageSize.y > 0 ? vec2(us[column], vs[row]) / imageSize : vec2(0);
+			mNineSlicePositions[row * 4 + column] = vec2(xs[column], ys[row]);
+			mNineSliceTexCoords[row * 4 + column] = vec2(
+				glm::mix(texCoords.x1, texCoords.x2, uv.x),
+				glm::mix(texCoords.y1, texCoords.y2, uv.y)
+			);
+		}
+	}
+
+	mNineSliceMeshNeedsUpload = true;
+}
+
+void ImageView::drawNineSliceMesh() {
+	if (!mNineSliceMesh) {
+		auto layout = gl::VboMesh::Layout().usage(GL_DYNAMIC_DRAW).interleave(false)
+			.attrib(geom::POSITION, 2)
+			.attrib(geom::TEX_COORD_0, 2);
+
+		mNineSliceMesh = gl::VboMesh::create((uint32_t)mNineSlicePositions.size(), GL_TRIANGLES, vector<gl::VboMesh::Layout>({layout}),
+			(uint32_t)sNineSliceIndices.size(), GL_UNSIGNED_SHORT);
+		mNineSliceMesh->bufferIndices(sNineSliceIndices.size() * sizeof(uint16_t), sNineSliceIndices.data());
+		mNineSliceMeshNeedsUpload = true;
+	}
+
+	if (mNineSliceMeshNeedsUpload) {
+		mNineSliceMesh->bufferAttrib(geom::POSITION, mNineSlicePositions.size() * sizeof(vec2), mNineSlicePositions.data());
+		mNineSliceMesh->bufferAttrib(geom::TEX_COORD_0, mNineSliceTexCoords.size() * sizeof(vec2), mNineSliceTexCoords.data());
+		mNineSliceMeshNeedsUpload = false;
+	}
+
+	gl::ScopedGlslProg scopedShader(gl::getStockShader(gl::ShaderDef().texture(mTexture).color()));
+	gl::ScopedTextureBind scopedTexture(mTexture);
+	gl::draw(mNineSliceMesh);
+}
+
+void ImageView::markCachedTextureDrawn() {
+	if (!mCachedTexture) {
+		return;
+	}
+
+	if (!mCachedTexture->isResident() && isInViewport()) {
+		mCachedTexture->setPriority(std::max(mCachedTexture->getPriority(), mLoadPriority + 1.0f));
+	}
+
+	// keeps the texture resident or reloads it after it's been evicted
+	mCachedTexture->markDrawn();
+}
+
 void ImageView::draw() {
 	BaseView::draw();
+	markCachedTextureDrawn();
+
+	if (mTexture && mScaleMode == ScaleMode::NINE_SLICE) {
+		drawNineSliceMesh();
+
+	} else if (mTexture) {
+		gl::draw(mTexture, mTextureSourceArea.getOffset(mTextureArea.getUL()), mTextureDestRect);
+
+	} else if (isLoading() && mPlaceholderColor.a > 0) {
+		gl::ScopedColor scopedColor(mPlaceholderColor * getDrawColor());
+		gl::drawSolidRect(Rectf(vec2(), getSize()));
+	}
+}
+
+bool ImageView::canDrawBatched() {
+	// only atlased images share textures with other views; the background is drawn by BaseView::draw()
+	return isBatchingSupported() && mTexture && mCachedTexture && mCachedTexture->isAtlased()
+		&& getBackgroundColor().value().a <= 0;
+}
+
+void ImageView::drawBatched(SpriteBatch & batch, const ci::mat4 & transform) {
+	markCachedTextureDrawn();
+
+	// marking the texture as drawn can't evict it, but check in case it's been released since canDrawBatched()
+	if (mTexture && mScaleMode == ScaleMode::NINE_SLICE) {
+		batch.drawMesh(mTexture, mNineSlicePositions.data(), mNineSliceTexCoords.data(), mNineSlicePositions.size(),
+					   sNineSliceIndices.data(), sNineSliceIndices.size(), transform, getDrawColor());
 
-	if (mTexture) {
-		gl::draw(mTexture, mTextureSourceArea, mTextureDestRect);
+	} else if (mTexture) {
+		batch.drawTexture(mTexture, mTextureSourceArea.getOffset(mTextureArea.getUL()), mTextureDestRect, transform, getDrawColor());
 	}
 }
 
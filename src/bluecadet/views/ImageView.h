@@ -9,8 +9,13 @@
 #include "cinder/app/App.h"
 #include "cinder/app/RendererGl.h"
 #include "cinder/gl/gl.h"
+#include "cinder/gl/VboMesh.h"
+
+#include <array>
+#include <typeinfo>
 
 #include "BaseView.h"
+#include "../core/TextureCache.h"
 
 namespace bluecadet {
 namespace views {
@@ -26,7 +31,8 @@ public:
 		STRETCH,	//! Stretched within bounds (default)
 		FIT,		//! Scaled to fit within bounds and preserve aspect ratio. Will not crop content.
 		COVER,		//! Scaled to fill bounds and preserve aspect ratio. Might crop content.
-		CUSTOM		//! Uses the current source area and dest rect.
+		CUSTOM,		//! Uses the current source area and dest rect.
+		NINE_SLICE	//! Stretched within bounds, but keeps corners at their original size. Edges are only stretched along their length. See setNineSliceInsets().
 	};
 
 	ImageView();
@@ -37,13 +43,37 @@ public:
 	inline void			setTexture(const ci::gl::TextureRef value, const bool resizeToTexture = true);
 	inline const ci::gl::TextureRef getTexture() const { return mTexture; }
 
+	//! Loads the image at path asynchronously via the shared TextureCache and swaps in the texture once it's uploaded.
+	//! The current texture is kept until then. Views that load the same path and format share one texture. Loading is
+	//! canceled when this view is removed from its parent and restarted when it's added to a parent again. Requests of
+	//! views that are drawn within the viewport are prioritized. If the cache evicts the texture, it's reloaded when
+	//! this view is drawn again.
+	void				load(const ci::fs::path & path, const bool resizeToTexture = true, const ci::gl::Texture2d::Format & format = ci::gl::Texture2d::Format());
+	void				cancelLoading();
+	bool				isLoading() const { return mCachedTexture && mCachedTexture->isLoading(); }
+	const ci::fs::path &	getLoadPath() const { return mLoadPath; }
+
+	//! Area of the image within getTexture(). Covers the entire texture unless the loaded image has been packed into a TextureAtlas page.
+	const ci::Area &	getTextureArea() const { return mTextureArea; }
+
+	//! The shared cache handle of the loaded image or nullptr if the texture has been set directly.
+	const core::CachedTextureRef &	getCachedTexture() const { return mCachedTexture; }
+
+	//! Drawn within the view's bounds (multiplied with the draw color) while an image is loading and no texture is set. Defaults to transparent.
+	void				setPlaceholderColor(const ci::ColorA & color) { mPlaceholderColor = color; }
+	const ci::ColorA &	getPlaceholderColor() const { return mPlaceholderColor; }
+
+	//! Base priority of load requests. Views that are drawn within the viewport get a boost of 1.
+	void				setLoadPriority(const float priority) { mLoadPriority = priority; }
+	float				getLoadPriority() const { return mLoadPriority; }
+
 	static void			setDefaultScaleMode(const ScaleMode scaleMode) { sDefaultScaleMode = scaleMode; }
 	static ScaleMode	getDefaultScaleMode() { return sDefaultScaleMode; }	//! Defaults to STRETCH
 	
 	inline void			setScaleMode(const ScaleMode scaleMode) { mScaleMode = scaleMode; invalidate(false, true); }
 	inline ScaleMode	getScaleMode() const { return mScaleMode; }	//! Defaults to getDefaultScaleMode()
 
-	//! Configure a custom source area for the texture in texture pixel coordinate space. Will set the scale mode to CUSTOM.
+	//! Configure a custom source area for the texture in image pixel coordinate space (relative to getTextureArea()). Will set the scale mode to CUSTOM.
 	inline void					setTextureSourceArea(const ci::Area & area) { mTextureSourceArea = area; mScaleMode = ScaleMode::CUSTOM; invalidate(false, true); };
 	inline const ci::Area &		getTextureSourceArea() const { return mTextureSourceArea; };
 
@@ -51,18 +81,64 @@ public:
 	inline void					setTextureDestRect(const ci::Rectf & rect) { mTextureDestRect = rect; mScaleMode = ScaleMode::CUSTOM; invalidate(false, true); };
 	inline const ci::Rectf &	getTextureDestRect() const { return mTextureDestRect; };
 
-private:
+	//! Configure the borders of the image in image pixels that aren't stretched: x1 is the left, y1 the top, x2 the right and y2 the bottom inset.
+	//! Will set the scale mode to NINE_SLICE. Corners are scaled down proportionally if the view is smaller than its insets.
+	inline void					setNineSliceInsets(const ci::Rectf & insets) { mNineSliceInsets = insets; mScaleMode = ScaleMode::NINE_SLICE; invalidate(false, true); };
+	inline void					setNineSliceInsets(const float inset) { setNineSliceInsets(ci::Rectf(inset, inset, inset, inset)); };
+	inline const ci::Rectf &	getNineSliceInsets() const { return mNineSliceInsets; };
+
+protected:
 
 	void draw() override;
+	bool canDrawBatched() override;
+	void drawBatched(SpriteBatch & batch, const ci::mat4 & transform) override;
 	void validateContent() override;
+	void didMoveToView(BaseView * parent) override;
+	void willMoveFromView(BaseView * parent) override;
+
+	void applyTexture(ci::gl::TextureRef texture, const ci::Area & area, const bool resizeToTexture);
+	void markCachedTextureDrawn();
+	void acquireCachedTexture();
+	void releaseCachedTexture();
+	void handleCachedTextureChanged(ci::gl::Texture2dRef texture);
+	bool isInViewport();
+
+	//! Updates the vertices of the nine-slice mesh. Only called when invalid content is validated, i.e. after size, texture or insets changed.
+	void updateNineSliceMesh();
+	void drawNineSliceMesh();
+
+	//! Subclasses are never drawn batched unless they enable this, since drawBatched() would skip their own draw().
+	//! Only enable it if the subclass draws exactly what ImageView::draw() draws. ImageView itself is always batchable.
+	void setBatchingSupported(const bool value) { mIsBatchingSupported = value; }
+	bool isBatchingSupported() const { return mIsBatchingSupported || typeid(*this) == typeid(ImageView); }
+
+private:
 	
 	static ScaleMode	sDefaultScaleMode;
 
 	ci::gl::TextureRef	mTexture;
+	ci::Area			mTextureArea;
 
 	ScaleMode			mScaleMode;
 	ci::Area			mTextureSourceArea;
 	ci::Rectf			mTextureDestRect;
+
+	//! 4x4 grid of vertices in rows from top to bottom, drawn as 9 quads that share their corners
+	static const std::array<uint16_t, 54>	sNineSliceIndices;
+	ci::Rectf							mNineSliceInsets;
+	std::array<ci::vec2, 16>			mNineSlicePositions;
+	std::array<ci::vec2, 16>			mNineSliceTexCoords;
+	ci::gl::VboMeshRef					mNineSliceMesh;			//! Created on first draw
+	bool								mNineSliceMeshNeedsUpload;
+	bool								mIsBatchingSupported;
+
+	core::CachedTextureRef			mCachedTexture;
+	ci::signals::ScopedConnection	mTextureChangedConnection;
+	ci::fs::path					mLoadPath;
+	ci::gl::Texture2d::Format		mLoadFormat;
+	bool							mShouldResizeToLoadedTexture;
+	float							mLoadPriority;
+	ci::ColorA						mPlaceholderColor;
 };
 
 }
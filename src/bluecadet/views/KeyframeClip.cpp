@@ -0,0 +1,353 @@
+#include "KeyframeClip.h"
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Format helpers
+//
+
+namespace keyframes {
+
+uint32_t getNumComponents(const Property property) {
+	switch (property) {
+		case Property::Position: return 2;
+		case Property::Scale: return 2;
+		case Property::Rotation: return 1;
+		case Property::Alpha: return 1;
+		case Property::Tint: return 3;
+		case Property::BackgroundColor: return 4;
+		case Property::TransformOrigin: return 2;
+		case Property::Size: return 2;
+		default: return 0;
+	}
+}
+
+Property getPropertyByName(const std::string & name) {
+	if (name == "position") return Property::Position;
+	if (name == "scale") return Property::Scale;
+	if (name == "rotation") return Property::Rotation;
+	if (name == "alpha") return Property::Alpha;
+	if (name == "tint") return Property::Tint;
+	if (name == "backgroundColor") return Property::BackgroundColor;
+	if (name == "transformOrigin") return Property::TransformOrigin;
+	if (name == "size") return Property::Size;
+	return Property::NumProperties;
+}
+
+}
+
+namespace {
+	//! Intermediate track used while encoding JSON
+	struct TrackData {
+		string				target;
+		keyframes::Property	property;
+		uint32_t			numComponents;
+		vector<float>		times;
+		vector<float>		values;
+		vector<uint8_t>		easings;
+	};
+
+	inline uint32_t alignOffset(const size_t offset) { return (uint32_t)((offset + 3) & ~(size_t)3); }
+
+	template <typename T>
+	inline void writeAt(vector<uint8_t> & data, const uint32_t offset, const T * values, const size_t count) {
+		if (count > 0) {
+			memcpy(data.data() + offset, values, count * sizeof(T));
+		}
+	}
+}
+
+//==================================================
+// Loading
+//
+
+KeyframeClipRef KeyframeClip::load(const ci::fs::path & path) {
+	auto file = core::MappedFile::open(path);
+
+	if (!file) {
+		return nullptr;
+	}
+
+	KeyframeClipRef clip(new KeyframeClip());
+	clip->mFile = file;
+
+	if (!clip->parse(file->getData(), file->getSize(), path.string())) {
+		return nullptr;
+	}
+
+	return clip;
+}
+
+KeyframeClipRef KeyframeClip::createFromJson(const ci::JsonTree & json) {
+	KeyframeClipRef clip(new KeyframeClip());
+
+	if (!encodeJson(json, clip->mBuffer) || !clip->parse(clip->mBuffer.data(), clip->mBuffer.size(), "JSON")) {
+		return nullptr;
+	}
+
+	return clip;
+}
+
+bool KeyframeClip::convertJsonFile(const ci::fs::path & jsonPath, const ci::fs::path & outputPath) {
+	vector<uint8_t> data;
+
+	try {
+		const JsonTree json(loadFile(jsonPath));
+
+		if (!encodeJson(json, data)) {
+			CI_LOG_E("Could not convert '" << jsonPath << "'");
+			return false;
+		}
+
+	} catch (cinder::Exception & e) {
+		CI_LOG_EXCEPTION("Could not read '" << jsonPath << "'", e);
+		return false;
+	}
+
+	ofstream stream(outputPath.string(), ios::out | ios::binary | ios::trunc);
+
+	if (!stream.is_open()) {
+		CI_LOG_E("Could not open '" << outputPath << "' for writing");
+		return false;
+	}
+
+	stream.write(reinterpret_cast<const char *>(data.data()), data.size());
+	return (bool)stream;
+}
+
+KeyframeClip::KeyframeClip() :
+	mDuration(0)
+{
+}
+
+KeyframeClip::~KeyframeClip() {
+}
+
+//==================================================
+// Encoding
+//
+
+bool KeyframeClip::encodeJson(const ci::JsonTree & json, std::vector<uint8_t> & data) {
+	vector<TrackData> tracks;
+	float duration = 0;
+
+	try {
+		if (!json.hasChild("tracks")) {
+			CI_LOG_E("Keyframe JSON has no tracks");
+			return false;
+		}
+
+		for (const auto & trackJson : json.getChild("tracks").getChildren()) {
+			TrackData track;
+			track.target = trackJson.getValueForKey<string>("target");
+			track.property = keyframes::getPropertyByName(trackJson.getValueForKey<string>("property"));
+
+			if (track.property == keyframes::Property::NumProperties) {
+				CI_LOG_E("Unknown keyframe property '" << trackJson.getValueForKey<string>("property") << "' for target '" << track.target << "'");
+				return false;
+			}
+
+			track.numComponents = keyframes::getNumComponents(track.property);
+
+			// collect keyframes and sort them by time
+			struct Keyframe {
+				float	time;
+				float	value[keyframes::kMaxComponents];
+				uint8_t	easing;
+			};
+
+			vector<Keyframe> keyframeList;
+
+			for (const auto & keyframeJson : trackJson.getChild("keyframes").getChildren()) {
+				Keyframe keyframe;
+				keyframe.time = keyframeJson.getValueForKey<float>("time");
+				keyframe.easing = (uint8_t)EaseId::None;
+
+				const JsonTree & valueJson = keyframeJson.getChild("value");
+
+				if (valueJson.getNodeType() == JsonTree::NODE_ARRAY) {
+					if (valueJson.getNumChildren() != track.numComponents) {
+						CI_LOG_E("Keyframe at " << keyframe.time << "s of '" << track.target << "' needs " << track.numComponents << " values");
+						return false;
+					}
+					for (uint32_t i = 0; i < track.numComponents; ++i) {
+						keyframe.value[i] = valueJson.getValueAtIndex<float>(i);
+					}
+				} else {
+					const float value = valueJson.getValue<float>();
+					fill(keyframe.value, keyframe.value + track.numComponents, value);
+				}
+
+				if (keyframeJson.hasChild("easing")) {
+					const string easingName = keyframeJson.getValueForKey<string>("easing");
+
+					if (easingName == "Hold") {
+						keyframe.easing = keyframes::kEasingHold;
+					} else {
+						const EaseId easeId = getEaseIdByName(easingName);
+						if (easeId == EaseId::Custom) {
+							CI_LOG_E("Unknown easing '" << easingName << "' at " << keyframe.time << "s of '" << track.target << "'");
+							return false;
+						}
+						keyframe.easing = (uint8_t)easeId;
+					}
+				}
+
+				keyframeList.push_back(keyframe);
+			}
+
+			stable_sort(keyframeList.begin(), keyframeList.end(), [](const Keyframe & a, const Keyframe & b) { return a.time < b.time; });
+
+			for (const auto & keyframe : keyframeList) {
+				track.times.push_back(keyframe.time);
+				track.values.insert(track.values.end(), keyframe.value, keyframe.value + track.numComponents);
+				track.easings.push_back(keyframe.easing);
+				duration = max(duration, keyframe.time);
+			}
+
+			tracks.push_back(track);
+		}
+
+		if (json.hasChild("duration")) {
+			duration = max(duration, json.getValueForKey<float>("duration"));
+		}
+
+	} catch (cinder::Exception & e) {
+		CI_LOG_EXCEPTION("Could not parse keyframe JSON", e);
+		return false;
+	}
+
+	// lay out all sections at aligned offsets
+	keyframes::FileHeader fileHeader;
+	fileHeader.numTracks = (uint32_t)tracks.size();
+	fileHeader.duration = duration;
+
+	vector<keyframes::TrackHeader> trackHeaders(tracks.size());
+	size_t offset = sizeof(keyframes::FileHeader) + tracks.size() * sizeof(keyframes::TrackHeader);
+
+	for (size_t i = 0; i < tracks.size(); ++i) {
+		const TrackData & track = tracks[i];
+		keyframes::TrackHeader & header = trackHeaders[i];
+
+		header.property = (uint8_t)track.property;
+		header.numComponents = (uint8_t)track.numComponents;
+		header.numKeyframes = (uint32_t)track.times.size();
+
+		header.targetOffset = alignOffset(offset);
+		offset = header.targetOffset + track.target.size() + 1;
+		header.timesOffset = alignOffset(offset);
+		offset = header.timesOffset + track.times.size() * sizeof(float);
+		header.valuesOffset = alignOffset(offset);
+		offset = header.valuesOffset + track.values.size() * sizeof(float);
+		header.easingsOffset = alignOffset(offset);
+		offset = header.easingsOffset + track.easings.size();
+	}
+
+	data.assign(alignOffset(offset), 0);
+
+	writeAt(data, 0, &fileHeader, 1);
+	writeAt(data, sizeof(keyframes::FileHeader), trackHeaders.data(), trackHeaders.size());
+
+	for (size_t i = 0; i < tracks.size(); ++i) {
+		const TrackData & track = tracks[i];
+		const keyframes::TrackHeader & header = trackHeaders[i];
+
+		writeAt(data, header.targetOffset, track.target.c_str(), track.target.size() + 1);
+		writeAt(data, header.timesOffset, track.times.data(), track.times.size());
+		writeAt(data, header.valuesOffset, track.values.data(), track.values.size());
+		writeAt(data, header.easingsOffset, track.easings.data(), track.easings.size());
+	}
+
+	return true;
+}
+
+//==================================================
+// Parsing
+//
+
+bool KeyframeClip::parse(const uint8_t * data, const size_t size, const std::string & sourceName) {
+	mTracks.clear();
+
+	keyframes::FileHeader fileHeader;
+
+	if (size < sizeof(fileHeader)) {
+		CI_LOG_E("'" << sourceName << "' is not a keyframe file");
+		return false;
+	}
+
+	memcpy(&fileHeader, data, sizeof(fileHeader));
+
+	if (fileHeader.magic != keyframes::FileHeader::kMagic) {
+		CI_LOG_E("'" << sourceName << "' is not a keyframe file");
+		return false;
+	}
+
+	if (fileHeader.version != keyframes::FileHeader::kVersion) {
+		CI_LOG_E("Keyframe file '" << sourceName << "' has an unsupported version (" << fileHeader.version << ")");
+		return false;
+	}
+
+	if (sizeof(fileHeader) + (size_t)fileHeader.numTracks * sizeof(keyframes::TrackHeader) > size) {
+		CI_LOG_E("Keyframe file '" << sourceName << "' is truncated");
+		return false;
+	}
+
+	mDuration = fileHeader.duration;
+	mTracks.reserve(fileHeader.numTracks);
+
+	for (uint32_t i = 0; i < fileHeader.numTracks; ++i) {
+		keyframes::TrackHeader header;
+		memcpy(&header, data + sizeof(fileHeader) + i * sizeof(header), sizeof(header));
+
+		const auto property = (keyframes::Property)header.property;
+		const size_t numKeyframes = header.numKeyframes;
+		const size_t numValues = numKeyframes * header.numComponents;
+
+		const bool isValid = property < keyframes::Property::NumProperties
+			&& header.numComponents == keyframes::getNumComponents(property)
+			&& header.timesOffset % 4 == 0 && header.valuesOffset % 4 == 0
+			&& header.targetOffset < size && memchr(data + header.targetOffset, 0, size - header.targetOffset) != nullptr
+			&& (size_t)header.timesOffset + numKeyframes * sizeof(float) <= size
+			&& (size_t)header.valuesOffset + numValues * sizeof(float) <= size
+			&& (size_t)header.easingsOffset + numKeyframes <= size;
+
+		if (!isValid) {
+			CI_LOG_E("Track " << i << " of keyframe file '" << sourceName << "' is invalid");
+			mTracks.clear();
+			return false;
+		}
+
+		Track track;
+		track.target = reinterpret_cast<const char *>(data + header.targetOffset);
+		track.property = property;
+		track.numComponents = header.numComponents;
+		track.numKeyframes = header.numKeyframes;
+		track.times = reinterpret_cast<const float *>(data + header.timesOffset);
+		track.values = reinterpret_cast<const float *>(data + header.valuesOffset);
+		track.easings = data + header.easingsOffset;
+
+		// players rely on ascending times to move their cursors forward
+		if (!is_sorted(track.times, track.times + numKeyframes)) {
+			CI_LOG_E("Track " << i << " of keyframe file '" << sourceName << "' has unsorted keyframes");
+			mTracks.clear();
+			return false;
+		}
+
+		mTracks.push_back(track);
+	}
+
+	return true;
+}
+
+}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/Json.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../core/MappedFile.h"
+#include "AnimationEasing.h"
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Binary keyframe format
+//
+// File layout:
+//   FileHeader
+//   TrackHeader * FileHeader::numTracks
+//   Per track: target name (null-terminated), times, values, easings
+//
+// All sections start at 4-byte aligned offsets, so times and values can be read in place from a memory-mapped file.
+// Times are in seconds and ascending. Each keyframe stores TrackHeader::numComponents values and the easing used to
+// interpolate to the next keyframe (an EaseId or kEasingHold). All values are little-endian.
+//
+
+namespace keyframes {
+
+//! BaseView properties that can be animated by keyframe tracks. Rotation is stored as radians around the z axis.
+enum class Property : uint8_t {
+	Position,			//! 2 components
+	Scale,				//! 2 components
+	Rotation,			//! 1 component
+	Alpha,				//! 1 component
+	Tint,				//! 3 components
+	BackgroundColor,	//! 4 components
+	TransformOrigin,	//! 2 components
+	Size,				//! 2 components
+	NumProperties
+};
+
+//! Easing value that holds a keyframe's value until the next keyframe.
+static const uint8_t kEasingHold = 0xFF;
+
+//! Max number of components per keyframe value.
+static const uint32_t kMaxComponents = 4;
+
+#pragma pack(push, 1)
+
+struct FileHeader {
+	static const uint32_t kMagic = 0x464B4342; // "BCKF"
+	static const uint32_t kVersion = 1;
+
+	uint32_t	magic		= kMagic;
+	uint32_t	version		= kVersion;
+	uint32_t	numTracks	= 0;
+	float		duration	= 0;
+};
+
+struct TrackHeader {
+	uint32_t	targetOffset	= 0;	//! File offset of the null-terminated target name
+	uint32_t	timesOffset		= 0;	//! File offset of float[numKeyframes]
+	uint32_t	valuesOffset	= 0;	//! File offset of float[numKeyframes * numComponents]
+	uint32_t	easingsOffset	= 0;	//! File offset of uint8_t[numKeyframes]
+	uint32_t	numKeyframes	= 0;
+	uint8_t		property		= 0;	//! Property
+	uint8_t		numComponents	= 0;
+	uint16_t	reserved		= 0;
+};
+
+#pragma pack(pop)
+
+uint32_t	getNumComponents(const Property property);
+
+//! Returns the property for a name like "position" or "backgroundColor". Returns Property::NumProperties for unknown names.
+Property	getPropertyByName(const std::string & name);
+
+}
+
+typedef std::shared_ptr<class KeyframeClip> KeyframeClipRef;
+
+//! Read-only set of keyframe tracks in the binary keyframe format. Track data is read in place, either from a
+//! memory-mapped file or from a buffer that was converted from JSON. See KeyframePlayer to apply clips to views.
+//!
+//! JSON authoring format:
+//!
+//!		{
+//!			"duration": 4.0,
+//!			"tracks": [{
+//!				"target": "title",
+//!				"property": "position",
+//!				"keyframes": [
+//!					{ "time": 0.0, "value": [0, 100], "easing": "OutQuad" },
+//!					{ "time": 1.5, "value": [0, 0], "easing": "Hold" },
+//!					{ "time": 3.0, "value": [0, 100] }
+//!				]
+//!			}]
+//!		}
+//!
+//! "duration" is optional and defaults to the time of the last keyframe. "easing" is the name of an EaseId (e.g. "InOutSine"),
+//! "None" for linear interpolation (the default) or "Hold". Single values are applied to all components (e.g. "value": 2 for scale).
+class KeyframeClip {
+
+public:
+
+	//! A track that points directly into the clip's data. Only valid for the lifetime of the clip.
+	struct Track {
+		const char *			target			= nullptr;
+		keyframes::Property		property		= keyframes::Property::Position;
+		uint32_t				numComponents	= 0;
+		uint32_t				numKeyframes	= 0;
+		const float *			times			= nullptr;
+		const float *			values			= nullptr;
+		const uint8_t *			easings			= nullptr;
+	};
+
+	//! Memory-maps a binary keyframe file. Returns nullptr if the file can't be mapped or isn't valid.
+	static KeyframeClipRef		load(const ci::fs::path & path);
+
+	//! Converts JSON in the authoring format to an in-memory clip. Returns nullptr if the JSON isn't valid.
+	static KeyframeClipRef		createFromJson(const ci::JsonTree & json);
+
+	//! Converts a JSON file in the authoring format to a binary keyframe file. Returns false if either file can't be read or written.
+	static bool					convertJsonFile(const ci::fs::path & jsonPath, const ci::fs::path & outputPath);
+
+	//! Encodes JSON in the authoring format in the binary keyframe format. Returns false if the JSON isn't valid.
+	static bool					encodeJson(const ci::JsonTree & json, std::vector<uint8_t> & data);
+
+	~KeyframeClip();
+
+	float						getDuration() const	{ return mDuration; }
+	const std::vector<Track> &	getTracks() const	{ return mTracks; }
+
+	//! Size of the binary data in bytes.
+	size_t						getDataSize() const	{ return mFile ? mFile->getSize() : mBuffer.size(); }
+
+protected:
+
+	KeyframeClip();
+
+	//! Validates data and creates tracks that point into it. Data must outlive this clip.
+	bool						parse(const uint8_t * data, const size_t size, const std::string & sourceName);
+
+	core::MappedFileRef			mFile;		//! Set when loaded from a file
+	std::vector<uint8_t>		mBuffer;	//! Set when converted from JSON
+
+	std::vector<Track>			mTracks;
+	float						mDuration;
+};
+
+}
+}
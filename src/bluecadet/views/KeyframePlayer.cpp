@@ -0,0 +1,175 @@
+#include "KeyframePlayer.h"
+
+#include <algorithm>
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+KeyframePlayer::KeyframePlayer(KeyframeClipRef clip) :
+	mClip(clip),
+	mTime(0),
+	mSpeed(1.0f),
+	mIsPlaying(false),
+	mIsLooping(false)
+{
+}
+
+KeyframePlayer::~KeyframePlayer() {
+}
+
+void KeyframePlayer::setClip(KeyframeClipRef clip) {
+	mBindings.clear();
+	mClip = clip;
+	mTime = 0;
+}
+
+//==================================================
+// Bindings
+//
+
+size_t KeyframePlayer::bind(const std::string & target, BaseViewRef view) {
+	if (!mClip || !view) {
+		return 0;
+	}
+
+	size_t numBound = 0;
+
+	for (const auto & track : mClip->getTracks()) {
+		if (target != track.target) continue;
+
+		Binding binding;
+		binding.track = &track;
+		binding.view = view;
+		binding.cursor = 0;
+		mBindings.push_back(binding);
+		numBound++;
+	}
+
+	return numBound;
+}
+
+size_t KeyframePlayer::bindHierarchy(BaseViewRef root) {
+	if (!root) {
+		return 0;
+	}
+
+	size_t numBound = bind(root->getName(), root);
+
+	for (const auto & child : root->getChildren()) {
+		numBound += bindHierarchy(child);
+	}
+
+	return numBound;
+}
+
+//==================================================
+// Playback
+//
+
+void KeyframePlayer::stop() {
+	mIsPlaying = false;
+	setTime(0);
+}
+
+void KeyframePlayer::update(const double deltaTime) {
+	if (!mIsPlaying || !mClip) {
+		return;
+	}
+
+	const double duration = getDuration();
+	double time = mTime + deltaTime * (double)mSpeed;
+
+	if (time >= duration) {
+		if (mIsLooping && duration > 0) {
+			time = fmod(time, duration);
+		} else {
+			time = duration;
+			mIsPlaying = false;
+		}
+	} else if (time < 0) {
+		if (mIsLooping && duration > 0) {
+			time = duration + fmod(time, duration);
+		} else {
+			time = 0;
+			mIsPlaying = false;
+		}
+	}
+
+	setTime(time);
+}
+
+void KeyframePlayer::setTime(const double time) {
+	mTime = time;
+
+	for (auto & binding : mBindings) {
+		sample(binding, (float)time);
+	}
+}
+
+//==================================================
+// Sampling
+//
+
+void KeyframePlayer::sample(Binding & binding, const float time) const {
+	const KeyframeClip::Track & track = *binding.track;
+	const uint32_t numKeyframes = track.numKeyframes;
+
+	if (numKeyframes == 0) {
+		return;
+	}
+
+	uint32_t & cursor = binding.cursor;
+
+	if (time < track.times[cursor]) {
+		// seek backwards
+		const float * it = upper_bound(track.times, track.times + numKeyframes, time);
+		cursor = it == track.times ? 0 : (uint32_t)(it - track.times) - 1;
+	} else {
+		while (cursor + 1 < numKeyframes && track.times[cursor + 1] <= time) {
+			cursor++;
+		}
+	}
+
+	const uint32_t numComponents = track.numComponents;
+	const float * from = track.values + cursor * numComponents;
+	const uint8_t easing = track.easings[cursor];
+
+	if (cursor + 1 >= numKeyframes || time <= track.times[cursor] || easing == keyframes::kEasingHold) {
+		apply(binding.view.get(), track.property, from);
+		return;
+	}
+
+	const float * to = from + numComponents;
+	const float startTime = track.times[cursor];
+	const float endTime = track.times[cursor + 1];
+	const float t = (time - startTime) / (endTime - startTime);
+	const float easedT = easing < (uint8_t)EaseId::Custom ? evaluateEase((EaseId)easing, t) : t;
+
+	float value[keyframes::kMaxComponents];
+
+	for (uint32_t i = 0; i < numComponents; ++i) {
+		value[i] = from[i] + (to[i] - from[i]) * easedT;
+	}
+
+	apply(binding.view.get(), track.property, value);
+}
+
+void KeyframePlayer::apply(BaseView * view, const keyframes::Property property, const float * value) const {
+	switch (property) {
+		case keyframes::Property::Position: view->setPosition(vec2(value[0], value[1])); break;
+		case keyframes::Property::Scale: view->setScale(vec2(value[0], value[1])); break;
+		case keyframes::Property::Rotation: view->setRotation(value[0]); break;
+		case keyframes::Property::Alpha: view->setAlpha(value[0]); break;
+		case keyframes::Property::Tint: view->setTint(Color(value[0], value[1], value[2])); break;
+		case keyframes::Property::BackgroundColor: view->setBackgroundColor(ColorA(value[0], value[1], value[2], value[3])); break;
+		case keyframes::Property::TransformOrigin: view->setTransformOrigin(vec2(value[0], value[1])); break;
+		case keyframes::Property::Size: view->setSize(vec2(value[0], value[1])); break;
+		default: break;
+	}
+}
+
+}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "cinder/app/App.h"
+
+#include <vector>
+
+#include "BaseView.h"
+#include "KeyframeClip.h"
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class KeyframePlayer> KeyframePlayerRef;
+
+//! Samples the tracks of a KeyframeClip directly into the properties of bound views.
+//!
+//! Each bound track keeps a cursor to its current keyframe, so advancing the playhead monotonically costs amortized O(1)
+//! per track and frame. Seeking backwards uses a binary search. No tweens or timeline items are created.
+//!
+//!		auto player = KeyframePlayer::create(KeyframeClip::load(getAssetPath("intro.bckf")));
+//!		player->bindHierarchy(getRootView()); // binds tracks to views by name
+//!		player->play();
+//!		...
+//!		player->update(frameInfo.deltaTime);
+class KeyframePlayer {
+
+public:
+
+	static KeyframePlayerRef create(KeyframeClipRef clip = nullptr) { return std::make_shared<KeyframePlayer>(clip); }
+
+	KeyframePlayer(KeyframeClipRef clip = nullptr);
+	~KeyframePlayer();
+
+	//! Replaces the current clip and removes all bindings.
+	void			setClip(KeyframeClipRef clip);
+	KeyframeClipRef	getClip() const { return mClip; }
+
+	//! Binds all tracks with target to view. Returns the number of tracks that were bound.
+	size_t			bind(const std::string & target, BaseViewRef view);
+
+	//! Binds all tracks whose target matches the name of root or any of its descendants (see BaseView::getName()).
+	//! Returns the number of tracks that were bound.
+	size_t			bindHierarchy(BaseViewRef root);
+
+	void			unbindAll() { mBindings.clear(); }
+	size_t			getNumBindings() const { return mBindings.size(); }
+
+	void			play() { mIsPlaying = true; }
+	void			pause() { mIsPlaying = false; }
+
+	//! Pauses and moves the playhead back to the start.
+	void			stop();
+	bool			isPlaying() const { return mIsPlaying; }
+
+	//! Advances the playhead by deltaTime * speed and samples all tracks if playing. Stops at the end unless looping.
+	void			update(const double deltaTime);
+
+	//! Moves the playhead to time in seconds and samples all tracks.
+	void			setTime(const double time);
+	double			getTime() const { return mTime; }
+	double			getDuration() const { return mClip ? mClip->getDuration() : 0.0; }
+
+	bool			getLooping() const { return mIsLooping; }
+	void			setLooping(const bool value) { mIsLooping = value; }
+
+	float			getSpeed() const { return mSpeed; }
+	void			setSpeed(const float value) { mSpeed = value; }
+
+protected:
+
+	struct Binding {
+		const KeyframeClip::Track *	track;
+		BaseViewRef					view;
+		uint32_t					cursor;	//! Index of the last keyframe at or before the previously sampled time
+	};
+
+	void			sample(Binding & binding, const float time) const;
+	void			apply(BaseView * view, const keyframes::Property property, const float * value) const;
+
+	KeyframeClipRef			mClip;
+	std::vector<Binding>	mBindings;
+
+	double					mTime;
+	float					mSpeed;
+	bool					mIsPlaying;
+	bool					mIsLooping;
+};
+
+}
+}
@@ -0,0 +1,360 @@
+#include "PropertyBindings.h"
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "BaseView.h"
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Options
+//
+
+PropertyBindings::Options & PropertyBindings::Options::owner(BaseView * view) {
+	auto it = mBindings->mBindings.find(mId);
+	if (it == mBindings->mBindings.end()) return *this;
+
+	Binding & binding = it->second;
+
+	if (binding.owner) {
+		binding.owner->mNumBindings--;
+	}
+
+	binding.owner = view;
+
+	if (view) {
+		view->mNumBindings++;
+	}
+	return *this;
+}
+
+PropertyBindings::Options & PropertyBindings::Options::dependsOn(BaseView * view) {
+	auto it = mBindings->mBindings.find(mId);
+	if (it == mBindings->mBindings.end() || !view) return *this;
+
+	it->second.dependencies.push_back(view);
+	view->mNumBindings++;
+	return *this;
+}
+
+//==================================================
+// Lifecycle
+//
+
+PropertyBindingsRef PropertyBindings::get() {
+	static auto instance = std::make_shared<PropertyBindings>();
+	return instance;
+}
+
+PropertyBindings::PropertyBindings() :
+	mIsCompiled(true),
+	mNextBindingId(1),
+	mNumEvaluations(0)
+{
+}
+
+PropertyBindings::~PropertyBindings() {
+	clear();
+}
+
+void PropertyBindings::update() {
+	mNumEvaluations = 0;
+
+	if (mBindings.empty()) {
+		return;
+	}
+
+	if (!mIsCompiled) {
+		compile();
+	}
+
+	// bump versions of unbound sources that have changed since the last update
+	for (auto & node : mNodes) {
+		if (!node.isBound && updateSnapshot(node)) {
+			node.version++;
+		}
+	}
+
+	// evaluate in topological order so that targets are up to date before they're read by dependent bindings
+	for (const auto & compiled : mOrder) {
+		bool isDirty = false;
+
+		for (uint32_t i = compiled.firstSource; i < compiled.firstSource + compiled.numSources; ++i) {
+			const uint32_t version = mNodes[mSourceNodes[i]].version;
+
+			if (mSeenVersions[i] != version) {
+				mSeenVersions[i] = version;
+				isDirty = true;
+			}
+		}
+
+		if (!isDirty) {
+			continue;
+		}
+
+		compiled.binding->evaluate();
+		mNumEvaluations++;
+
+		Node & target = mNodes[compiled.targetNode];
+
+		if (updateSnapshot(target)) {
+			target.version++;
+
+			if (compiled.binding->owner) {
+				compiled.binding->owner->invalidate();
+			}
+		}
+	}
+}
+
+//==================================================
+// Binding management
+//
+
+PropertyBindings::Options PropertyBindings::addBinding(const Property & target, std::vector<Property> && sources, std::function<void()> && evaluate) {
+	if (wouldCreateCycle(target, sources)) {
+		CI_LOG_E("Can't bind property " << target.anim << " since it would depend on itself");
+		return Options(this, 0);
+	}
+
+	// replace existing binding on the same target
+	unbind(target.anim);
+
+	const BindingId id = mNextBindingId++;
+
+	Binding & binding = mBindings[id];
+	binding.target = target;
+	binding.sources = std::move(sources);
+	binding.evaluate = std::move(evaluate);
+
+	mBindingIdsByTarget[target.anim] = id;
+	mIsCompiled = false;
+
+	return Options(this, id);
+}
+
+bool PropertyBindings::unbind(const void * target) {
+	auto it = mBindingIdsByTarget.find(target);
+	if (it == mBindingIdsByTarget.end()) {
+		return false;
+	}
+	removeBinding(it->second);
+	return true;
+}
+
+bool PropertyBindings::unbindId(const BindingId id) {
+	if (mBindings.find(id) == mBindings.end()) {
+		return false;
+	}
+	removeBinding(id);
+	return true;
+}
+
+void PropertyBindings::unbindAll(const BaseView * view) {
+	if (!view) return;
+
+	vector<BindingId> ids;
+
+	for (const auto & it : mBindings) {
+		const Binding & binding = it.second;
+		if (binding.owner == view || find(binding.dependencies.begin(), binding.dependencies.end(), view) != binding.dependencies.end()) {
+			ids.push_back(it.first);
+		}
+	}
+
+	for (const auto id : ids) {
+		removeBinding(id);
+	}
+}
+
+void PropertyBindings::clear() {
+	while (!mBindings.empty()) {
+		removeBinding(mBindings.begin()->first);
+	}
+}
+
+void PropertyBindings::removeBinding(const BindingId id) {
+	auto it = mBindings.find(id);
+	if (it == mBindings.end()) {
+		return;
+	}
+
+	Binding & binding = it->second;
+
+	if (binding.owner) {
+		binding.owner->mNumBindings--;
+	}
+
+	for (auto view : binding.dependencies) {
+		view->mNumBindings--;
+	}
+
+	mBindingIdsByTarget.erase(binding.target.anim);
+	mBindings.erase(it);
+	mIsCompiled = false;
+}
+
+bool PropertyBindings::wouldCreateCycle(const Property & target, const std::vector<Property> & sources) const {
+	// walk all properties that depend on target and check if any of them is one of the new sources
+	vector<const void *> pending = { target.anim };
+	vector<const void *> visited;
+
+	while (!pending.empty()) {
+		const void * property = pending.back();
+		pending.pop_back();
+
+		for (const auto & source : sources) {
+			if (source.anim == property) {
+				return true;
+			}
+		}
+
+		if (find(visited.begin(), visited.end(), property) != visited.end()) {
+			continue;
+		}
+
+		visited.push_back(property);
+
+		for (const auto & it : mBindings) {
+			const Binding & binding = it.second;
+			for (const auto & source : binding.sources) {
+				if (source.anim == property) {
+					pending.push_back(binding.target.anim);
+					break;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+//==================================================
+// Compilation
+//
+
+void PropertyBindings::compile() {
+	mNodes.clear();
+	mOrder.clear();
+	mSourceNodes.clear();
+	mSeenVersions.clear();
+	mSnapshots.clear();
+
+	unordered_map<const void *, uint32_t> nodeIndices;
+
+	auto getNode = [&](const Property & property) {
+		auto it = nodeIndices.find(property.anim);
+		if (it != nodeIndices.end()) {
+			return it->second;
+		}
+
+		Node node;
+		node.value = property.value;
+		node.size = property.size;
+		node.snapshotOffset = (uint32_t)mSnapshots.size();
+
+		mSnapshots.resize(mSnapshots.size() + property.size);
+		memcpy(mSnapshots.data() + node.snapshotOffset, property.value, property.size);
+
+		const uint32_t index = (uint32_t)mNodes.size();
+		mNodes.push_back(node);
+		nodeIndices[property.anim] = index;
+		return index;
+	};
+
+	// collect nodes and count the unresolved sources of each binding
+	struct Entry {
+		const Binding *			binding;
+		uint32_t				targetNode;
+		vector<uint32_t>		sourceNodes;
+		uint32_t				numPendingSources;
+	};
+
+	vector<Entry> entries;
+	entries.reserve(mBindings.size());
+
+	for (const auto & it : mBindings) {
+		Entry entry;
+		entry.binding = &it.second;
+		entry.targetNode = getNode(it.second.target);
+		for (const auto & source : it.second.sources) {
+			entry.sourceNodes.push_back(getNode(source));
+		}
+		entry.numPendingSources = 0;
+		entries.push_back(std::move(entry));
+	}
+
+	// maps each bound node to the entry that writes it
+	vector<int> writers(mNodes.size(), -1);
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		writers[entries[i].targetNode] = (int)i;
+		mNodes[entries[i].targetNode].isBound = true;
+	}
+
+	vector<vector<uint32_t>> dependents(entries.size());
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		for (const auto sourceNode : entries[i].sourceNodes) {
+			const int writer = writers[sourceNode];
+			if (writer >= 0) {
+				dependents[writer].push_back((uint32_t)i);
+				entries[i].numPendingSources++;
+			}
+		}
+	}
+
+	// kahn's algorithm; cycles are rejected when binding, so all entries are resolved
+	vector<uint32_t> ready;
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		if (entries[i].numPendingSources == 0) {
+			ready.push_back((uint32_t)i);
+		}
+	}
+
+	for (size_t i = 0; i < ready.size(); ++i) {
+		const Entry & entry = entries[ready[i]];
+
+		CompiledBinding compiled;
+		compiled.binding = entry.binding;
+		compiled.targetNode = entry.targetNode;
+		compiled.firstSource = (uint32_t)mSourceNodes.size();
+		compiled.numSources = (uint32_t)entry.sourceNodes.size();
+		mOrder.push_back(compiled);
+
+		mSourceNodes.insert(mSourceNodes.end(), entry.sourceNodes.begin(), entry.sourceNodes.end());
+
+		for (const auto dependent : dependents[ready[i]]) {
+			if (--entries[dependent].numPendingSources == 0) {
+				ready.push_back(dependent);
+			}
+		}
+	}
+
+	// evaluate all bindings once after compiling
+	mSeenVersions.assign(mSourceNodes.size(), numeric_limits<uint32_t>::max());
+
+	mIsCompiled = true;
+}
+
+inline bool PropertyBindings::updateSnapshot(Node & node) {
+	uint8_t * snapshot = mSnapshots.data() + node.snapshotOffset;
+
+	if (memcmp(snapshot, node.value, node.size) == 0) {
+		return false;
+	}
+
+	memcpy(snapshot, node.value, node.size);
+	return true;
+}
+
+}
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/Tween.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "AnimOperators.h"
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class PropertyBindings> PropertyBindingsRef;
+
+class BaseView;
+
+//! Declarative bindings that derive ci::Anim properties from other ci::Anim properties.
+//!
+//! Each binding writes the result of a function of one or more source properties into a target property. Bindings form
+//! a dependency graph (the target of one binding can be the source of another) and are evaluated once per update in
+//! topological order. A binding is only evaluated when the version of one of its sources has changed since its last
+//! evaluation. Versions of plain properties are bumped when their value changes, versions of bound targets are bumped
+//! when their binding writes a new value. Functions receive their sources as const ci::Anim<T>&, so the operators in
+//! AnimOperators.h can be used directly:
+//!
+//!		// keep a label at half of the panel's alpha and a badge at the card's corner
+//!		label->bind(label->getAlpha(), [](const Anim<float> & alpha) { return alpha * 0.5f; }, panel->getAlpha()).dependsOn(panel.get());
+//!		badge->bind(badge->getPosition(), [](const Anim<vec2> & pos) { return pos + vec2(200, -10); }, card->getPosition()).dependsOn(card.get());
+//!
+//! The BaseApp updates the shared instance once per frame after the scene has been updated. Each target can only have one
+//! binding; binding a target again replaces its binding. Bindings that would create a cycle are rejected. Bound targets
+//! shouldn't be animated at the same time, since the binding only overwrites them when its sources change.
+//! Not thread-safe.
+class PropertyBindings {
+
+public:
+
+	typedef uint32_t BindingId;	//! 0 is never used as a valid id
+
+	//! Chainable options of a binding. Only valid until the next call to any method that removes bindings.
+	class Options {
+	public:
+		//! Invalidates owner whenever the binding changes its target and removes the binding when owner is destroyed.
+		Options & owner(BaseView * view);
+
+		//! Removes the binding when view is destroyed. Use this for the views that own the source properties.
+		Options & dependsOn(BaseView * view);
+
+		BindingId getId() const { return mId; }
+
+	protected:
+		friend class PropertyBindings;
+		Options(PropertyBindings * bindings, const BindingId id) : mBindings(bindings), mId(id) {}
+
+		PropertyBindings *	mBindings;
+		BindingId			mId;
+	};
+
+	//! Shared instance that is updated by the BaseApp.
+	static PropertyBindingsRef get();
+
+	PropertyBindings();
+	~PropertyBindings();
+
+	//! Evaluates all bindings whose sources have changed in topological order.
+	void			update();
+
+	//! Binds target to fn(sources...). fn is called with const ci::Anim<S>& for each source and returns the new target value.
+	template <typename T, typename F, typename... S>
+	Options			bind(ci::Anim<T> & target, F fn, ci::Anim<S> &... sources);
+
+	//! Binds target to the value of source.
+	template <typename T>
+	Options			bind(ci::Anim<T> & target, ci::Anim<T> & source) {
+		return bind(target, [](const ci::Anim<T> & value) { return value.value(); }, source);
+	}
+
+	//! Removes the binding of target. Returns false if target isn't bound.
+	bool			unbind(const void * target);
+
+	//! Removes a binding by id. Returns false if the binding doesn't exist.
+	bool			unbindId(const BindingId id);
+
+	//! Removes all bindings that are owned by or depend on view.
+	void			unbindAll(const BaseView * view);
+
+	//! Removes all bindings.
+	void			clear();
+
+	bool			isBound(const void * target) const	{ return mBindingIdsByTarget.find(target) != mBindingIdsByTarget.end(); }
+	size_t			getNumBindings() const				{ return mBindings.size(); }
+
+	//! Number of bindings that have been evaluated during the last update.
+	size_t			getNumEvaluations() const			{ return mNumEvaluations; }
+
+protected:
+
+	//! A bound ci::Anim property. Values are compared bytewise to detect changes.
+	struct Property {
+		const void *	anim	= nullptr;	//! Key of this property (the ci::Anim instance)
+		const void *	value	= nullptr;	//! Address of the ci::Anim's value
+		uint32_t		size	= 0;		//! Size of the value in bytes
+	};
+
+	struct Binding {
+		Property				target;
+		std::vector<Property>	sources;
+		std::function<void()>	evaluate;	//! Writes fn(sources...) into the target
+		BaseView *				owner = nullptr;
+		std::vector<BaseView *>	dependencies;
+	};
+
+	//! Property in the compiled graph with its version and the snapshot it was last compared to
+	struct Node {
+		const void *	value			= nullptr;
+		uint32_t		size			= 0;
+		uint32_t		snapshotOffset	= 0;		//! Offset into mSnapshots
+		uint32_t		version			= 0;
+		bool			isBound			= false;	//! True if the node is the target of a binding
+	};
+
+	//! Binding in the compiled graph, stored in topological order
+	struct CompiledBinding {
+		const Binding *	binding;
+		uint32_t		targetNode;
+		uint32_t		firstSource;	//! Index into mSourceNodes and mSeenVersions
+		uint32_t		numSources;
+	};
+
+	template <typename T>
+	static Property		getProperty(ci::Anim<T> & anim) { Property property; property.anim = &anim; property.value = &anim.value(); property.size = (uint32_t)sizeof(T); return property; }
+
+	Options				addBinding(const Property & target, std::vector<Property> && sources, std::function<void()> && evaluate);
+	bool				wouldCreateCycle(const Property & target, const std::vector<Property> & sources) const;
+	void				removeBinding(const BindingId id);
+
+	//! Rebuilds nodes and the topological order of all bindings. All bindings are evaluated during the next update.
+	void				compile();
+
+	//! Copies the current value of node into its snapshot. Returns true if the value has changed.
+	inline bool			updateSnapshot(Node & node);
+
+	std::unordered_map<BindingId, Binding>			mBindings;
+	std::unordered_map<const void *, BindingId>		mBindingIdsByTarget;
+
+	// Compiled graph
+	std::vector<Node>				mNodes;
+	std::vector<CompiledBinding>	mOrder;
+	std::vector<uint32_t>			mSourceNodes;
+	std::vector<uint32_t>			mSeenVersions;	//! Versions of source nodes at the last evaluation
+	std::vector<uint8_t>			mSnapshots;
+	bool							mIsCompiled;
+
+	BindingId						mNextBindingId;
+	size_t							mNumEvaluations;
+};
+
+//==================================================
+// Template implementations
+//
+
+template <typename T, typename F, typename... S>
+PropertyBindings::Options PropertyBindings::bind(ci::Anim<T> & target, F fn, ci::Anim<S> &... sources) {
+	static_assert(sizeof...(S) > 0, "Bindings need at least one source");
+
+	ci::Anim<T> * targetPtr = &target;
+	std::function<void()> evaluate = [targetPtr, fn, &sources...] {
+		*targetPtr->ptr() = fn(sources...);
+	};
+
+	return addBinding(getProperty(target), { getProperty(sources)... }, std::move(evaluate));
+}
+
+}
+}
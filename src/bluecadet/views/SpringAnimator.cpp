@@ -0,0 +1,356 @@
+#include "SpringAnimator.h"
+
+#include "AnimationScheduler.h"
+#include "BaseView.h"
+
+using namespace ci;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Value helpers
+//
+
+namespace {
+	inline float lengthSquared(const float value) { return value * value; }
+	inline float lengthSquared(const vec2 & value) { return glm::dot(value, value); }
+	inline float lengthSquared(const Color & value) { return value.r * value.r + value.g * value.g + value.b * value.b; }
+	inline float lengthSquared(const ColorA & value) { return value.r * value.r + value.g * value.g + value.b * value.b + value.a * value.a; }
+
+	template <typename T> inline T zero();
+	template <> inline float zero<float>() { return 0.0f; }
+	template <> inline vec2 zero<vec2>() { return vec2(0); }
+	template <> inline Color zero<Color>() { return Color(0, 0, 0); }
+	template <> inline ColorA zero<ColorA>() { return ColorA(0, 0, 0, 0); }
+
+	//! Upper bound of integration steps per update so that long frames don't stall the app
+	const int kMaxStepsPerUpdate = 64;
+}
+
+//==================================================
+// Options
+//
+
+SpringAnimator::Options & SpringAnimator::Options::restFn(const RestFn & fn) {
+	if (!mAnimator->isAnimating(mTarget)) return *this;
+
+	if (fn) {
+		mAnimator->mRestFns[mId] = fn;
+	} else {
+		mAnimator->mRestFns.erase(mId);
+	}
+	return *this;
+}
+
+SpringAnimator::Options & SpringAnimator::Options::owner(BaseView * view) {
+	auto it = mAnimator->mLocationsByTarget.find(mTarget);
+	if (it == mAnimator->mLocationsByTarget.end()) return *this;
+
+	const SpringLocation & location = it->second;
+	switch (location.type) {
+		case SpringType::Float: mAnimator->setSpringOwner(mAnimator->mFloatSprings, location.index, view); break;
+		case SpringType::Vec2: mAnimator->setSpringOwner(mAnimator->mVec2Springs, location.index, view); break;
+		case SpringType::Color: mAnimator->setSpringOwner(mAnimator->mColorSprings, location.index, view); break;
+		case SpringType::ColorA: mAnimator->setSpringOwner(mAnimator->mColorASprings, location.index, view); break;
+	}
+	return *this;
+}
+
+//==================================================
+// Lifecycle
+//
+
+SpringAnimator::SpringAnimator(AnimationScheduler * scheduler) :
+	mScheduler(scheduler),
+	mSubstep(1.0f / 240.0f),
+	mLastTime(-1.0),
+	mAccumulatedTime(0),
+	mNextSpringId(1)
+{
+}
+
+SpringAnimator::~SpringAnimator() {
+	clear();
+}
+
+void SpringAnimator::update(const double time) {
+	if (mLastTime < 0 || time < mLastTime) {
+		mLastTime = time;
+	}
+
+	mAccumulatedTime += time - mLastTime;
+	mLastTime = time;
+
+	const double substep = (double)max(mSubstep, 1e-4f);
+	int numSteps = (int)(mAccumulatedTime / substep);
+	mAccumulatedTime -= (double)numSteps * substep;
+
+	if (numSteps > kMaxStepsPerUpdate) {
+		numSteps = kMaxStepsPerUpdate;
+		mAccumulatedTime = 0;
+	}
+
+	if (numSteps == 0 || getNumSprings() == 0) {
+		return;
+	}
+
+	updateSprings(mFloatSprings, numSteps);
+	updateSprings(mVec2Springs, numSteps);
+	updateSprings(mColorSprings, numSteps);
+	updateSprings(mColorASprings, numSteps);
+
+	// rest functions can add or cancel springs, so they're called once all arrays are consistent
+	if (!mPendingRestFns.empty()) {
+		vector<RestFn> restFns;
+		restFns.swap(mPendingRestFns);
+		for (auto & fn : restFns) {
+			fn();
+		}
+		restFns.clear();
+		if (mPendingRestFns.empty()) {
+			mPendingRestFns.swap(restFns); // keep capacity
+		}
+	}
+}
+
+//==================================================
+// Spring management
+//
+
+bool SpringAnimator::cancel(const void * target) {
+	auto it = mLocationsByTarget.find(target);
+	if (it == mLocationsByTarget.end()) {
+		return false;
+	}
+	removeSpring(it->second);
+	return true;
+}
+
+void SpringAnimator::cancelAll(const BaseView * owner) {
+	if (!owner) return;
+	removeSpringsOwnedBy(mFloatSprings, owner);
+	removeSpringsOwnedBy(mVec2Springs, owner);
+	removeSpringsOwnedBy(mColorSprings, owner);
+	removeSpringsOwnedBy(mColorASprings, owner);
+}
+
+void SpringAnimator::clear() {
+	while (mFloatSprings.size() > 0) removeSpring(mFloatSprings, (uint32_t)mFloatSprings.size() - 1);
+	while (mVec2Springs.size() > 0) removeSpring(mVec2Springs, (uint32_t)mVec2Springs.size() - 1);
+	while (mColorSprings.size() > 0) removeSpring(mColorSprings, (uint32_t)mColorSprings.size() - 1);
+	while (mColorASprings.size() > 0) removeSpring(mColorASprings, (uint32_t)mColorASprings.size() - 1);
+}
+
+size_t SpringAnimator::getNumSprings() const {
+	return mFloatSprings.size() + mVec2Springs.size() + mColorSprings.size() + mColorASprings.size();
+}
+
+void SpringAnimator::removeSpring(const SpringLocation & location) {
+	switch (location.type) {
+		case SpringType::Float: removeSpring(mFloatSprings, location.index); break;
+		case SpringType::Vec2: removeSpring(mVec2Springs, location.index); break;
+		case SpringType::Color: removeSpring(mColorSprings, location.index); break;
+		case SpringType::ColorA: removeSpring(mColorASprings, location.index); break;
+	}
+}
+
+//==================================================
+// Typed helpers
+//
+
+template <> SpringAnimator::SpringArray<float> & SpringAnimator::getSprings<float>() { return mFloatSprings; }
+template <> SpringAnimator::SpringArray<vec2> & SpringAnimator::getSprings<vec2>() { return mVec2Springs; }
+template <> SpringAnimator::SpringArray<Color> & SpringAnimator::getSprings<Color>() { return mColorSprings; }
+template <> SpringAnimator::SpringArray<ColorA> & SpringAnimator::getSprings<ColorA>() { return mColorASprings; }
+
+template <> SpringAnimator::SpringType SpringAnimator::getSpringType<float>() { return SpringType::Float; }
+template <> SpringAnimator::SpringType SpringAnimator::getSpringType<vec2>() { return SpringType::Vec2; }
+template <> SpringAnimator::SpringType SpringAnimator::getSpringType<Color>() { return SpringType::Color; }
+template <> SpringAnimator::SpringType SpringAnimator::getSpringType<ColorA>() { return SpringType::ColorA; }
+
+template <typename T>
+SpringAnimator::SpringId SpringAnimator::addSpring(ci::Anim<T> * target, const T & value, const Params & params) {
+	if (!target) {
+		return 0;
+	}
+
+	SpringArray<T> & springs = getSprings<T>();
+	const float invMass = params.getMass() > 0 ? 1.0f / params.getMass() : 1.0f;
+	const float restThreshold = params.getRestThreshold();
+
+	auto it = mLocationsByTarget.find(target);
+
+	if (it != mLocationsByTarget.end() && it->second.type == getSpringType<T>()) {
+		// retarget and keep the current value and velocity
+		const uint32_t index = it->second.index;
+		springs.goals[index] = value;
+		springs.stiffnesses[index] = params.getStiffness() * invMass;
+		springs.dampings[index] = params.getDamping() * invMass;
+		springs.restThresholds[index] = restThreshold * restThreshold;
+		return springs.ids[index];
+	}
+
+	// replace scheduled and timeline tweens that would otherwise compete with this spring
+	if (mScheduler) {
+		mScheduler->cancel(target);
+	}
+	target->stop();
+
+	const SpringId id = mNextSpringId++;
+	const uint32_t index = (uint32_t)springs.size();
+
+	springs.targets.push_back(target);
+	springs.values.push_back(target->value());
+	springs.velocities.push_back(zero<T>());
+	springs.goals.push_back(value);
+	springs.stiffnesses.push_back(params.getStiffness() * invMass);
+	springs.dampings.push_back(params.getDamping() * invMass);
+	springs.restThresholds.push_back(restThreshold * restThreshold);
+	springs.owners.push_back(nullptr);
+	springs.ids.push_back(id);
+
+	SpringLocation location;
+	location.type = getSpringType<T>();
+	location.index = index;
+	mLocationsByTarget[target] = location;
+
+	return id;
+}
+
+template <typename T>
+void SpringAnimator::updateSprings(SpringArray<T> & springs, const int numSteps) {
+	const size_t numSprings = springs.size();
+	const float dt = max(mSubstep, 1e-4f);
+
+	for (size_t i = 0; i < numSprings; ++i) {
+		T value = springs.values[i];
+		T velocity = springs.velocities[i];
+		const T goal = springs.goals[i];
+		const float stiffness = springs.stiffnesses[i];
+		const float damping = springs.dampings[i];
+
+		// semi-implicit euler
+		for (int step = 0; step < numSteps; ++step) {
+			const T acceleration = (goal - value) * stiffness - velocity * damping;
+			velocity = velocity + acceleration * dt;
+			value = value + velocity * dt;
+		}
+
+		const float restThreshold = springs.restThresholds[i];
+		const bool isResting = lengthSquared(goal - value) <= restThreshold && lengthSquared(velocity) <= restThreshold;
+
+		if (isResting) {
+			value = goal;
+			velocity = zero<T>();
+			mRestingIndices.push_back((uint32_t)i);
+		}
+
+		springs.values[i] = value;
+		springs.velocities[i] = velocity;
+
+		BaseView * owner = springs.owners[i];
+
+		if (owner) {
+			// owners that can't be seen catch up once they're stepped again; resting is never delayed
+			if (owner->mIsAnimationThrottled && !isResting) continue;
+			owner->invalidate();
+		}
+
+		*springs.targets[i]->ptr() = value;
+	}
+
+	// remove in reverse order so that swapped-in springs are never resting ones
+	for (auto it = mRestingIndices.rbegin(); it != mRestingIndices.rend(); ++it) {
+		auto restIt = mRestFns.find(springs.ids[*it]);
+		if (restIt != mRestFns.end()) {
+			mPendingRestFns.push_back(restIt->second);
+		}
+		removeSpring(springs, *it);
+	}
+
+	mRestingIndices.clear();
+}
+
+template <typename T>
+void SpringAnimator::removeSpring(SpringArray<T> & springs, const uint32_t index) {
+	const SpringId id = springs.ids[index];
+
+	if (springs.owners[index]) {
+		springs.owners[index]->mNumScheduledTweens--;
+	}
+
+	mRestFns.erase(id);
+	mLocationsByTarget.erase(springs.targets[index]);
+
+	// swap with last spring
+	const uint32_t lastIndex = (uint32_t)springs.size() - 1;
+
+	if (index != lastIndex) {
+		springs.targets[index] = springs.targets[lastIndex];
+		springs.values[index] = springs.values[lastIndex];
+		springs.velocities[index] = springs.velocities[lastIndex];
+		springs.goals[index] = springs.goals[lastIndex];
+		springs.stiffnesses[index] = springs.stiffnesses[lastIndex];
+		springs.dampings[index] = springs.dampings[lastIndex];
+		springs.restThresholds[index] = springs.restThresholds[lastIndex];
+		springs.owners[index] = springs.owners[lastIndex];
+		springs.ids[index] = springs.ids[lastIndex];
+		mLocationsByTarget[springs.targets[index]].index = index;
+	}
+
+	springs.targets.pop_back();
+	springs.values.pop_back();
+	springs.velocities.pop_back();
+	springs.goals.pop_back();
+	springs.stiffnesses.pop_back();
+	springs.dampings.pop_back();
+	springs.restThresholds.pop_back();
+	springs.owners.pop_back();
+	springs.ids.pop_back();
+}
+
+template <typename T>
+void SpringAnimator::removeSpringsOwnedBy(SpringArray<T> & springs, const BaseView * owner) {
+	for (size_t i = springs.size(); i-- > 0;) {
+		if (springs.owners[i] == owner) {
+			removeSpring(springs, (uint32_t)i);
+		}
+	}
+}
+
+template <typename T>
+void SpringAnimator::setSpringVelocity(const void * target, const T & velocity) {
+	auto it = mLocationsByTarget.find(target);
+	if (it != mLocationsByTarget.end() && it->second.type == getSpringType<T>()) {
+		getSprings<T>().velocities[it->second.index] = velocity;
+	}
+}
+
+template <typename T>
+void SpringAnimator::setSpringOwner(SpringArray<T> & springs, const uint32_t index, BaseView * owner) {
+	if (springs.owners[index]) {
+		springs.owners[index]->mNumScheduledTweens--;
+	}
+
+	springs.owners[index] = owner;
+
+	if (owner) {
+		owner->mNumScheduledTweens++;
+	}
+}
+
+// explicit instantiations for all supported types
+template SpringAnimator::SpringId SpringAnimator::addSpring<float>(ci::Anim<float> *, const float &, const Params &);
+template SpringAnimator::SpringId SpringAnimator::addSpring<vec2>(ci::Anim<vec2> *, const vec2 &, const Params &);
+template SpringAnimator::SpringId SpringAnimator::addSpring<Color>(ci::Anim<Color> *, const Color &, const Params &);
+template SpringAnimator::SpringId SpringAnimator::addSpring<ColorA>(ci::Anim<ColorA> *, const ColorA &, const Params &);
+
+template void SpringAnimator::setSpringVelocity<float>(const void *, const float &);
+template void SpringAnimator::setSpringVelocity<vec2>(const void *, const vec2 &);
+template void SpringAnimator::setSpringVelocity<Color>(const void *, const Color &);
+template void SpringAnimator::setSpringVelocity<ColorA>(const void *, const ColorA &);
+
+}
+}
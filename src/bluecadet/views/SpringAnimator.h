@@ -0,0 +1,194 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/Tween.h"
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class SpringAnimator> SpringAnimatorRef;
+
+class AnimationScheduler;
+class BaseView;
+
+//! Damped springs for interactive motion like drag release, snap-back or magnetic docking.
+//!
+//! Each spring holds its value, velocity and target in flat, type-segregated arrays (float, vec2, Color and ColorA).
+//! All springs are integrated in one pass per frame with fixed substeps, so results don't depend on the frame rate.
+//! Retargeting a running spring only replaces its target and keeps its velocity, which makes it cheap to call
+//! setTarget() at touch rate. Springs are removed once they come to rest at their target.
+//!
+//! The shared instance is owned and advanced by the AnimationScheduler (see AnimationScheduler::getSprings()) and
+//! follows the same ownership rules as scheduled tweens. Setting a spring replaces any tween on the same target and
+//! vice versa. Not thread-safe.
+class SpringAnimator {
+
+public:
+
+	typedef uint32_t				SpringId;	//! 0 is never used as a valid id
+	typedef std::function<void()>	RestFn;
+
+	//! Spring parameters. The defaults are slightly under-damped and settle in about half a second.
+	struct Params {
+		Params & stiffness(float v)		{ mStiffness = v; return *this; }
+		Params & damping(float v)		{ mDamping = v; return *this; }
+		Params & mass(float v)			{ mMass = v; return *this; }
+		Params & restThreshold(float v)	{ mRestThreshold = v; return *this; }
+
+		float getStiffness() const		{ return mStiffness; }
+		float getDamping() const		{ return mDamping; }
+		float getMass() const			{ return mMass; }
+		float getRestThreshold() const	{ return mRestThreshold; }	//! Max distance to the target and speed at which the spring is at rest
+
+	private:
+		float mStiffness = 170.0f;
+		float mDamping = 26.0f;
+		float mMass = 1.0f;
+		float mRestThreshold = 0.01f;
+	};
+
+	//! Chainable options of a spring. Only valid until the next call to update() or any call that removes springs.
+	class Options {
+	public:
+		//! Sets the current velocity in units per second (e.g. the velocity of a released drag).
+		template <typename T>
+		Options & velocity(const T & value);
+
+		//! Called once the spring comes to rest at its target.
+		Options & restFn(const RestFn & fn);
+
+		//! Invalidates owner whenever the spring changes its target and removes the spring when the owner is destroyed.
+		Options & owner(BaseView * view);
+
+		SpringId getId() const { return mId; }
+
+	protected:
+		friend class SpringAnimator;
+		Options(SpringAnimator * animator, const void * target, const SpringId id) : mAnimator(animator), mTarget(target), mId(id) {}
+
+		SpringAnimator *	mAnimator;
+		const void *		mTarget;
+		SpringId			mId;
+	};
+
+	SpringAnimator(AnimationScheduler * scheduler = nullptr);
+	~SpringAnimator();
+
+	//! Integrates all springs up to time in seconds and calls the rest functions of springs that came to rest.
+	void				update(const double time);
+
+	//! Moves target towards value. Starts a new spring at the target's current value or retargets the existing spring.
+	template <typename T>
+	Options				setTarget(ci::Anim<T> * target, const T & value, const Params & params = Params());
+
+	//! Removes the spring of target without calling its rest function. Returns false if target has no spring.
+	bool				cancel(const void * target);
+
+	//! Removes all springs owned by view without calling their rest functions.
+	void				cancelAll(const BaseView * owner);
+
+	//! Removes all springs without calling their rest functions.
+	void				clear();
+
+	bool				isAnimating(const void * target) const	{ return mLocationsByTarget.find(target) != mLocationsByTarget.end(); }
+	size_t				getNumSprings() const;
+
+	//! Duration of a single integration step in seconds. Defaults to 1/240s.
+	float				getSubstep() const			{ return mSubstep; }
+	void				setSubstep(const float value)	{ mSubstep = value; }
+
+protected:
+
+	enum class SpringType : uint8_t { Float, Vec2, Color, ColorA };
+
+	//! Struct of arrays for all springs of one value type. Entries at the same index belong to the same spring.
+	template <typename T>
+	struct SpringArray {
+		std::vector<ci::Anim<T> *>	targets;
+		std::vector<T>				values;
+		std::vector<T>				velocities;
+		std::vector<T>				goals;
+		std::vector<float>			stiffnesses;	//! Stiffness / mass
+		std::vector<float>			dampings;		//! Damping / mass
+		std::vector<float>			restThresholds;	//! Squared
+		std::vector<BaseView *>		owners;
+		std::vector<SpringId>		ids;
+
+		size_t size() const { return targets.size(); }
+	};
+
+	struct SpringLocation {
+		SpringType	type;
+		uint32_t	index;
+	};
+
+	template <typename T> struct IsSupportedType : std::integral_constant<bool,
+		std::is_same<T, float>::value || std::is_same<T, ci::vec2>::value ||
+		std::is_same<T, ci::Color>::value || std::is_same<T, ci::ColorA>::value> {};
+
+	template <typename T> SpringArray<T> &	getSprings();
+	template <typename T> static SpringType	getSpringType();
+
+	template <typename T>
+	SpringId			addSpring(ci::Anim<T> * target, const T & value, const Params & params);
+
+	template <typename T>
+	void				updateSprings(SpringArray<T> & springs, const int numSteps);
+
+	template <typename T>
+	void				removeSpring(SpringArray<T> & springs, const uint32_t index);
+	void				removeSpring(const SpringLocation & location);
+
+	template <typename T>
+	void				removeSpringsOwnedBy(SpringArray<T> & springs, const BaseView * owner);
+
+	template <typename T>
+	void				setSpringVelocity(const void * target, const T & velocity);
+
+	template <typename T>
+	void				setSpringOwner(SpringArray<T> & springs, const uint32_t index, BaseView * owner);
+
+	AnimationScheduler *	mScheduler;	//! Used to cancel tweens that compete with new springs
+
+	SpringArray<float>		mFloatSprings;
+	SpringArray<ci::vec2>	mVec2Springs;
+	SpringArray<ci::Color>	mColorSprings;
+	SpringArray<ci::ColorA>	mColorASprings;
+
+	std::unordered_map<const void *, SpringLocation>	mLocationsByTarget;
+	std::unordered_map<SpringId, RestFn>				mRestFns;
+
+	std::vector<uint32_t>	mRestingIndices;	//! Scratch buffer reused across updates
+	std::vector<RestFn>		mPendingRestFns;	//! Called after all springs have been integrated
+
+	float					mSubstep;
+	double					mLastTime;		//! -1 before the first update
+	double					mAccumulatedTime;
+	SpringId				mNextSpringId;
+};
+
+//==================================================
+// Template implementations
+//
+
+template <typename T>
+SpringAnimator::Options SpringAnimator::setTarget(ci::Anim<T> * target, const T & value, const Params & params) {
+	static_assert(IsSupportedType<T>::value, "SpringAnimator only supports float, vec2, Color and ColorA springs");
+	return Options(this, target, addSpring<T>(target, value, params));
+}
+
+template <typename T>
+SpringAnimator::Options & SpringAnimator::Options::velocity(const T & value) {
+	static_assert(IsSupportedType<T>::value, "SpringAnimator only supports float, vec2, Color and ColorA springs");
+	mAnimator->setSpringVelocity<T>(mTarget, value);
+	return *this;
+}
+
+}
+}
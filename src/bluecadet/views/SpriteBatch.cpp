@@ -0,0 +1,131 @@
+#include "SpriteBatch.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+SpriteBatchRef SpriteBatch::get() {
+	static auto instance = std::make_shared<SpriteBatch>();
+	return instance;
+}
+
+SpriteBatch::SpriteBatch() :
+	mTexture(nullptr),
+	mVboMesh(nullptr),
+	mBatch(nullptr),
+	mNumAllocatedVertices(0),
+	mNumDrawCalls(0)
+{
+}
+
+SpriteBatch::~SpriteBatch() {
+}
+
+void SpriteBatch::drawTexture(const ci::gl::Texture2dRef & texture, const ci::Area & srcArea, const ci::Rectf & destRect,
+							  const ci::mat4 & transform, const ci::ColorA & color) {
+	if (!texture) {
+		return;
+	}
+
+	if (texture != mTexture) {
+		flush();
+		mTexture = texture;
+	}
+
+	const Rectf texCoords = texture->getAreaTexCoords(srcArea);
+	const vec3 upperLeft = vec3(transform * vec4(destRect.x1, destRect.y1, 0, 1));
+	const vec3 upperRight = vec3(transform * vec4(destRect.x2, destRect.y1, 0, 1));
+	const vec3 lowerRight = vec3(transform * vec4(destRect.x2, destRect.y2, 0, 1));
+	const vec3 lowerLeft = vec3(transform * vec4(destRect.x1, destRect.y2, 0, 1));
+	const vec4 colorVec(color.r, color.g, color.b, color.a);
+
+	// two triangles per quad so that quads don't need to be connected
+	mPositions.insert(mPositions.end(), {upperLeft, upperRight, lowerRight, upperLeft, lowerRight, lowerLeft});
+	mTexCoords.insert(mTexCoords.end(), {
+		vec2(texCoords.x1, texCoords.y1), vec2(texCoords.x2, texCoords.y1), vec2(texCoords.x2, texCoords.y2),
+		vec2(texCoords.x1, texCoords.y1), vec2(texCoords.x2, texCoords.y2), vec2(texCoords.x1, texCoords.y2)
+	});
+	mColors.insert(mColors.end(), 6, colorVec);
+}
+
+void SpriteBatch::drawMesh(const ci::gl::Texture2dRef & texture, const ci::vec2 * positions, const ci::vec2 * texCoords, const size_t numVertices,
+						   const uint16_t * indices, const size_t numIndices, const ci::mat4 & transform, const ci::ColorA & color) {
+	if (!texture) {
+		return;
+	}
+
+	if (texture != mTexture) {
+		flush();
+		mTexture = texture;
+	}
+
+	// transform each vertex once, then expand the indices into the triangle list
+	mTransformedPositions.resize(numVertices);
+
+	for (size_t i = 0; i < numVertices; ++i) {
+		mTransformedPositions[i] = vec3(transform * vec4(positions[i], 0, 1));
+	}
+
+	for (size_t i = 0; i < numIndices; ++i) {
+		mPositions.push_back(mTransformedPositions[indices[i]]);
+		mTexCoords.push_back(texCoords[indices[i]]);
+	}
+
+	mColors.insert(mColors.end(), numIndices, vec4(color.r, color.g, color.b, color.a));
+}
+
+void SpriteBatch::flush() {
+	if (mPositions.empty()) {
+		mTexture = nullptr;
+		return;
+	}
+
+	const size_t numVertices = mPositions.size();
+
+	if (numVertices > mNumAllocatedVertices) {
+		createBatch(numVertices);
+	}
+
+	mVboMesh->bufferAttrib(geom::POSITION, numVertices * sizeof(vec3), mPositions.data());
+	mVboMesh->bufferAttrib(geom::TEX_COORD_0, numVertices * sizeof(vec2), mTexCoords.data());
+	mVboMesh->bufferAttrib(geom::COLOR, numVertices * sizeof(vec4), mColors.data());
+
+	{
+		// vertices are already in the space of the batch's parent
+		gl::ScopedModelMatrix scopedModelMatrix;
+		gl::setModelMatrix(mat4());
+		gl::ScopedTextureBind scopedTexture(mTexture);
+		mBatch->draw(0, (GLsizei)numVertices);
+	}
+
+	mNumDrawCalls++;
+
+	mTexture = nullptr;
+	mPositions.clear();
+	mTexCoords.clear();
+	mColors.clear();
+}
+
+void SpriteBatch::createBatch(const size_t numVertices) {
+	// grow geometrically to avoid reallocating buffers when the number of quads changes slightly
+	mNumAllocatedVertices = std::max(numVertices, mNumAllocatedVertices * 2);
+
+	auto layout = gl::VboMesh::Layout().usage(GL_DYNAMIC_DRAW).interleave(false)
+		.attrib(geom::POSITION, 3)
+		.attrib(geom::TEX_COORD_0, 2)
+		.attrib(geom::COLOR, 4);
+
+	mVboMesh = gl::VboMesh::create((uint32_t)mNumAllocatedVertices, GL_TRIANGLES, vector<gl::VboMesh::Layout>({layout}));
+
+	if (mBatch) {
+		mBatch->replaceVboMesh(mVboMesh);
+	} else {
+		mBatch = gl::Batch::create(mVboMesh, gl::getStockShader(gl::ShaderDef().texture().color()));
+	}
+}
+
+}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Batch.h"
+#include "cinder/gl/Texture.h"
+#include "cinder/gl/VboMesh.h"
+
+#include <vector>
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class SpriteBatch> SpriteBatchRef;
+
+//! Collects textured quads that share a texture and draws them with a single draw call. Quads are transformed on
+//! the CPU, so each one can have its own model matrix and color. The batch is flushed whenever a quad with a
+//! different texture is added and whenever flush() is called, which must happen before any other GL state changes.
+//!
+//! Used by BaseView::drawChildren() to merge consecutive views that support batched drawing, such as ImageViews
+//! that display images from the same TextureAtlas page.
+class SpriteBatch {
+
+public:
+	//! Shared instance used by BaseView.
+	static SpriteBatchRef get();
+
+	SpriteBatch();
+	~SpriteBatch();
+
+	//! Adds a quad that draws srcArea of texture into destRect. Positions are transformed by transform.
+	void			drawTexture(const ci::gl::Texture2dRef & texture, const ci::Area & srcArea, const ci::Rectf & destRect,
+								const ci::mat4 & transform, const ci::ColorA & color);
+
+	//! Adds indexed triangles of texture. Positions are in local space and transformed by transform, tex coords are normalized.
+	//! Used for meshes that aren't a single quad, like nine-slice images.
+	void			drawMesh(const ci::gl::Texture2dRef & texture, const ci::vec2 * positions, const ci::vec2 * texCoords, const size_t numVertices,
+							 const uint16_t * indices, const size_t numIndices, const ci::mat4 & transform, const ci::ColorA & color);
+
+	//! Draws all pending quads with the current view and projection matrices and blend state.
+	void			flush();
+
+	bool			isEmpty() const			{ return mPositions.empty(); }
+
+	//! Number of draw calls issued since the last call of resetNumDrawCalls().
+	size_t			getNumDrawCalls() const	{ return mNumDrawCalls; }
+	void			resetNumDrawCalls()		{ mNumDrawCalls = 0; }
+
+protected:
+	void			createBatch(const size_t numVertices);
+
+	ci::gl::Texture2dRef	mTexture;
+	std::vector<ci::vec3>	mPositions;
+	std::vector<ci::vec2>	mTexCoords;
+	std::vector<ci::vec4>	mColors;
+	std::vector<ci::vec3>	mTransformedPositions;	//! Scratch buffer of drawMesh()
+
+	ci::gl::VboMeshRef		mVboMesh;
+	ci::gl::BatchRef		mBatch;
+	size_t					mNumAllocatedVertices;
+	size_t					mNumDrawCalls;
+};
+
+}
+}
@@ -20,6 +20,7 @@ mTextureFormat(textureFormat) {
 }
 
 TextView::~TextView() {
+	cancelUpload();
 }
 
 ci::gl::Texture::Format TextView::getDefaultTextureFormat() {
@@ -62,7 +63,7 @@ void TextView::reset() {
 
 void TextView::willDraw() {
 	if (mAutoRenderEnabled) {
-		renderContent(false, true, getBlendMode() == BlendMode::PREMULT, false);
+		renderContent(false, true, getBlendMode() == BlendMode::PREMULT, false, true);
 	}
 }
 
@@ -133,11 +134,17 @@ bool TextView::needsToBeRendered(bool surfaceOnly) const {
 	return false;
 }
 
-void TextView::renderContent(bool surfaceOnly, bool alpha, bool premultiplied, bool force) {
+void TextView::renderContent(bool surfaceOnly, bool alpha, bool premultiplied, bool force, bool deferUpload) {
 	if (!needsToBeRendered(surfaceOnly) && !force) {
 		return;
 	}
 
+	if (deferUpload && mUploadTask && !mUploadTask->isComplete() && !mHasInvalidRenderedContent && !hasChanges() && !force) {
+		return; // texture for the current surface is already queued
+	}
+
+	cancelUpload();
+
 	if (mHasInvalidRenderedContent || hasChanges() || (mSurface.getSize() != getTextSize()) || (mTexture && mSurface.getSize() != mTexture->getSize())) {
 		mSurface = renderToSurface(alpha, premultiplied, getBackgroundColor().value());
 	}
@@ -145,6 +152,18 @@ void TextView::renderContent(bool surfaceOnly, bool alpha, bool premultiplied, b
 	if (surfaceOnly) {
 		mTexture = nullptr; // reset texture to save memory
 
+	} else if (deferUpload) {
+		if (mTexture && mTexture->getSize() != mSurface.getSize()) {
+			mTexture = nullptr; // don't stretch outdated content while the new texture is queued
+		}
+
+		const ci::Surface surface = mSurface;
+
+		mUploadTask = core::UploadScheduler::get()->schedule([this, surface] {
+			mTexture = gl::Texture2d::create(surface, mTextureFormat);
+			mSurface = ci::Surface(); // reset surface to save memory
+		}, surface.getRowBytes() * surface.getHeight());
+
 	} else {
 		mTexture = gl::Texture2d::create(mSurface, mTextureFormat);
 		mSurface = ci::Surface(); // reset surface to save memory
@@ -161,10 +180,18 @@ void TextView::invalidate(const bool layout, const bool size) {
 }
 
 void TextView::resetRenderedContent() {
+	cancelUpload();
 	mTexture = nullptr;
 	mSurface = ci::Surface();
 }
 
+void TextView::cancelUpload() {
+	if (mUploadTask) {
+		mUploadTask->cancel();
+		mUploadTask = nullptr;
+	}
+}
+
 void TextView::setSize(const ci::vec2 & size) {
 	invalidate();
 	setMaxSize(size);
@@ -19,6 +19,7 @@
 #include "bluecadet/text/StyleManager.h"
 
 #include "BaseView.h"
+#include "../core/UploadScheduler.h"
 
 namespace bluecadet {
 namespace views {
@@ -39,7 +40,8 @@ public:
 
 	void	reset() override;
 
-	//! Use these methods for more granular rendering control. Textures will otherwise automatically be rendered if necessary when draw() is called.
+	//! Use these methods for more granular rendering control. Textures will otherwise automatically be rendered if necessary when draw() is called
+	//! and uploaded via the UploadScheduler.
 	bool	getAutoRenderEnabled() const { return mAutoRenderEnabled; }
 	void	setAutoRenderEnabled(const bool value) { mAutoRenderEnabled = value; }
 
@@ -57,7 +59,8 @@ public:
 
 
 	//! Renders content. If surfaceOnly is false this will render into a texture and has to be called on the main thread. Surfaces can be rendered on a worker thread.
-	void	renderContent(bool surfaceOnly = false, bool alpha = true, bool premultiplied = false, bool force = false);
+	//! If deferUpload is true, the texture is created by the UploadScheduler during one of the next frames. The previous texture is drawn until then if it has the same size.
+	void	renderContent(bool surfaceOnly = false, bool alpha = true, bool premultiplied = false, bool force = false, bool deferUpload = false);
 	void	resetRenderedContent();
 	void	setBlendMode(const BlendMode blendMode) override;
 
@@ -83,6 +86,8 @@ protected:
 
 	inline void		invalidate(const bool layout = true, const bool size = true) override;
 
+	void			cancelUpload();
+
 	// Change visibility of these methods from public to protected since setSize()/getSize() should be used.
 	const ci::vec2 &	getMaxSize() const override { return StyledTextLayout::getMaxSize(); };
 	void				setMaxSize(const ci::vec2& size) override { return StyledTextLayout::setMaxSize(size); };
@@ -99,6 +104,7 @@ protected:
 	ci::Surface				mSurface;
 	ci::gl::TextureRef		mTexture = nullptr;
 	ci::gl::Texture::Format	mTextureFormat;
+	core::UploadScheduler::TaskRef	mUploadTask = nullptr;
 
 };
 
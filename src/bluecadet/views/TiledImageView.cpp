@@ -0,0 +1,362 @@
+#include "TiledImageView.h"
+
+#include "cinder/Log.h"
+#include "cinder/Xml.h"
+
+#include "../core/AssetPack.h"
+#include "../core/ScreenCamera.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace bluecadet {
+namespace views {
+
+//==================================================
+// Pyramid
+//
+
+ci::ivec2 TiledImageView::Pyramid::getLevelSize(const int level) const {
+	// each level halves the size of the next finer one, rounding up
+	const double scale = std::ldexp(1.0, level - maxLevel);
+	return ivec2((int)std::ceil(size.x * scale), (int)std::ceil(size.y * scale));
+}
+
+ci::ivec2 TiledImageView::Pyramid::getNumTiles(const int level) const {
+	const ivec2 levelSize = getLevelSize(level);
+	return (levelSize + ivec2(tileSize - 1)) / tileSize;
+}
+
+ci::fs::path TiledImageView::Pyramid::getTilePath(const int level, const int column, const int row) const {
+	return tilesPath / to_string(level) / (to_string(column) + "_" + to_string(row) + "." + format);
+}
+
+ci::Area TiledImageView::Pyramid::getTileBounds(const int level, const int column, const int row) const {
+	const ivec2 levelSize = getLevelSize(level);
+	const int x1 = column * tileSize - (column > 0 ? overlap : 0);
+	const int y1 = row * tileSize - (row > 0 ? overlap : 0);
+	const int x2 = std::min((column + 1) * tileSize + overlap, levelSize.x);
+	const int y2 = std::min((row + 1) * tileSize + overlap, levelSize.y);
+	return Area(x1, y1, x2, y2);
+}
+
+//==================================================
+// Lifecycle
+//
+
+TiledImageView::TiledImageView() : BaseView(),
+	mBaseLevel(0),
+	mCurrentLevel(0),
+	mFrameId(0),
+	mMaxNumCachedTiles(256),
+	mFocus(0),
+	mHasFocus(false),
+	mLevelBias(0),
+	mLoadPriority(0)
+{
+}
+
+TiledImageView::~TiledImageView() {
+	clearTiles();
+}
+
+void TiledImageView::reset() {
+	BaseView::reset();
+	clearTiles();
+	mPyramid = Pyramid();
+	mHasFocus = false;
+}
+
+bool TiledImageView::load(const ci::fs::path & path, const bool resizeToImage) {
+	clearTiles();
+	mPyramid = Pyramid();
+
+	// pyramids in asset packs keep relative paths so that tiles are loaded from the pack as well
+	const fs::path resolvedPath = path.is_absolute() || core::AssetPack::hasAsset(path) ? path : getAssetPath(path);
+	Pyramid pyramid;
+
+	try {
+		const XmlTree doc(core::AssetPack::loadAsset(resolvedPath));
+		const XmlTree & image = doc.getChild("Image");
+		const XmlTree & size = image.getChild("Size");
+
+		pyramid.tileSize = image.getAttributeValue<int>("TileSize");
+		pyramid.overlap = image.getAttributeValue<int>("Overlap", 0);
+		pyramid.format = image.getAttributeValue<string>("Format");
+		pyramid.size.x = size.getAttributeValue<int>("Width");
+		pyramid.size.y = size.getAttributeValue<int>("Height");
+
+	} catch (const std::exception & e) {
+		CI_LOG_EXCEPTION("Could not read tile pyramid '" << path << "'", e);
+		return false;
+	}
+
+	if (pyramid.size.x <= 0 || pyramid.size.y <= 0 || pyramid.tileSize <= 0) {
+		CI_LOG_E("Invalid tile pyramid '" << path << "'");
+		return false;
+	}
+
+	pyramid.tilesPath = resolvedPath.parent_path() / (resolvedPath.stem().string() + "_files");
+	pyramid.maxLevel = (int)std::ceil(std::log2((double)std::max(pyramid.size.x, pyramid.size.y)));
+
+	mPyramid = pyramid;
+	mBaseLevel = 0;
+
+	for (int level = mPyramid.maxLevel; level >= 0; --level) {
+		const ivec2 numTiles = mPyramid.getNumTiles(level);
+
+		if (numTiles.x == 1 && numTiles.y == 1) {
+			mBaseLevel = level;
+			break;
+		}
+	}
+
+	if (resizeToImage) {
+		setSize(vec2(mPyramid.size));
+	}
+
+	return true;
+}
+
+void TiledImageView::willMoveFromView(BaseView * parent) {
+	BaseView::willMoveFromView(parent);
+
+	// keep resident tiles so that the view doesn't start from scratch when it's added again
+	for (auto it = mTiles.begin(); it != mTiles.end();) {
+		if (it->second->request) {
+			it->second->request->cancel();
+			it = mTiles.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+//==================================================
+// Tiles
+//
+
+uint64_t TiledImageView::getTileKey(const int level, const int column, const int row) {
+	return ((uint64_t)level << 56) | ((uint64_t)column << 28) | (uint64_t)row;
+}
+
+TiledImageView::TileRef TiledImageView::findTile(const int level, const int column, const int row) const {
+	auto it = mTiles.find(getTileKey(level, column, row));
+	return it != mTiles.end() ? it->second : nullptr;
+}
+
+TiledImageView::TileRef TiledImageView::requestTile(const int level, const int column, const int row, const float priority) {
+	TileRef & tile = mTiles[getTileKey(level, column, row)];
+
+	if (!tile) {
+		tile = make_shared<Tile>();
+		tile->level = level;
+		tile->column = column;
+		tile->row = row;
+	}
+
+	tile->lastUsedFrame = mFrameId;
+
+	if (tile->texture || tile->hasFailed) {
+		return tile;
+	}
+
+	if (tile->request) {
+		tile->request->setPriority(priority);
+		return tile;
+	}
+
+	// tiles can be evicted before their request completes
+	weak_ptr<Tile> weakTile = tile;
+
+	tile->request = core::ImageLoader::get()->load(mPyramid.getTilePath(level, column, row), [weakTile](gl::Texture2dRef texture) {
+		if (auto tile = weakTile.lock()) {
+			tile->request = nullptr;
+			tile->texture = texture;
+			tile->hasFailed = !texture;
+		}
+	}, priority);
+
+	return tile;
+}
+
+void TiledImageView::trimTiles() {
+	vector<TileRef> cachedTiles;
+
+	for (auto it = mTiles.begin(); it != mTiles.end();) {
+		const TileRef & tile = it->second;
+
+		if (tile->lastUsedFrame == mFrameId || tile->level == mBaseLevel) {
+			++it;
+			continue;
+		}
+
+		if (tile->request) {
+			// scrolled or zoomed out of view before it finished loading
+			tile->request->cancel();
+			it = mTiles.erase(it);
+			continue;
+		}
+
+		if (tile->hasFailed) {
+			// retried when it's visible again
+			it = mTiles.erase(it);
+			continue;
+		}
+
+		cachedTiles.push_back(tile);
+		++it;
+	}
+
+	if (cachedTiles.size() <= mMaxNumCachedTiles) {
+		return;
+	}
+
+	const size_t numEvicted = cachedTiles.size() - mMaxNumCachedTiles;
+
+	nth_element(cachedTiles.begin(), cachedTiles.begin() + numEvicted, cachedTiles.end(), [](const TileRef & a, const TileRef & b) {
+		return a->lastUsedFrame < b->lastUsedFrame;
+	});
+
+	for (size_t i = 0; i < numEvicted; ++i) {
+		const Tile & tile = *cachedTiles[i];
+		mTiles.erase(getTileKey(tile.level, tile.column, tile.row));
+	}
+}
+
+void TiledImageView::clearTiles() {
+	for (auto & it : mTiles) {
+		if (it.second->request) {
+			it.second->request->cancel();
+		}
+	}
+
+	mTiles.clear();
+}
+
+size_t TiledImageView::getNumResidentTiles() const {
+	return count_if(mTiles.begin(), mTiles.end(), [](const pair<const uint64_t, TileRef> & it) {
+		return it.second->texture != nullptr;
+	});
+}
+
+size_t TiledImageView::getNumLoadingTiles() const {
+	return count_if(mTiles.begin(), mTiles.end(), [](const pair<const uint64_t, TileRef> & it) {
+		return it.second->request != nullptr;
+	});
+}
+
+//==================================================
+// Drawing
+//
+
+int TiledImageView::getLevelForScale(const float scale) const {
+	// the finest level needed to show at least one level pixel per screen pixel
+	const float level = (float)mPyramid.maxLevel + std::log2(std::max(scale, 1e-6f)) + mLevelBias;
+	return std::min(std::max((int)std::ceil(level), mBaseLevel), mPyramid.maxLevel);
+}
+
+void TiledImageView::draw() {
+	BaseView::draw();
+
+	if (!hasPyramid() || getWidth() <= 0 || getHeight() <= 0) {
+		return;
+	}
+
+	mFrameId++;
+
+	const vec2 viewSize = getSize();
+	const mat4 & globalTransform = getGlobalTransform();
+
+	// screen pixels per full resolution image pixel, including the camera zoom applied to the root view
+	const float globalScale = glm::length(vec3(globalTransform[0])) * core::ScreenCamera::get()->getScale().x;
+	const int level = getLevelForScale(globalScale * viewSize.x / (float)mPyramid.size.x);
+	mCurrentLevel = level;
+
+	// visible area in local coordinates
+	Rectf visibleRect(vec2(0), viewSize);
+	const Area & viewport = core::ScreenCamera::get()->getViewport();
+
+	if (viewport.getWidth() > 0 && viewport.getHeight() > 0) {
+		const mat4 inverseTransform = glm::inverse(globalTransform);
+		Rectf localViewport(vec2(inverseTransform * vec4(viewport.x1, viewport.y1, 0, 1)), vec2(inverseTransform * vec4(viewport.x2, viewport.y2, 0, 1)));
+		localViewport.include(vec2(inverseTransform * vec4(viewport.x2, viewport.y1, 0, 1)));
+		localViewport.include(vec2(inverseTransform * vec4(viewport.x1, viewport.y2, 0, 1)));
+		visibleRect = visibleRect.getClipBy(localViewport);
+	}
+
+	// always keep the coarsest tile around as a fallback
+	requestTile(mBaseLevel, 0, 0, mLoadPriority + 3.0f);
+
+	if (visibleRect.getWidth() <= 0 || visibleRect.getHeight() <= 0) {
+		trimTiles();
+		return;
+	}
+
+	const ivec2 levelSize = mPyramid.getLevelSize(level);
+	const ivec2 numTiles = mPyramid.getNumTiles(level);
+	const vec2 levelScale = vec2(levelSize) / viewSize;
+	const float tileSize = (float)mPyramid.tileSize;
+
+	const Rectf levelVisibleRect(visibleRect.getUL() * levelScale, visibleRect.getLR() * levelScale);
+	const ivec2 minTile = glm::max(ivec2(glm::floor(levelVisibleRect.getUL() / tileSize)), ivec2(0));
+	const ivec2 maxTile = glm::min(ivec2(glm::ceil(levelVisibleRect.getLR() / tileSize)), numTiles) - ivec2(1);
+
+	const vec2 focus = (mHasFocus ? mFocus : visibleRect.getCenter()) * levelScale;
+	const float maxDistance = std::max(glm::length(levelVisibleRect.getSize()), 1.0f);
+
+	gl::ScopedGlslProg scopedGlsl(gl::getStockShader(gl::ShaderDef().texture().color()));
+
+	for (int row = minTile.y; row <= maxTile.y; ++row) {
+		for (int column = minTile.x; column <= maxTile.x; ++column) {
+			const Rectf tileRect(column * tileSize, row * tileSize,
+								 std::min((column + 1) * tileSize, (float)levelSize.x), std::min((row + 1) * tileSize, (float)levelSize.y));
+
+			const float distance = std::min(glm::length(tileRect.getCenter() - focus) / maxDistance, 1.0f);
+			const TileRef tile = requestTile(level, column, row, mLoadPriority + 2.0f - distance);
+
+			if (tile->texture) {
+				drawTile(*tile, tileRect);
+				continue;
+			}
+
+			// fill in with the part of the closest coarser tile that's resident
+			for (int coarseLevel = level - 1; coarseLevel >= 0; --coarseLevel) {
+				const int shift = level - coarseLevel;
+				const TileRef coarseTile = findTile(coarseLevel, column >> shift, row >> shift);
+
+				if (coarseTile && coarseTile->texture) {
+					const float scale = std::ldexp(1.0f, -shift);
+					coarseTile->lastUsedFrame = mFrameId;
+					drawTile(*coarseTile, Rectf(tileRect.getUL() * scale, tileRect.getLR() * scale));
+					break;
+				}
+			}
+		}
+	}
+
+	trimTiles();
+}
+
+void TiledImageView::drawTile(const Tile & tile, const ci::Rectf & levelRect) {
+	const Area bounds = mPyramid.getTileBounds(tile.level, tile.column, tile.row);
+	const vec2 boundsOffset(bounds.getUL());
+	const vec2 boundsSize(bounds.getSize());
+
+	// tiles are uploaded top down, so texture coordinates match level pixels
+	const vec2 upperLeftTexCoord = (levelRect.getUL() - boundsOffset) / boundsSize;
+	const vec2 lowerRightTexCoord = (levelRect.getLR() - boundsOffset) / boundsSize;
+
+	const vec2 localScale = getSize() / vec2(mPyramid.getLevelSize(tile.level));
+	const Rectf destRect(levelRect.getUL() * localScale, levelRect.getLR() * localScale);
+
+	gl::ScopedTextureBind scopedTexture(tile.texture);
+	gl::drawSolidRect(destRect, upperLeftTexCoord, lowerRightTexCoord);
+}
+
+}
+}
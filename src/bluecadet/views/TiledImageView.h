@@ -0,0 +1,128 @@
+#pragma once
+
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Texture.h"
+
+#include <unordered_map>
+
+#include "BaseView.h"
+#include "../core/ImageLoader.h"
+
+namespace bluecadet {
+namespace views {
+
+typedef std::shared_ptr<class TiledImageView> TiledImageViewRef;
+
+//! Displays very large images from a Deep Zoom (DZI) tile pyramid. Each frame, the view picks the pyramid level that
+//! matches its on-screen scale (including the ScreenCamera zoom), determines which tiles intersect the ScreenCamera
+//! viewport and loads missing ones asynchronously via the ImageLoader. Tiles that are still loading are replaced by
+//! the closest coarser tile that's resident. The single tile of the coarsest level that covers the whole image is
+//! always kept as a last resort.
+//!
+//! Requests are prioritized by their distance from the focus point, which defaults to the center of the visible area.
+//! Call setFocus() from touch handlers (e.g. of a parent that pans and zooms this view) to load tiles under the user's
+//! fingers first. Tiles that aren't visible anymore are canceled and resident ones are kept in a bounded LRU cache.
+//!
+//! Pyramids are loaded from a .dzi descriptor and its `<name>_files/<level>/<column>_<row>.<format>` directory.
+class TiledImageView : public BaseView {
+
+public:
+	struct Pyramid {
+		ci::ivec2		size		= ci::ivec2(0);	//! Size of the full resolution image
+		int				tileSize	= 256;			//! Width and height of tiles without overlap
+		int				overlap		= 0;			//! Pixels that tiles share with their neighbors on each side
+		std::string		format		= "jpg";		//! File extension of tiles
+		ci::fs::path	tilesPath;					//! Directory that contains one directory per level
+		int				maxLevel	= 0;			//! Full resolution level. Level 0 is 1x1 pixels.
+
+		ci::ivec2		getLevelSize(const int level) const;
+		ci::ivec2		getNumTiles(const int level) const;
+		ci::fs::path	getTilePath(const int level, const int column, const int row) const;
+
+		//! Area of the tile image in level pixels, including overlap.
+		ci::Area		getTileBounds(const int level, const int column, const int row) const;
+	};
+
+	TiledImageView();
+	virtual ~TiledImageView();
+
+	void reset() override;
+
+	//! Reads the DZI descriptor at path and clears all tiles. Relative paths are resolved as asset paths.
+	//! Returns false if the descriptor couldn't be read.
+	bool					load(const ci::fs::path & path, const bool resizeToImage = true);
+	const Pyramid &			getPyramid() const			{ return mPyramid; }
+	bool					hasPyramid() const			{ return mPyramid.size.x > 0 && mPyramid.size.y > 0; }
+
+	//! Point in local coordinates around which tiles are loaded first.
+	void					setFocus(const ci::vec2 & localPosition)	{ mFocus = localPosition; mHasFocus = true; }
+	void					clearFocus()								{ mHasFocus = false; }
+	bool					hasFocus() const							{ return mHasFocus; }
+	const ci::vec2 &		getFocus() const							{ return mFocus; }
+
+	//! Maximum number of resident tiles, excluding tiles that are currently visible. Defaults to 256.
+	void					setMaxNumCachedTiles(const size_t value)	{ mMaxNumCachedTiles = value; }
+	size_t					getMaxNumCachedTiles() const				{ return mMaxNumCachedTiles; }
+
+	//! Positive values pick finer levels than needed for the current scale, negative values coarser ones. Defaults to 0.
+	void					setLevelBias(const float value)				{ mLevelBias = value; }
+	float					getLevelBias() const						{ return mLevelBias; }
+
+	//! Base priority of tile requests. Visible tiles get a boost between 1 (farthest from the focus) and 2 (at the focus).
+	void					setLoadPriority(const float value)			{ mLoadPriority = value; }
+	float					getLoadPriority() const						{ return mLoadPriority; }
+
+	//! Level that was drawn last.
+	int						getCurrentLevel() const						{ return mCurrentLevel; }
+	size_t					getNumResidentTiles() const;
+	size_t					getNumLoadingTiles() const;
+
+protected:
+	struct Tile {
+		int						level = 0;
+		int						column = 0;
+		int						row = 0;
+		ci::gl::Texture2dRef	texture;
+		core::ImageLoader::RequestRef request;
+		uint64_t				lastUsedFrame = 0;
+		bool					hasFailed = false;
+	};
+
+	typedef std::shared_ptr<Tile> TileRef;
+
+	void					draw() override;
+	void					willMoveFromView(BaseView * parent) override;
+
+	//! Level to draw for a scale of screen pixels per full resolution image pixel.
+	int						getLevelForScale(const float scale) const;
+
+	//! Returns the tile and requests it if it's neither resident nor loading.
+	TileRef					requestTile(const int level, const int column, const int row, const float priority);
+	TileRef					findTile(const int level, const int column, const int row) const;
+
+	//! Draws the part of tile that covers levelRect, which is in pixels of the tile's level.
+	void					drawTile(const Tile & tile, const ci::Rectf & levelRect);
+
+	//! Cancels invisible tiles and evicts the least recently used resident ones beyond the cache size.
+	void					trimTiles();
+	void					clearTiles();
+
+	static uint64_t			getTileKey(const int level, const int column, const int row);
+
+	Pyramid					mPyramid;
+	int						mBaseLevel;		//! Finest level that fits into a single tile; never evicted
+	int						mCurrentLevel;
+
+	std::unordered_map<uint64_t, TileRef>	mTiles;
+	uint64_t				mFrameId;
+	size_t					mMaxNumCachedTiles;
+
+	ci::vec2				mFocus;
+	bool					mHasFocus;
+	float					mLevelBias;
+	float					mLoadPriority;
+};
+
+}
+}
@@ -2,6 +2,7 @@
 
 #include "TouchView.h"
 #include "../touch/TouchManager.h"
+#include "../touch/TouchSlotTable.h"
 
 using namespace std;
 using namespace ci;
@@ -32,6 +33,7 @@ TouchView::TouchView() :
 	mHasReachedDragThreshold(false),
 	mDragEnabledX(false),
 	mDragEnabledY(false),
+	mDragPredictionEnabled(false),
 	mMinAlphaForTouches(sDefaultMinAlphaForTouches),
 	mDragThreshold(20.0f),
 	mMaxTapDuration(2.0),
@@ -40,7 +42,8 @@ TouchView::TouchView() :
 	mInitialLocalTouchPos(0, 0),
 	mInitialGlobalTouchPos(0, 0),
 	mInitialGlobalPosWhenTouched(0, 0),
-	mInitialTouchTime(0) {
+	mInitialTouchTime(0),
+	mPrimaryTouchId(-1) {
 }
 
 TouchView::~TouchView() {
@@ -90,11 +93,19 @@ void TouchView::draw() {
 //
 
 void TouchView::processTouchBegan(const touch::TouchEvent& touchEvent) {
-	mTouchIds.push_back(touchEvent.touchId);
+	if (!mTouchSlots) {
+		mTouchSlots.reset(new touch::TouchSlotTable(4));
+	}
+
+	if (auto slot = mTouchSlots->get(mTouchSlots->insert(touchEvent.touchId))) {
+		// orders touches in case the primary one ends first
+		slot->touch.timestamp = touchEvent.timestamp;
+	}
 
-	const bool isFirstTouch = mTouchIds.size() == 1;
+	const bool isFirstTouch = mTouchSlots->size() == 1;
 
 	if (isFirstTouch) {
+		mPrimaryTouchId = touchEvent.touchId;
 		mPrevLocalTouchPos = touchEvent.localPosition;
 		mPrevGlobalTouchPos = touchEvent.globalPosition;
 		mLocalTouchPos = touchEvent.localPosition;
@@ -103,7 +114,7 @@ void TouchView::processTouchBegan(const touch::TouchEvent& touchEvent) {
 		mInitialGlobalTouchPos = touchEvent.globalPosition;
 		mInitialLocalPosWhenTouched = getPosition();
 		mInitialGlobalPosWhenTouched = getGlobalPosition();
-		mInitialTouchTime = getElapsedSeconds();
+		mInitialTouchTime = getCurrentTime();
 	}
 
 	mHasReachedDragThreshold = isFirstTouch ? false : mHasReachedDragThreshold;
@@ -114,7 +125,7 @@ void TouchView::processTouchBegan(const touch::TouchEvent& touchEvent) {
 }
 
 void TouchView::processTouchMoved(const touch::TouchEvent& touchEvent) {
-	if (mTouchIds.empty()) {
+	if (mPrimaryTouchId < 0) {
 		return;
 	}
 
@@ -124,7 +135,7 @@ void TouchView::processTouchMoved(const touch::TouchEvent& touchEvent) {
 		return;
 	}
 
-	if (touchEvent.touchId == mTouchIds.front()) {
+	if (touchEvent.touchId == mPrimaryTouchId) {
 		mPrevLocalTouchPos = mLocalTouchPos;
 		mPrevGlobalTouchPos = mGlobalTouchPos;
 		mLocalTouchPos = touchEvent.localPosition;
@@ -137,13 +148,8 @@ void TouchView::processTouchMoved(const touch::TouchEvent& touchEvent) {
 	}
 
 	if (mHasReachedDragThreshold && (mDragEnabledX || mDragEnabledY)) {
-		auto globalPos = touchEvent.globalPosition - mInitialGlobalTouchPos + mInitialGlobalPosWhenTouched;
-		auto localPos = getParent() ? getParent()->convertGlobalToLocal(globalPos) : globalPos;
-
-		if (!mDragEnabledX) localPos.x = getPosition().value().x;
-		if (!mDragEnabledY) localPos.y = getPosition().value().y;
-
-		setPosition(localPos);
+		const bool usePrediction = mDragPredictionEnabled && touchEvent.hasPrediction;
+		dragTo(usePrediction ? touchEvent.predictedGlobalPosition : touchEvent.globalPosition);
 	}
 
 	handleTouchMoved(touchEvent);
@@ -151,6 +157,12 @@ void TouchView::processTouchMoved(const touch::TouchEvent& touchEvent) {
 }
 
 void TouchView::processTouchEnded(const touch::TouchEvent& touchEvent) {
+	if (mDragPredictionEnabled && mHasReachedDragThreshold && (mDragEnabledX || mDragEnabledY) && !touchEvent.isCanceled
+		&& touchEvent.touchId == mPrimaryTouchId) {
+		// settle on the actual touch position in case the last prediction overshot
+		dragTo(touchEvent.globalPosition);
+	}
+
 	handleTouchEnded(touchEvent);
 	mSignalTouchEnded.emit(touchEvent);
 
@@ -158,7 +170,7 @@ void TouchView::processTouchEnded(const touch::TouchEvent& touchEvent) {
 
 	// Only allow taps within a certain time
 	if (didTap) {
-		double touchDuration = getElapsedSeconds() - mInitialTouchTime;
+		double touchDuration = getCurrentTime() - mInitialTouchTime;
 		didTap = touchDuration <= mMaxTapDuration;
 	}
 
@@ -173,13 +185,21 @@ void TouchView::processTouchEnded(const touch::TouchEvent& touchEvent) {
 		handleTouchTapped(touchEvent);
 	}
 
-	// Remove id from list
-	auto idIt = std::find(mTouchIds.cbegin(), mTouchIds.cend(), touchEvent.touchId);
-	if (idIt != mTouchIds.end()) {
-		mTouchIds.erase(idIt);
+	// Remove touch only now so that isHandlingTouch() is still true within handlers
+	if (mTouchSlots && mTouchSlots->erase(touchEvent.touchId) && touchEvent.touchId == mPrimaryTouchId) {
+		// promote the oldest remaining touch
+		mPrimaryTouchId = -1;
+		double oldestTimestamp = 0;
+
+		for (const auto & slot : mTouchSlots->getSlots()) {
+			if (slot.isActive && (mPrimaryTouchId < 0 || slot.touch.timestamp < oldestTimestamp)) {
+				mPrimaryTouchId = slot.touch.id;
+				oldestTimestamp = slot.touch.timestamp;
+			}
+		}
 	}
 
-	if (mTouchIds.empty()) {
+	if (getNumTouches() == 0) {
 		resetTouchState();
 	}
 }
@@ -190,6 +210,16 @@ void TouchView::cancelTouches() {
 	resetTouchState();
 }
 
+void TouchView::dragTo(const ci::vec2 & globalTouchPos) {
+	auto globalPos = globalTouchPos - mInitialGlobalTouchPos + mInitialGlobalPosWhenTouched;
+	auto localPos = getParent() ? getParent()->convertGlobalToLocal(globalPos) : globalPos;
+
+	if (!mDragEnabledX) localPos.x = getPosition().value().x;
+	if (!mDragEnabledY) localPos.y = getPosition().value().y;
+
+	setPosition(localPos);
+}
+
 void TouchView::resetTouchState() {
 	mHasReachedDragThreshold = false;
 	mHasMovingTouches = false;
@@ -204,7 +234,10 @@ void TouchView::resetTouchState() {
 	mInitialGlobalPosWhenTouched = vec2(0);
 	mInitialTouchTime = 0;
 
-	mTouchIds.clear();
+	if (mTouchSlots) {
+		mTouchSlots->clear();
+	}
+	mPrimaryTouchId = -1;
 }
 
 bool TouchView::containsPoint(const vec2 &point) {
@@ -221,12 +254,16 @@ bool TouchView::containsPoint(const vec2 &point) {
 }
 
 bool TouchView::canAcceptTouch(const bluecadet::touch::Touch & touch) const {
-	return (mMultiTouchEnabled || mTouchIds.empty()) && (getAlphaConst() > mMinAlphaForTouches);
+	return (mMultiTouchEnabled || getNumTouches() == 0) && (getAlphaConst() > mMinAlphaForTouches);
+}
+
+const int TouchView::getNumTouches() const {
+	return mTouchSlots ? (int)mTouchSlots->size() : 0;
 }
 
 bool TouchView::isHandlingTouch(const int touchId) const {
-	auto idIt = std::find(mTouchIds.cbegin(), mTouchIds.cend(), touchId);
-	return (idIt != mTouchIds.end());
+	// constant time lookup in this view's own table, independent of the manager that dispatched the touch
+	return mTouchSlots && mTouchSlots->find(touchId).isValid();
 }
 
 void TouchView::setTouchPath(const float radius, const ci::vec2& offset, const int numSegments) {
@@ -10,6 +10,9 @@
 #include "../touch/Touch.h"
 
 namespace bluecadet {
+namespace touch {
+class TouchSlotTable;
+}
 namespace views {
 
 typedef std::shared_ptr<class TouchView>		TouchViewRef;
@@ -86,9 +89,9 @@ public:
 	inline void			setMultiTouchEnabled(const bool value)	{ mMultiTouchEnabled = value; }
 
 	//! Returns the total number of touches currently within the object
-	inline const int	getNumTouches() const					{ return (int)mTouchIds.size(); }
+	const int			getNumTouches() const;
 	
-	//! Timestamp of the first active touch (based on app run time/getElapsedSeconds()). 0 if no active touches.
+	//! Timestamp of the first active touch (based on app run time/getCurrentTime()). 0 if no active touches.
 	inline double	getInitialTouchTime() const						{ return mInitialTouchTime; };
 
 	inline const ci::vec2 &	getLocalTouchPos() const				{ return mLocalTouchPos; };			//! Position of the first touch within this view with 0,0 being at this view's origin. (0, 0) if no active touches.
@@ -117,6 +120,10 @@ public:
 	inline void		setDragEnabledX(const bool drag)					{ mDragEnabledX = drag; };
 	inline void		setDragEnabledY(const bool drag)					{ mDragEnabledY = drag; };
 
+	//! Sets whether dragging should use predicted touch positions if available (see plugins::TouchPredictionPlugin). Reduces perceived lag, but can overshoot on sudden stops. Defaults to false.
+	inline bool		isDragPredictionEnabled() const					{ return mDragPredictionEnabled; }
+	inline void		setDragPredictionEnabled(const bool value)		{ mDragPredictionEnabled = value; }
+
 	//! True once a touch has moved the minimum drag threshold
 	inline bool		hasReachedDragThreshold() const				{ return mHasReachedDragThreshold; };
 
@@ -149,7 +156,7 @@ public:
 	inline void		setDebugDrawTouchPath(const bool value)		{ mDebugDrawTouchPath = value; }
 
 	//! Returns true if this view is currently handling and owning the touch with touchId. Mostly used by TouchManager and/or plugins.
-	inline bool		isHandlingTouch(const int touchId) const;
+	bool			isHandlingTouch(const int touchId) const;
 
 protected:
 
@@ -164,6 +171,9 @@ protected:
 	//! Resets all touch-state related variables to a non-touched state
 	virtual void	resetTouchState();
 
+	//! Moves this view so that it follows globalTouchPos relative to where it was first touched
+	void			dragTo(const ci::vec2 & globalTouchPos);
+
 	ci::vec2		mLocalTouchPos;
 	ci::vec2		mGlobalTouchPos;
 	ci::vec2		mPrevLocalTouchPos;
@@ -174,7 +184,9 @@ protected:
 	ci::vec2		mInitialGlobalPosWhenTouched;
 	double			mInitialTouchTime;
 
-	std::vector<int>	mTouchIds;
+	//! Touches handled by this view, keyed by touch id. Allocated when this view is touched for the first time.
+	std::unique_ptr<touch::TouchSlotTable>	mTouchSlots;
+	int					mPrimaryTouchId;	//! Oldest active touch, which drives dragging. -1 if there are no touches.
 	ci::Path2d			mTouchPath;
 
 private:
@@ -189,6 +201,7 @@ private:
 	bool			mMovingTouchesEnabled;
 	bool			mDragEnabledX;
 	bool			mDragEnabledY;
+	bool			mDragPredictionEnabled;
 
 	bool			mHasReachedDragThreshold;
 	bool			mHasMovingTouches;
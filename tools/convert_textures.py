@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Converts PNG, JPEG and other images in an asset folder to GPU-compressed DDS textures next to the originals.
+
+ImageLoader loads these instead of the originals when settings.images.preferCompressed is enabled and skips
+decoding them entirely. Opaque images are compressed to BC1 (4 bits per pixel) and images with transparency
+to BC7 (8 bits per pixel), compared to 32 bits per pixel for decoded images.
+
+Requires texconv from DirectXTex (https://github.com/microsoft/DirectXTex) on the PATH or via --texconv.
+Transparency is detected with Pillow if it's installed, otherwise all images are compressed to BC7.
+Images that would be converted to the same DDS file (e.g. foo.png and foo.jpg) are reported and skipped.
+
+Usage:
+    python convert_textures.py path/to/assets [--format auto|bc1|bc3|bc7] [--mipmaps] [--force]
+"""
+
+import argparse
+import concurrent.futures
+import os
+import shutil
+import subprocess
+import sys
+
+try:
+    from PIL import Image
+except ImportError:
+    Image = None
+
+SOURCE_EXTENSIONS = {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".tif", ".tiff"}
+
+TEXCONV_FORMATS = {
+    "bc1": "BC1_UNORM",
+    "bc3": "BC3_UNORM",
+    "bc7": "BC7_UNORM",
+}
+
+
+def has_transparency(path):
+    if Image is None:
+        return True
+
+    with Image.open(path) as image:
+        if image.mode in ("RGBA", "LA") or (image.mode == "P" and "transparency" in image.info):
+            alpha = image.convert("RGBA").getchannel("A")
+            return alpha.getextrema()[0] < 255
+
+    return False
+
+
+def is_up_to_date(source_path, target_path):
+    # same rule as ImageLoader::findCompressedTexture()
+    return os.path.exists(target_path) and os.path.getmtime(target_path) >= os.path.getmtime(source_path)
+
+
+def get_target_path(source_path):
+    return os.path.splitext(source_path)[0] + ".dds"
+
+
+def find_collisions(source_paths):
+    # ImageLoader looks up compressed textures by replacing the extension, so foo.png and foo.jpg would share foo.dds
+    sources_by_target = {}
+
+    for source_path in source_paths:
+        target_path = os.path.normcase(get_target_path(source_path))
+        sources_by_target.setdefault(target_path, []).append(source_path)
+
+    return {target: sources for target, sources in sources_by_target.items() if len(sources) > 1}
+
+
+def find_images(asset_dir):
+    for root, _, files in os.walk(asset_dir):
+        for name in files:
+            if os.path.splitext(name)[1].lower() in SOURCE_EXTENSIONS:
+                yield os.path.join(root, name)
+
+
+def convert(texconv, source_path, format_name, mipmaps):
+    if format_name == "auto":
+        format_name = "bc7" if has_transparency(source_path) else "bc1"
+
+    command = [
+        texconv, "-nologo", "-y",
+        "-f", TEXCONV_FORMATS[format_name],
+        "-m", "0" if mipmaps else "1",
+        "-o", os.path.dirname(source_path) or ".",
+        source_path,
+    ]
+
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+
+    if result.returncode != 0:
+        raise RuntimeError(result.stdout.strip())
+
+    return format_name
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Converts images to GPU-compressed DDS textures for ImageLoader.")
+    parser.add_argument("asset_dir", help="Folder that is searched recursively for images")
+    parser.add_argument("--format", choices=["auto"] + sorted(TEXCONV_FORMATS.keys()), default="auto",
+                        help="Compression format. auto uses BC1 for opaque and BC7 for transparent images (default)")
+    parser.add_argument("--mipmaps", action="store_true",
+                        help="Generate all mip levels. Only use for textures that are loaded with mipmapping enabled")
+    parser.add_argument("--force", action="store_true", help="Convert images even if their DDS file is up to date")
+    parser.add_argument("--texconv", default="texconv", help="Path to texconv (default: texconv)")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="Number of parallel conversions")
+    args = parser.parse_args()
+
+    texconv = shutil.which(args.texconv)
+
+    if not texconv:
+        sys.exit("Could not find texconv at '{}'".format(args.texconv))
+
+    if args.format == "auto" and Image is None:
+        print("Pillow isn't installed; compressing all images to BC7")
+
+    source_paths = sorted(find_images(args.asset_dir))
+    collisions = find_collisions(source_paths)
+    colliding_paths = set()
+
+    for target_path, sources in sorted(collisions.items()):
+        print("Skipping {} because they would all be converted to {}; rename all but one of them".format(
+            ", ".join(sources), target_path), file=sys.stderr)
+        colliding_paths.update(sources)
+
+    pending = []
+
+    for source_path in source_paths:
+        if source_path in colliding_paths:
+            continue
+
+        if args.force or not is_up_to_date(source_path, get_target_path(source_path)):
+            pending.append(source_path)
+
+    print("Converting {} images".format(len(pending)))
+
+    num_failed = 0
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, args.jobs)) as executor:
+        futures = {executor.submit(convert, texconv, path, args.format, args.mipmaps): path for path in pending}
+
+        for future in concurrent.futures.as_completed(futures):
+            path = futures[future]
+
+            try:
+                print("{} -> {}".format(path, future.result()))
+            except (RuntimeError, OSError) as error:
+                print("Could not convert {}: {}".format(path, error), file=sys.stderr)
+                num_failed += 1
+
+    if num_failed > 0 or collisions:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+"""
+Packs an asset folder into a single file that AssetPack memory-maps at launch.
+
+Mount the pack with settings.assets.pack (or AssetPack::mount()) and relative asset paths are resolved from it before
+the asset directories. Images and other formats that are already compressed are stored as is and read in place
+without copying. Text formats like JSON and XML are LZ4-compressed if that saves at least 10%.
+
+LZ4 compression uses the lz4 package if it's installed and a slower built-in encoder otherwise.
+
+Usage:
+    python pack_assets.py path/to/assets path/to/assets.bcpack [--align 16] [--compress .json .xml] [--exclude *.psd]
+    python pack_assets.py path/to/assets.bcpack --list
+"""
+
+import argparse
+import fnmatch
+import os
+import struct
+import sys
+import zlib
+
+try:
+    import lz4.block
+except ImportError:
+    lz4 = None
+
+# must match AssetPack.h
+MAGIC = 0x50414342
+VERSION = 1
+EMPTY_BUCKET = 0xFFFFFFFF
+HEADER_FORMAT = "<IIIIIIQQ"
+ENTRY_FORMAT = "<QQQQIIB7x"
+COMPRESSION_NONE = 0
+COMPRESSION_LZ4 = 1
+
+DEFAULT_COMPRESSED_EXTENSIONS = [".json", ".xml", ".dzi", ".txt", ".csv", ".svg", ".obj", ".glsl", ".vert", ".frag"]
+COMPRESSED_TEXTURE_EXTENSIONS = {".dds", ".ktx"}
+SOURCE_IMAGE_EXTENSIONS = {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".tif", ".tiff"}
+
+
+def normalize_path(path):
+    # same as assetpack::normalizePath(): forward slashes, ascii lower case
+    path = path.replace("\\", "/")
+    while path.startswith("./"):
+        path = path[2:]
+    return "".join(c.lower() if "A" <= c <= "Z" else c for c in path)
+
+
+def hash_path(normalized_path):
+    value = 0xcbf29ce484222325
+    for byte in normalized_path.encode("utf-8"):
+        value ^= byte
+        value = (value * 0x100000001b3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def align(offset, alignment):
+    return (offset + alignment - 1) // alignment * alignment
+
+
+def write_lz4_length(out, value):
+    while value >= 255:
+        out.append(255)
+        value -= 255
+    out.append(value)
+
+
+def compress_lz4(data):
+    if lz4 is not None:
+        return lz4.block.compress(data, store_size=False)
+
+    # greedy single-probe encoder; produces valid but not optimal LZ4 blocks
+    size = len(data)
+    out = bytearray()
+    table = {}
+    anchor = 0
+    pos = 0
+    match_limit = size - 12  # the last match has to start at least 12 bytes before the end
+    literal_limit = size - 5  # and the last 5 bytes have to be literals
+
+    while pos < match_limit:
+        key = data[pos:pos + 4]
+        candidate = table.get(key)
+        table[key] = pos
+
+        if candidate is None or pos - candidate > 0xFFFF:
+            pos += 1
+            continue
+
+        length = 4
+        while pos + length < literal_limit and data[candidate + length] == data[pos + length]:
+            length += 1
+
+        num_literals = pos - anchor
+        match_code = length - 4
+
+        out.append((min(num_literals, 15) << 4) | min(match_code, 15))
+        if num_literals >= 15:
+            write_lz4_length(out, num_literals - 15)
+        out += data[anchor:pos]
+        out += struct.pack("<H", pos - candidate)
+        if match_code >= 15:
+            write_lz4_length(out, match_code - 15)
+
+        pos += length
+        anchor = pos
+
+    num_literals = size - anchor
+    out.append(min(num_literals, 15) << 4)
+    if num_literals >= 15:
+        write_lz4_length(out, num_literals - 15)
+    out += data[anchor:]
+
+    return bytes(out)
+
+
+def is_stale_compressed_texture(path):
+    # same rule as ImageLoader::findCompressedTexture(): skip textures that are older than their source image
+    base, extension = os.path.splitext(path)
+
+    if extension.lower() not in COMPRESSED_TEXTURE_EXTENSIONS:
+        return False
+
+    for source_extension in SOURCE_IMAGE_EXTENSIONS:
+        for candidate in (base + source_extension, base + source_extension.upper()):
+            if os.path.exists(candidate) and os.path.getmtime(candidate) > os.path.getmtime(path):
+                return True
+
+    return False
+
+
+def find_assets(asset_dir, excludes, output_path):
+    for root, dirs, files in os.walk(asset_dir):
+        dirs.sort()
+
+        for name in sorted(files):
+            path = os.path.join(root, name)
+            relative_path = os.path.relpath(path, asset_dir).replace(os.sep, "/")
+
+            if os.path.abspath(path) == os.path.abspath(output_path):
+                continue
+
+            if any(fnmatch.fnmatch(relative_path, pattern) or fnmatch.fnmatch(name, pattern) for pattern in excludes):
+                continue
+
+            if is_stale_compressed_texture(path):
+                print("Skipping stale {}".format(relative_path))
+                continue
+
+            yield path, relative_path
+
+
+def pack(asset_dir, output_path, alignment, compressed_extensions, excludes):
+    entries = []
+    keys = set()
+
+    for path, relative_path in find_assets(asset_dir, excludes, output_path):
+        key = normalize_path(relative_path)
+
+        if key in keys:
+            raise ValueError("'{}' only differs in case from another asset".format(relative_path))
+
+        keys.add(key)
+
+        with open(path, "rb") as file:
+            data = file.read()
+
+        compression = COMPRESSION_NONE
+        stored = data
+
+        if os.path.splitext(key)[1] in compressed_extensions and len(data) > 0:
+            compressed = compress_lz4(data)
+
+            if len(compressed) <= len(data) * 0.9:
+                compression = COMPRESSION_LZ4
+                stored = compressed
+
+        entries.append({"key": key, "size": len(data), "stored": stored, "compression": compression})
+
+    num_buckets = 1
+    while num_buckets < max(1, len(entries)) * 2:
+        num_buckets *= 2
+
+    # index sections
+    header_size = struct.calcsize(HEADER_FORMAT)
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    entries_offset = align(header_size, 8)
+    buckets_offset = align(entries_offset + len(entries) * entry_size, 8)
+    paths_offset = buckets_offset + num_buckets * 4
+
+    offset = paths_offset
+    for entry in entries:
+        entry["path_offset"] = offset
+        offset += len(entry["key"].encode("utf-8")) + 1
+
+    for entry in entries:
+        offset = align(offset, alignment)
+        entry["offset"] = offset
+        offset += len(entry["stored"])
+
+    buckets = [EMPTY_BUCKET] * num_buckets
+    for index, entry in enumerate(entries):
+        entry["hash"] = hash_path(entry["key"])
+        bucket = entry["hash"] & (num_buckets - 1)
+        while buckets[bucket] != EMPTY_BUCKET:
+            bucket = (bucket + 1) & (num_buckets - 1)
+        buckets[bucket] = index
+
+    # write to a temporary file first so that running apps never map a partial pack
+    temp_path = output_path + ".tmp"
+
+    with open(temp_path, "wb") as file:
+        file.write(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(entries), num_buckets, alignment, 0,
+                               entries_offset, buckets_offset))
+        file.write(b"\0" * (entries_offset - file.tell()))
+
+        for entry in entries:
+            file.write(struct.pack(ENTRY_FORMAT, entry["hash"], entry["offset"], len(entry["stored"]), entry["size"],
+                                   entry["path_offset"], zlib.crc32(entry["stored"]) & 0xFFFFFFFF,
+                                   entry["compression"]))
+
+        file.write(b"\0" * (buckets_offset - file.tell()))
+        file.write(struct.pack("<{}I".format(num_buckets), *buckets))
+
+        for entry in entries:
+            file.write(entry["key"].encode("utf-8") + b"\0")
+
+        for entry in entries:
+            file.write(b"\0" * (entry["offset"] - file.tell()))
+            file.write(entry["stored"])
+
+    os.replace(temp_path, output_path)
+
+    total_size = sum(entry["size"] for entry in entries)
+    num_compressed = sum(1 for entry in entries if entry["compression"] != COMPRESSION_NONE)
+    print("Packed {} assets ({} compressed, {:.1f} MB) into {} ({:.1f} MB)".format(
+        len(entries), num_compressed, total_size / 1048576.0, output_path, os.path.getsize(output_path) / 1048576.0))
+
+
+def list_pack(pack_path):
+    with open(pack_path, "rb") as file:
+        data = file.read()
+
+    magic, version, num_entries, _, alignment, _, entries_offset, _ = struct.unpack_from(HEADER_FORMAT, data)
+
+    if magic != MAGIC or version != VERSION:
+        sys.exit("'{}' is not a version {} asset pack".format(pack_path, VERSION))
+
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    num_corrupted = 0
+
+    for index in range(num_entries):
+        _, offset, stored_size, size, path_offset, crc, compression = struct.unpack_from(
+            ENTRY_FORMAT, data, entries_offset + index * entry_size)
+        path = data[path_offset:data.index(b"\0", path_offset)].decode("utf-8")
+        is_valid = zlib.crc32(data[offset:offset + stored_size]) & 0xFFFFFFFF == crc
+        num_corrupted += 0 if is_valid else 1
+
+        print("{:>12} {:>12} {:4} {}{}".format(size, stored_size, "lz4" if compression == COMPRESSION_LZ4 else "",
+                                               path, "" if is_valid else " (corrupted)"))
+
+    if num_corrupted > 0:
+        sys.exit("{} corrupted assets".format(num_corrupted))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Packs an asset folder into a single file for AssetPack.")
+    parser.add_argument("asset_dir", help="Folder to pack, or the pack to list with --list")
+    parser.add_argument("output", nargs="?", help="Pack to write, e.g. assets.bcpack")
+    parser.add_argument("--align", type=int, default=16, help="Alignment of each asset in bytes (default: 16)")
+    parser.add_argument("--compress", nargs="*", default=DEFAULT_COMPRESSED_EXTENSIONS,
+                        help="Extensions that are LZ4-compressed (default: {})".format(
+                            " ".join(DEFAULT_COMPRESSED_EXTENSIONS)))
+    parser.add_argument("--exclude", nargs="*", default=[], help="Glob patterns of files that aren't packed")
+    parser.add_argument("--list", action="store_true", help="Lists the contents of a pack and verifies checksums")
+    args = parser.parse_args()
+
+    if args.list:
+        list_pack(args.asset_dir)
+        return
+
+    if not args.output:
+        parser.error("the output path is required when packing")
+
+    if args.align < 1 or args.align & (args.align - 1) != 0:
+        parser.error("--align has to be a power of two")
+
+    try:
+        pack(args.asset_dir, args.output, args.align, {extension.lower() for extension in args.compress}, args.exclude)
+    except (OSError, ValueError) as error:
+        sys.exit("Could not pack '{}': {}".format(args.asset_dir, error))
+
+
+if __name__ == "__main__":
+    main()